@@ -49,7 +49,7 @@
 KrylovNewton::KrylovNewton(int theTangentToUse, int maxDim)
 :EquiSolnAlgo(EquiALGORITHM_TAGS_KrylovNewton),
  tangent(theTangentToUse),
- v(0), Av(0), AvData(0), rData(0), work(0), lwork(0),
+ v(0), Av(0), rData(0),
  numEqns(0), maxDimension(maxDim)
 {
   if (maxDimension < 0)
@@ -59,7 +59,7 @@ KrylovNewton::KrylovNewton(int theTangentToUse, int maxDim)
 KrylovNewton::KrylovNewton(ConvergenceTest &theT, int theTangentToUse, int maxDim)
 :EquiSolnAlgo(EquiALGORITHM_TAGS_KrylovNewton),
  tangent(theTangentToUse),
- v(0), Av(0), AvData(0), rData(0), work(0), lwork(0),
+ v(0), Av(0), rData(0),
  numEqns(0), maxDimension(maxDim)
 {
   if (maxDimension < 0)
@@ -81,14 +81,8 @@ KrylovNewton::~KrylovNewton()
     delete [] Av;
   }
 
-  if (AvData != 0)
-    delete [] AvData;
-
   if (rData != 0)
     delete [] rData;
-
-  if (work != 0)
-    delete [] work;
 }
 
 int 
@@ -125,21 +119,10 @@ KrylovNewton::solveCurrentStep(void)
       Av[i] = new Vector(numEqns);
   }
 
-  if (AvData == 0)
-    AvData = new double [maxDimension*numEqns];
-
-  if (rData == 0)
-    // The LAPACK least squares subroutine overwrites the RHS vector
-    // with the solution vector ... these vectors are not the same
-    // size, so we need to use the max size
-    rData = new double [(numEqns > maxDimension) ? numEqns : maxDimension];
-
-  // Length of work vector should be >= 2*min(numEqns,maxDimension)
-  // See dgels subroutine documentation
-  lwork = 2 * ((numEqns < maxDimension) ? numEqns : maxDimension);
-  
-  if (work == 0)
-    work = new double [lwork];
+  if (rData == 0) {
+    rData = new double [maxDimension+1];
+    theQR.setSize(numEqns, maxDimension);
+  }
 
   // Evaluate system residual R(y_0)
   if (theIntegrator->formUnbalance() < 0) {
@@ -267,20 +250,6 @@ KrylovNewton::Print(OPS_Stream &s, int flag)
   s << "\n\tNumber of equations: " << numEqns << endln;
 }
 
-#ifdef _WIN32
-
-extern "C" int  DGELS(char *T, int *M, int *N, int *NRHS,
-		      double *A, int *LDA, double *B, int *LDB,
-		      double *WORK, int *LWORK, int *INFO);
-
-#else
-
-extern "C" int dgels_(char *T, int *M, int *N, int *NRHS,
-		      double *A, int *LDA, double *B, int *LDB,
-		      double *WORK, int *LWORK, int *INFO);
-
-#endif
-
 int
 KrylovNewton::leastSquares(int k)
 {
@@ -292,56 +261,30 @@ KrylovNewton::leastSquares(int k)
   *(Av[k]) = r;
 
   // Subspace is empty
-  if (k == 0)
+  if (k == 0) {
+    theQR.clear();
     return 0;
+  }
 
   // Compute Av_k = f(y_{k-1}) - f(y_k) = r_{k-1} - r_k
   Av[k-1]->addVector(1.0, r, -1.0);
 
-  int i,j;
-
-  // Put subspace vectors into AvData
-  Matrix A(AvData, numEqns, k);
-  for (i = 0; i < k; i++) {
-    Vector &Ai = *(Av[i]);
-    for (j = 0; j < numEqns; j++)
-      A(j,i) = Ai(j);
+  // Add Av_k to the QR factorization of the subspace vectors; the
+  // vectors before it are already in it
+  if (theQR.getNumColumns() != k-1) {
+    theQR.clear();
+    for (int i = 0; i < k-1; i++)
+      theQR.addColumn(*(Av[i]));
   }
-
-  // Put residual vector into rData (need to save r for later!)
-  Vector B(rData, numEqns);
-  B = r;
-  
-  // No transpose
-  //  char *trans = "N";
-  char trans[] = "N";
-
-  // The number of right hand side vectors
-  int nrhs = 1;
-
-  // Leading dimension of the right hand side vector
-  int ldb = (numEqns > k) ? numEqns : k;
-
-  // Subroutine error flag
-  int info = 0;
-
-  // Call the LAPACK least squares subroutine
-#ifdef _WIN32
-  DGELS(trans, &numEqns, &k, &nrhs, AvData, &numEqns, rData, &ldb, work, &lwork, &info);
-#else
-  dgels_(trans, &numEqns, &k, &nrhs, AvData, &numEqns, rData, &ldb, work, &lwork, &info);
-#endif
-
-  // Check for error returned by subroutine
-  if (info < 0) {
+  if (theQR.addColumn(*(Av[k-1])) < 0 || theQR.solve(r, rData) < 0) {
     opserr << "WARNING KrylovNewton::leastSquares() - \n";
-    opserr << "error code " << info << " returned by LAPACK dgels\n";
-    return info;
+    opserr << "failed to update the QR factorization of the subspace\n";
+    return -1;
   }
   
   // Compute the correction vector
   double cj;
-  for (j = 0; j < k; j++) {
+  for (int j = 0; j < k; j++) {
     
     // Solution to least squares is written to rData
     cj = rData[j];
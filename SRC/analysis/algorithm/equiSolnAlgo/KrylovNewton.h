@@ -38,6 +38,7 @@
 
 #include <EquiSolnAlgo.h>
 #include <Vector.h>
+#include <IncrementalQR.h>
 
 class KrylovNewton: public EquiSolnAlgo
 {
@@ -64,13 +65,10 @@ class KrylovNewton: public EquiSolnAlgo
     // Storage for subspace vectors
     Vector **Av;
 
-    // Array data sent to LAPACK subroutine
-    double *AvData;
+    // QR factorization of the subspace vectors, updated as each one
+    // is added, and the least squares coefficients
+    IncrementalQR theQR;
     double *rData;
-    double *work;
-
-    // Length of work array
-    int lwork;
 
     // Size information
     int numEqns;
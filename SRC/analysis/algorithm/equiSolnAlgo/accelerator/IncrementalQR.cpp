@@ -0,0 +1,171 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// File: ~/analysis/algorithm/equiSolnAlgo/accelerator/IncrementalQR.cpp
+//
+// Description: This file contains the implementation of IncrementalQR.
+
+#include <IncrementalQR.h>
+#include <Vector.h>
+#include <OPS_Globals.h>
+#include <math.h>
+
+// a column whose norm drops below this fraction of its norm before the
+// orthogonalization is taken as dependent on the columns before it
+static const double dependentTol = 1.0e-12;
+
+IncrementalQR::IncrementalQR()
+  :numRows(0), maxColumns(0), numColumns(0)
+{
+
+}
+
+IncrementalQR::~IncrementalQR()
+{
+
+}
+
+int
+IncrementalQR::setSize(int rows, int columns)
+{
+  if (rows < 0 || columns < 0) {
+    opserr << "IncrementalQR::setSize() - invalid size " << rows << " x " << columns << endln;
+    return -1;
+  }
+
+  if (rows != numRows || columns != maxColumns) {
+    numRows = rows;
+    maxColumns = columns;
+    Q.resize((size_t)numRows*maxColumns);
+    R.resize((size_t)maxColumns*maxColumns);
+    h.resize(maxColumns);
+  }
+
+  numColumns = 0;
+  return 0;
+}
+
+void
+IncrementalQR::clear(void)
+{
+  numColumns = 0;
+}
+
+int
+IncrementalQR::getNumColumns(void) const
+{
+  return numColumns;
+}
+
+int
+IncrementalQR::addColumn(const Vector &a)
+{
+  if (numColumns >= maxColumns || a.Size() != numRows) {
+    opserr << "IncrementalQR::addColumn() - no room for column " << numColumns+1 << endln;
+    return -1;
+  }
+
+  int k = numColumns;
+  double *q = &Q[(size_t)k*numRows];
+  double *r = &R[(size_t)k*maxColumns];
+
+  double norm0 = 0.0;
+  for (int i=0; i<numRows; i++) {
+    q[i] = a(i);
+    norm0 += q[i]*q[i];
+  }
+  norm0 = sqrt(norm0);
+
+  for (int j=0; j<=k; j++)
+    r[j] = 0.0;
+
+  // two passes of classical Gram-Schmidt: h = Q'q, q = q - Q h
+  for (int pass=0; pass<2; pass++) {
+    for (int j=0; j<k; j++) {
+      const double *qj = &Q[(size_t)j*numRows];
+      double sum = 0.0;
+      for (int i=0; i<numRows; i++)
+	sum += qj[i]*q[i];
+      h[j] = sum;
+    }
+    for (int j=0; j<k; j++) {
+      const double *qj = &Q[(size_t)j*numRows];
+      double hj = h[j];
+      for (int i=0; i<numRows; i++)
+	q[i] -= hj*qj[i];
+      r[j] += hj;
+    }
+  }
+
+  double norm = 0.0;
+  for (int i=0; i<numRows; i++)
+    norm += q[i]*q[i];
+  norm = sqrt(norm);
+
+  numColumns++;
+
+  if (norm <= dependentTol*norm0 || norm == 0.0) {
+    for (int i=0; i<numRows; i++)
+      q[i] = 0.0;
+    r[k] = 0.0;
+    return 1;
+  }
+
+  double scale = 1.0/norm;
+  for (int i=0; i<numRows; i++)
+    q[i] *= scale;
+  r[k] = norm;
+
+  return 0;
+}
+
+int
+IncrementalQR::solve(const Vector &b, double *x)
+{
+  if (b.Size() != numRows) {
+    opserr << "IncrementalQR::solve() - b of size " << b.Size();
+    opserr << " for " << numRows << " rows\n";
+    return -1;
+  }
+
+  // x = Q'b
+  for (int j=0; j<numColumns; j++) {
+    const double *qj = &Q[(size_t)j*numRows];
+    double sum = 0.0;
+    for (int i=0; i<numRows; i++)
+      sum += qj[i]*b(i);
+    x[j] = sum;
+  }
+
+  // then R x = Q'b by back substitution
+  for (int j=numColumns-1; j>=0; j--) {
+    double rjj = R[(size_t)j*maxColumns + j];
+    if (rjj == 0.0) {
+      x[j] = 0.0;
+      continue;
+    }
+    double sum = x[j];
+    for (int l=j+1; l<numColumns; l++)
+      sum -= R[(size_t)l*maxColumns + j]*x[l];
+    x[j] = sum/rjj;
+  }
+
+  return 0;
+}
@@ -0,0 +1,68 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// File: ~/analysis/algorithm/equiSolnAlgo/accelerator/IncrementalQR.h
+//
+// Description: This file contains the class definition for IncrementalQR.
+// An IncrementalQR holds the thin QR factorization A = Q R of a tall
+// matrix whose columns are added one at a time, as the Krylov
+// accelerators (KrylovNewton, KrylovAccelerator) do with their Av vectors
+// each iteration. A new column is orthogonalized against Q by classical
+// Gram-Schmidt with one reorthogonalization, so adding the k'th column
+// costs O(n k) instead of the O(n k^2) of factoring A again with dgels.
+// A column that is numerically dependent on the columns before it gets a
+// zero R diagonal and its least squares coefficient is taken as 0.
+
+#ifndef IncrementalQR_h
+#define IncrementalQR_h
+
+#include <vector>
+
+class Vector;
+
+class IncrementalQR
+{
+  public:
+    IncrementalQR();
+    ~IncrementalQR();
+
+    // numRows rows and up to maxColumns columns; removes all the columns
+    int setSize(int numRows, int maxColumns);
+    void clear(void);
+
+    int getNumColumns(void) const;
+
+    // append a column; returns 1 if it is dependent on the columns already
+    // held, 0 if not and -1 if there is no room for it
+    int addColumn(const Vector &a);
+
+    // the coefficients x minimizing ||A x - b||, getNumColumns() of them
+    int solve(const Vector &b, double *x);
+
+  private:
+    int numRows;
+    int maxColumns;
+    int numColumns;
+    std::vector<double> Q;      // column j at Q[j*numRows]
+    std::vector<double> R;      // column j at R[j*maxColumns], upper triangle
+    std::vector<double> h;
+};
+
+#endif
@@ -33,6 +33,7 @@
 
 #include "Accelerator.h"
 #include <IncrementalIntegrator.h>
+#include <IncrementalQR.h>
 
 class KrylovAccelerator : public Accelerator
 {
@@ -68,13 +69,10 @@ class KrylovAccelerator : public Accelerator
   // Storage for subspace vectors
   Vector **Av;
   
-  // Array data sent to LAPACK subroutine
-  double *AvData;
+  // QR factorization of the subspace vectors, updated as each one
+  // is added, and the least squares coefficients
+  IncrementalQR theQR;
   double *rData;
-  double *work;
-  
-  // Length of work array
-  int lwork;
 
   // Which tangent to form at restart
   int theTangent;
@@ -42,7 +42,7 @@
 KrylovAccelerator2::KrylovAccelerator2(int max, int tangent)
   :Accelerator(ACCELERATOR_TAGS_Krylov),
    dimension(0), numEqns(0), maxDimension(max),
-   v(0), Av(0), AvData(0), rData(0), work(0), lwork(0), theTangent(tangent)
+   v(0), Av(0), rData(0), theTangent(tangent)
 {
   if (maxDimension < 0)
     maxDimension = 0;
@@ -62,14 +62,8 @@ KrylovAccelerator2::~KrylovAccelerator2()
     delete [] Av;
   }
 
-  if (AvData != 0)
-    delete [] AvData;
-
   if (rData != 0)
     delete [] rData;
-
-  if (work != 0)
-    delete [] work;
 }
 
 int 
@@ -92,20 +86,10 @@ KrylovAccelerator2::newStep(LinearSOE &theSOE)
       Av = 0;
     }
     
-    if (AvData != 0) {
-      delete [] AvData;
-      AvData = 0;
-    }
-    
     if (rData != 0) {
       delete [] rData;
       rData = 0;
     }
-    
-    if (work != 0) {
-      delete [] work;
-      work = 0;
-    }
   }
 
   numEqns = newNumEqns;
@@ -124,23 +108,10 @@ KrylovAccelerator2::newStep(LinearSOE &theSOE)
       Av[i] = new Vector(numEqns);
   }
 
-  if (AvData == 0)
-    AvData = new double [maxDimension*numEqns];
-
   if (rData == 0)
-    // The LAPACK least squares subroutine overwrites the RHS vector
-    // with the solution vector ... these vectors are not the same
-    // size, so we need to use the max size
-    rData = new double [(numEqns > maxDimension) ? numEqns : maxDimension];
-
-  // Length of work vector should be >= 2*min(numEqns,maxDimension)
-  // See dgels subroutine documentation
-  lwork = 2 * ((numEqns < maxDimension) ? numEqns : maxDimension);
-  if (lwork < 1)
-    lwork = 1;
+    rData = new double [maxDimension+1];
 
-  if (work == 0)
-    work = new double [lwork];
+  theQR.setSize(numEqns, maxDimension);
 
   // Reset dimension of subspace
   dimension = 0;
@@ -148,20 +119,6 @@ KrylovAccelerator2::newStep(LinearSOE &theSOE)
   return 0;
 }
 
-#ifdef _WIN32
-
-extern "C" int DGELS(char *T, unsigned int *SZ, int *M, int *N, int *NRHS,
-			      double *A, int *LDA, double *B, int *LDB,
-			      double *WORK, int *LWORK, int *INFO);
-
-#else
-
-extern "C" int dgels_(char *T, int *M, int *N, int *NRHS,
-		      double *A, int *LDA, double *B, int *LDB,
-		      double *WORK, int *LWORK, int *INFO);
-
-#endif
-
 int
 KrylovAccelerator2::accelerate(Vector &vStar, LinearSOE &theSOE, 
 			      IncrementalIntegrator &theIntegrator)
@@ -179,68 +136,17 @@ KrylovAccelerator2::accelerate(Vector &vStar, LinearSOE &theSOE,
     // Compute Av_k = f(y_{k-1}) - f(y_k) = r_{k-1} - r_k
     Av[k-1]->addVector(1.0, R, -1.0);
     
-    int i,j;
-    
-    // Put subspace vectors into AvData
-    Matrix A(AvData, numEqns, k);
-    for (i = 0; i < k; i++) {
-      Vector &Ai = *(Av[i]);
-      for (j = 0; j < numEqns; j++)
-	A(j,i) = Ai(j);
-    }
-
-    for (i = 0; i < k; i++) {
-      for (int j = i+1; j < k; j++) {
-	double sum = 0.0;
-	double sumi = 0.0;
-	double sumj = 0.0;
-	for (int ii = 0; ii < numEqns; ii++) {
-	  sum += A(ii,i)*A(ii,j);
-	  sumi += A(ii,i)*A(ii,i);
-	  sumj += A(ii,j)*A(ii,j);
-	}
-	sumi = sqrt(sumi);
-	sumj = sqrt(sumj);
-	sum = sum/(sumi*sumj);
-	//if (fabs(sum) > 0.99)
-	  //opserr << sum << ' ' << i << ' ' << j << "   ";
-      }
+    // Add Av_k to the QR factorization of the subspace vectors; the
+    // vectors before it are already in it
+    if (theQR.getNumColumns() != k-1) {
+      theQR.clear();
+      for (int i = 0; i < k-1; i++)
+	theQR.addColumn(*(Av[i]));
     }
-
-    // Put residual vector into rData (need to save r for later!)
-    Vector B(rData, numEqns);
-    B = R;
-    
-    // No transpose
-    char trans[] = "N";
-    
-    // The number of right hand side vectors
-    int nrhs = 1;
-    
-    // Leading dimension of the right hand side vector
-    int ldb = (numEqns > k) ? numEqns : k;
-    
-    // Subroutine error flag
-    int info = 0;
-    
-    // Call the LAPACK least squares subroutine
-#ifdef _WIN32
-    unsigned int sizeC = 1;
-    DGELS(trans, &sizeC, &numEqns, &k, &nrhs, AvData, &numEqns,
-	  rData, &ldb, work, &lwork, &info);
-#else
-    //SUBROUTINE DGELS( TRANS, M, N, NRHS, A, LDA, B, LDB, WORK, LWORK,
-    //		      $                  INFO )
-
-    dgels_(trans, &numEqns, &k, &nrhs, AvData, &numEqns,
-	   rData, &ldb, work, &lwork, &info);
-#endif
-    
-    // Check for error returned by subroutine
-    if (info < 0) {
+    if (theQR.addColumn(*(Av[k-1])) < 0 || theQR.solve(R, rData) < 0) {
       opserr << "WARNING KrylovAccelerator2::accelerate() - \n";
-      opserr << "error code " << info << " returned by LAPACK dgels\n";
-      return info;
+      opserr << "failed to update the QR factorization of the subspace\n";
+      return -1;
     }
     
     Vector Q(numEqns);
@@ -248,7 +154,7 @@ KrylovAccelerator2::accelerate(Vector &vStar, LinearSOE &theSOE,
 
     // Compute the correction vector
     double cj;
-    for (j = 0; j < k; j++) {
+    for (int j = 0; j < k; j++) {
       
       // Solution to least squares is written to rData
       cj = rData[j];
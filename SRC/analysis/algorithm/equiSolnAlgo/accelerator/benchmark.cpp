@@ -0,0 +1,138 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// File: ~/analysis/algorithm/equiSolnAlgo/accelerator/benchmark.cpp
+//
+// Description: benchmark for the least squares solves of the Krylov
+// accelerators. A subspace of random Av vectors is grown one vector per
+// iteration up to the maximum dimension, as in KrylovNewton, and the least
+// squares problem is solved at each iteration both by factoring the whole
+// block with LAPACK dgels, as was done before, and by adding the new
+// vector to an IncrementalQR. Prints the time per iteration of each and
+// the largest difference in the coefficients. Built with "make
+// benchmark", run as "krylov_benchmark numEqn maxDimension numCycles".
+
+#include <IncrementalQR.h>
+#include <Vector.h>
+#include <OPS_Globals.h>
+#include <StandardStream.h>
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <vector>
+
+StandardStream sserr;
+OPS_Stream *opserrPtr = &sserr;
+
+#ifdef _WIN32
+extern "C" int DGELS(char *T, int *M, int *N, int *NRHS,
+		     double *A, int *LDA, double *B, int *LDB,
+		     double *WORK, int *LWORK, int *INFO);
+#define dgels_ DGELS
+#else
+extern "C" int dgels_(char *T, int *M, int *N, int *NRHS,
+		      double *A, int *LDA, double *B, int *LDB,
+		      double *WORK, int *LWORK, int *INFO);
+#endif
+
+int main(int argc, char **argv)
+{
+  int numEqn = 500000;
+  int maxDimension = 16;
+  int numCycles = 3;
+
+  if (argc > 1) numEqn = atoi(argv[1]);
+  if (argc > 2) maxDimension = atoi(argv[2]);
+  if (argc > 3) numCycles = atoi(argv[3]);
+
+  std::vector<Vector *> Av(maxDimension);
+  for (int j=0; j<maxDimension; j++)
+    Av[j] = new Vector(numEqn);
+  Vector r(numEqn);
+
+  std::vector<double> AvData((size_t)numEqn*maxDimension), rData(numEqn);
+  std::vector<double> work(2*maxDimension), c(maxDimension);
+
+  IncrementalQR theQR;
+  theQR.setSize(numEqn, maxDimension);
+
+  srand(1);
+  double timeLAPACK = 0.0;
+  double timeQR = 0.0;
+  double maxDiff = 0.0;
+  int numSolves = 0;
+
+  for (int cycle=0; cycle<numCycles; cycle++) {
+    theQR.clear();
+
+    for (int k=1; k<=maxDimension; k++) {
+      // the new subspace vector and residual
+      Vector &a = *Av[k-1];
+      for (int i=0; i<numEqn; i++) {
+	a(i) = (rand() % 2000)/1000.0 - 1.0;
+	r(i) = (rand() % 2000)/1000.0 - 1.0;
+      }
+
+      // the whole block, factored with dgels
+      std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+      for (int j=0; j<k; j++) {
+	const Vector &Aj = *Av[j];
+	double *col = &AvData[(size_t)j*numEqn];
+	for (int i=0; i<numEqn; i++)
+	  col[i] = Aj(i);
+      }
+      for (int i=0; i<numEqn; i++)
+	rData[i] = r(i);
+      char trans[] = "N";
+      int nrhs = 1;
+      int lwork = 2*maxDimension;
+      int info = 0;
+      dgels_(trans, &numEqn, &k, &nrhs, &AvData[0], &numEqn, &rData[0], &numEqn,
+	     &work[0], &lwork, &info);
+      std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+
+      // the new vector added to the QR factorization
+      theQR.addColumn(a);
+      theQR.solve(r, &c[0]);
+      std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+
+      timeLAPACK += std::chrono::duration<double, std::milli>(t1 - t0).count();
+      timeQR += std::chrono::duration<double, std::milli>(t2 - t1).count();
+      numSolves++;
+
+      for (int j=0; j<k; j++)
+	maxDiff = fmax(maxDiff, fabs(c[j] - rData[j]));
+    }
+  }
+
+  printf("%d equations, subspace of %d, %d cycles\n", numEqn, maxDimension,
+	 numCycles);
+  printf("%14s %14s %10s %12s\n", "dgels(ms/it)", "QR(ms/it)", "speedup",
+	 "max diff");
+  printf("%14.3f %14.3f %10.2f %12.3e\n", timeLAPACK/numSolves,
+	 timeQR/numSolves, timeLAPACK/timeQR, maxDiff);
+
+  for (int j=0; j<maxDimension; j++)
+    delete Av[j];
+
+  return 0;
+}
@@ -308,6 +308,12 @@ DOF_Group::getNodeTag(void) const
     	return -1;
 }
 
+Node *
+DOF_Group::getResponseNode(void)
+{
+    return myNode;
+}
+
 int
 DOF_Group::getNumFreeDOF(void) const
 {
@@ -97,6 +97,10 @@ class DOF_Group: public TaggedObject
     virtual void incrNodeVel(const Vector &udot);
     virtual void incrNodeAccel(const Vector &udotdot);
 
+    // the Node whose trial response the above methods set straight from
+    // the equation numbers in the ID, 0 if the DOF_Group does it otherwise
+    virtual Node *getResponseNode(void);
+
     virtual const Vector & getTrialDisp();
     virtual const Vector & getTrialVel();
     virtual const Vector & getTrialAccel();
@@ -93,6 +93,7 @@ class TransformationDOF_Group: public DOF_Group
     void incrNodeDisp(const Vector &u);
     void incrNodeVel(const Vector &udot);
     void incrNodeAccel(const Vector &udotdot);
+    Node *getResponseNode(void) {return 0;}
 
     const Vector & getTrialDisp();
     const Vector & getTrialVel();
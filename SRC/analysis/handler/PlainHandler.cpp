@@ -50,7 +50,7 @@
 #include <Subdomain.h>
 #include <Channel.h>
 #include <FEM_ObjectBroker.h>
-#include <map>
+#include <NodeConstraintIndex.h>
 
 void* OPS_PlainHandler()
 {
@@ -82,19 +82,8 @@ PlainHandler::handle(const ID *nodesLast)
 	return -1;
     }
 
-    // get all SPs
-    std::multimap<int,SP_Constraint*> allSPs;
-    SP_ConstraintIter &theSPs = theDomain->getDomainAndLoadPatternSPs();
-    SP_Constraint *theSP; 
-    while ((theSP = theSPs()) != 0) {
-	if (theSP->isHomogeneous() == false) {
-	    opserr << "WARNING PlainHandler::handle() - ";
-	    opserr << " non-homogeneos constraint";
-	    opserr << " for node " << theSP->getNodeTag();
-	    opserr << " homogeneous constraint assumed\n";
-	}
-	allSPs.insert(std::make_pair(theSP->getNodeTag(),theSP));
-    }
+    // get the SPs and MPs of each node
+    const NodeConstraintIndex &theIndex = theModel->getNodeConstraintIndex();
 
     // initialise the DOF_Groups and add them to the AnalysisModel.
     //    : must of course set the initial IDs
@@ -121,10 +110,16 @@ PlainHandler::handle(const ID *nodesLast)
 	// loop through the SP_Constraints to see if any of the
 	// DOFs are constrained, if so set initial ID value to -1
 	int nodeID = nodPtr->getTag();
-	std::multimap<int,SP_Constraint*>::iterator first = allSPs.lower_bound(nodeID);
-	std::multimap<int,SP_Constraint*>::iterator last = allSPs.upper_bound(nodeID);
-	for(std::multimap<int,SP_Constraint*>::iterator it=first; it!=last; it++) {
-	    spPtr = it->second;
+	int numSPs = theIndex.getNumSPs(nodeID);
+	SP_Constraint *const *sps = theIndex.getSPs(nodeID);
+	for (int k=0; k<numSPs; k++) {
+	    spPtr = sps[k];
+	    if (spPtr->isHomogeneous() == false) {
+		opserr << "WARNING PlainHandler::handle() - ";
+		opserr << " non-homogeneos constraint";
+		opserr << " for node " << spPtr->getNodeTag();
+		opserr << " homogeneous constraint assumed\n";
+	    }
 	    const ID &id = dofPtr->getID();
 	    int dof = spPtr->getDOF_Number();		
 	    if (id(dof) == -2) {
@@ -140,10 +135,10 @@ PlainHandler::handle(const ID *nodesLast)
     	// loop through the MP_Constraints to see if any of the
 	// DOFs are constrained, note constraint matrix must be diagonal
 	// with 1's on the diagonal
-	MP_ConstraintIter &theMPs = theDomain->getMPs();
-	MP_Constraint *mpPtr;
-	while ((mpPtr = theMPs()) != 0)
-	    if (mpPtr->getNodeConstrained() == nodeID) {
+	int numMPs = theIndex.getNumMPs(nodeID);
+	MP_Constraint *const *mps = theIndex.getMPs(nodeID);
+	for (int k=0; k<numMPs; k++) {
+		MP_Constraint *mpPtr = mps[k];
 		if (mpPtr->isTimeVarying() == true) {
 		    opserr << "WARNING PlainHandler::handle() - ";
 		    opserr << " time-varying constraint";
@@ -53,6 +53,21 @@
 #include <FEM_ObjectBroker.h>
 #include <TransformationDOF_Group.h>
 #include <TransformationFE.h>
+#include <NodeConstraintIndex.h>
+
+// returns true if a node of the Element is constrained by an
+// MP_Constraint or an SP_Constraint
+static bool
+hasConstrainedNode(Element &theEle, const NodeConstraintIndex &theIndex)
+{
+  const ID &nodes = theEle.getExternalNodes();
+  int nodesSize = nodes.Size();
+  for (int i=0; i<nodesSize; i++)
+    if (theIndex.isConstrained(nodes(i)) == true)
+      return true;
+
+  return false;
+}
 
 void* OPS_TransformationConstraintHandler()
 {
@@ -89,72 +104,15 @@ TransformationConstraintHandler::handle(const ID *nodesLast)
 	return -1;
     }
     
-    // get number ofelements and nodes in the domain 
-    // and init the theFEs and theDOFs arrays
-    int numMPConstraints = theDomain->getNumMPs();
-
-    //    int numSPConstraints = theDomain->getNumSPs();    
-    int numSPConstraints = 0;
-    SP_ConstraintIter &theSP1s = theDomain->getDomainAndLoadPatternSPs();
-    SP_Constraint *theSP1; 
-    while ((theSP1 = theSP1s()) != 0) 
-	numSPConstraints++;
+    // get the constraints of each node, the number of constrained
+    // nodes gives the size of the theDOFs array
+    const NodeConstraintIndex &theIndex = theModel->getNodeConstraintIndex();
+    int numSPConstraints = theIndex.getNumSPs();
     
-    numDOF = 0;
-    ID transformedNode(0, 64);
+    numDOF = theIndex.getNumConstrainedNodes();
 
     int i;
     
-    // create an ID of constrained node tags in MP_Constraints
-    ID constrainedNodesMP(0, numMPConstraints);
-    MP_Constraint **mps =0;
-    if (numMPConstraints != 0) {
-	mps = new MP_Constraint *[numMPConstraints];
-	if (mps == 0) {
-	    opserr << "WARNING TransformationConstraintHandler::handle() - ";
-	    opserr << "ran out of memory for MP_Constraints"; 
-	    opserr << " array of size " << numMPConstraints << endln;
-	    return -3;	    
-	}
-	MP_ConstraintIter &theMPs = theDomain->getMPs();
-	MP_Constraint *theMP; 
-	int index = 0;
-	while ((theMP = theMPs()) != 0) {
-	  int nodeConstrained = theMP->getNodeConstrained();
-	  if (transformedNode.getLocation(nodeConstrained) < 0)
-	    transformedNode[numDOF++] = nodeConstrained;
-	  constrainedNodesMP[index] = nodeConstrained;
-	  mps[index] = theMP;
-	  index++;
-	}	
-    }
-
-    // create an ID of constrained node tags in SP_Constraints
-    ID constrainedNodesSP(0, numSPConstraints);;
-    SP_Constraint **sps =0;
-    if (numSPConstraints != 0) {
-	sps = new SP_Constraint *[numSPConstraints];
-	if (sps == 0) {
-	    opserr << "WARNING TransformationConstraintHandler::handle() - ";
-	    opserr << "ran out of memory for SP_Constraints"; 
-	    opserr << " array of size " << numSPConstraints << endln;
-	    if (mps != 0) delete [] mps;
-	    if (sps != 0) delete [] sps;
-	    return -3;	    
-	}
-	SP_ConstraintIter &theSPs = theDomain->getDomainAndLoadPatternSPs();
-	SP_Constraint *theSP; 
-	int index = 0;
-	while ((theSP = theSPs()) != 0) {
-	  int constrainedNode = theSP->getNodeTag();
-	  if (transformedNode.getLocation(constrainedNode) < 0)
-	    transformedNode[numDOF++] = constrainedNode;	    
-	  constrainedNodesSP[index] = constrainedNode;
-	  sps[index] = theSP;
-	  index++;
-	}	
-    }
-
     // create an array for the DOF_Groups and zero it
     if ((numDOF != 0) && ((theDOFs = new DOF_Group *[numDOF]) == 0)) {
 	opserr << "WARNING TransformationConstraintHandler::handle() - ";
@@ -181,28 +139,25 @@ TransformationConstraintHandler::handle(const ID *nodesLast)
 
 	int nodeTag = nodPtr->getTag();
 	int numNodalDOF = nodPtr->getNumberDOF();
-	int loc = -1;
 	int createdDOF = 0;
 
-	loc = constrainedNodesMP.getLocation(nodeTag);
-	if (loc >= 0) {
+	int numMPs = theIndex.getNumMPs(nodeTag);
+	int numSPs = theIndex.getNumSPs(nodeTag);
+	SP_Constraint *const *sps = theIndex.getSPs(nodeTag);
+
+	if (numMPs != 0) {
 
 	  TransformationDOF_Group *tDofPtr = 
-	    new TransformationDOF_Group(numDofGrp++, nodPtr, mps[loc], this); 
+	    new TransformationDOF_Group(numDofGrp++, nodPtr, theIndex.getMPs(nodeTag)[0], this); 
 
 	  createdDOF = 1;
 	  dofPtr = tDofPtr;
 	  
 	  // add any SPs
 	  if (numSPConstraints != 0) {
-	    loc = constrainedNodesSP.getLocation(nodeTag);
-	    if (loc >= 0) {
-	      tDofPtr->addSP_Constraint(*(sps[loc]));
-	      for (int i = loc+1; i<numSPConstraints; i++) {
-		if (constrainedNodesSP(i) == nodeTag)
-		  tDofPtr->addSP_Constraint(*(sps[i]));
-	      }
-	    }
+	    for (int i = 0; i<numSPs; i++)
+	      tDofPtr->addSP_Constraint(*(sps[i]));
+
 	    // add the DOF to the array	    
 	    theDOFs[numDOF++] = dofPtr;	    	    
 	    numConstrainedNodes++;
@@ -210,23 +165,17 @@ TransformationConstraintHandler::handle(const ID *nodesLast)
 	}
 	
 	if (createdDOF == 0) {
-	  loc = constrainedNodesSP.getLocation(nodeTag);
-	  if (loc >= 0) {
+	  if (numSPs != 0) {
 	    TransformationDOF_Group *tDofPtr = 
 	      new TransformationDOF_Group(numDofGrp++, nodPtr, this);
 
-	    int numSPs = 1;
 	    createdDOF = 1;
 	    dofPtr = tDofPtr;
-	    tDofPtr->addSP_Constraint(*(sps[loc]));
 	
-	    // check for more SP_constraints acting on node and add them
-	    for (int i = loc+1; i<numSPConstraints; i++) {
-	      if (constrainedNodesSP(i) == nodeTag) {
-		tDofPtr->addSP_Constraint(*(sps[i]));
-		numSPs++;
-	      }
-	    }
+	    // add all the SP_constraints acting on node
+	    for (int i = 0; i<numSPs; i++)
+	      tDofPtr->addSP_Constraint(*(sps[i]));
+
 	    // add the DOF to the array
 	    theDOFs[numDOF++] = dofPtr;	    	    
 	    numConstrainedNodes++;	    
@@ -240,8 +189,6 @@ TransformationConstraintHandler::handle(const ID *nodesLast)
 		opserr << "WARNING TransformationConstraintHandler::handle() ";
 		opserr << "- ran out of memory";
 		opserr << " creating DOF_Group " << i << endln;	
-		if (mps != 0) delete [] mps;
-		if (sps != 0) delete [] sps;
 		return -4;    		
 	    }
 	
@@ -255,13 +202,13 @@ TransformationConstraintHandler::handle(const ID *nodesLast)
 	theModel->addDOF_Group(dofPtr);
     }
 
-    // create the FE_Elements for the Elements and add to the AnalysisModel
+    // create the FE_Elements for the Elements and add to the AnalysisModel,
+    // a TransformationFE for an Element with a constrained node
     ElementIter &theEle = theDomain->getElements();
     Element *elePtr;
     FE_Element *fePtr;
 
     numFE = 0;
-    ID transformedEle(0, 64);
 
     while ((elePtr = theEle()) != 0) {
       int flag = 0;
@@ -271,33 +218,8 @@ TransformationConstraintHandler::handle(const ID *nodesLast)
 	  flag = 1;
       }
 
-      if (flag == 0) {
-      
-	const ID &nodes = elePtr->getExternalNodes();
-	int nodesSize = nodes.Size();
-	int isConstrainedNode = 0;
-	for (int i=0; i<nodesSize; i++) {
-	  int nodeTag = nodes(i);
-	  if (numMPConstraints != 0) {
-	    int loc = constrainedNodesMP.getLocation(nodeTag);
-	    if (loc >= 0) {
-	      isConstrainedNode = 1;
-	      i = nodesSize;
-	    }
-	  } 
-	  if (numSPConstraints != 0 && isConstrainedNode == 0) {
-	    int loc = constrainedNodesSP.getLocation(nodeTag);
-	    if (loc >= 0) {
-	      isConstrainedNode = 1;		    
-	      i = nodesSize;
-	    }
-	  }
-	}
-	
-	if (isConstrainedNode == 1) {
-	  transformedEle[numFE++] = elePtr->getTag();
-	}
-      }
+      if (flag == 0 && hasConstrainedNode(*elePtr, theIndex) == true)
+	numFE++;
     }
     
     // create an array for the FE_elements and zero it
@@ -317,18 +239,15 @@ TransformationConstraintHandler::handle(const ID *nodesLast)
     int numFE = 0;
 
     while ((elePtr = theEle1()) != 0) {
-      int tag = elePtr->getTag();
       if (elePtr->isSubdomain() == true) {
 	Subdomain *theSub = (Subdomain *)elePtr;
 	if (theSub->doesIndependentAnalysis() == false) {
 	  
-	  if (transformedEle.getLocation(tag) < 0) {
+	  if (hasConstrainedNode(*elePtr, theIndex) == false) {
 	    if ((fePtr = new FE_Element(numFeEle, elePtr)) == 0) {
 	      opserr << "WARNING TransformationConstraintHandler::handle()";
 	      opserr << " - ran out of memory";
 	      opserr << " creating FE_Element " << elePtr->getTag() << endln; 
-	      if (mps != 0) delete [] mps;
-	      if (sps != 0) delete [] sps;
 	      return -5;
 	    }	
 	  } else {
@@ -336,8 +255,6 @@ TransformationConstraintHandler::handle(const ID *nodesLast)
 	      opserr << "WARNING TransformationConstraintHandler::handle()";
 	      opserr << " - ran out of memory";
 	      opserr << " creating TransformationFE " << elePtr->getTag() << endln; 
-	      if (mps != 0) delete [] mps;
-	      if (sps != 0) delete [] sps;
 	      return -6;		    
 	    }
 	    theFEs[numFE++] = fePtr;
@@ -348,13 +265,11 @@ TransformationConstraintHandler::handle(const ID *nodesLast)
 	  theSub->setFE_ElementPtr(fePtr);
 	}
       } else {
-	if (transformedEle.getLocation(tag) < 0) {
+	if (hasConstrainedNode(*elePtr, theIndex) == false) {
 	  if ((fePtr = new FE_Element(numFeEle, elePtr)) == 0) {
 	    opserr << "WARNING TransformationConstraintHandler::handle()";
 	    opserr << " - ran out of memory";
 	    opserr << " creating FE_Element " << elePtr->getTag() << endln; 
-	    if (mps != 0) delete [] mps;
-	    if (sps != 0) delete [] sps;
 	    return -5;
 	  }	
 	} else {
@@ -362,8 +277,6 @@ TransformationConstraintHandler::handle(const ID *nodesLast)
 	    opserr << "WARNING TransformationConstraintHandler::handle()";
 	    opserr << " - ran out of memory";
 	    opserr << " creating TransformationFE " << elePtr->getTag() << endln; 
-	    if (mps != 0) delete [] mps;
-	    if (sps != 0) delete [] sps;
 	    return -6;		    
 	  }
 	  theFEs[numFE++] = fePtr;
@@ -396,16 +309,11 @@ TransformationConstraintHandler::handle(const ID *nodesLast)
 			opserr << "WARNING TransformationConstraintHandler::handle() ";
 			opserr << " - boundary sp constraint in subdomain";
 			opserr << " this should not be - results suspect \n";
-			if (mps != 0) delete [] mps;
-			if (sps != 0) delete [] sps;
 		    }
 		}
 	    }
 	}
 
-    if (mps != 0) delete [] mps;
-    if (sps != 0) delete [] sps;
-
     return count3;
 }
 
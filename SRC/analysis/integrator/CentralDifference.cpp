@@ -36,10 +36,14 @@
 #include <Vector.h>
 #include <DOF_Group.h>
 #include <DOF_GrpIter.h>
+#include <Element.h>
+#include <Matrix.h>
 #include <AnalysisModel.h>
 #include <Channel.h>
 #include <FEM_ObjectBroker.h>
 #include <elementAPI.h>
+#include <string.h>
+#include <math.h>
 #define OPS_Export 
 
 
@@ -48,7 +52,16 @@ void *    OPS_CentralDifference(void)
     // pointer to an integrator that will be returned
     TransientIntegrator *theIntegrator = 0;
     
-    theIntegrator = new CentralDifference();
+    bool constantMass = false;
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+        const char *arg = OPS_GetString();
+        if (strcmp(arg, "-constantMass") == 0)
+            constantMass = true;
+        else
+            opserr << "WARNING CentralDifference - ignoring unknown option " << arg << endln;
+    }
+    
+    theIntegrator = new CentralDifference(constantMass);
     
     if (theIntegrator == 0)
         opserr << "WARNING - out of memory creating CentralDifference integrator\n";
@@ -62,6 +75,7 @@ CentralDifference::CentralDifference()
     deltaT(0.0),
     alphaM(0.0), betaK(0.0), betaKi(0.0), betaKc(0.0),
     updateCount(0), c2(0.0), c3(0.0),
+    constantMass(false), tangentDeltaT(0.0),
     Utm1(0), Ut(0), Utdot(0), Utdotdot(0),
     Udot(0), Udotdot(0)
 {
@@ -75,6 +89,20 @@ CentralDifference::CentralDifference(
     deltaT(0.0),
     alphaM(_alphaM), betaK(_betaK), betaKi(_betaKi), betaKc(_betaKc),
     updateCount(0), c2(0.0), c3(0.0),
+    constantMass(false), tangentDeltaT(0.0),
+    Utm1(0), Ut(0), Utdot(0), Utdotdot(0),
+    Udot(0), Udotdot(0)
+{
+    
+}
+
+
+CentralDifference::CentralDifference(bool _constantMass)
+    : TransientIntegrator(INTEGRATOR_TAGS_CentralDifference),
+    deltaT(0.0),
+    alphaM(0.0), betaK(0.0), betaKi(0.0), betaKc(0.0),
+    updateCount(0), c2(0.0), c3(0.0),
+    constantMass(_constantMass), tangentDeltaT(0.0),
     Utm1(0), Ut(0), Utdot(0), Utdotdot(0),
     Udot(0), Udotdot(0)
 {
@@ -124,10 +152,12 @@ int CentralDifference::newStep(double _deltaT)
     }
     
     // determine the garbage velocities and accelerations at t
-    Utdot->addVector(0.0, *Utm1, -c2);
-    
-    Utdotdot->addVector(0.0, *Ut, -2.0*c3);
-    Utdotdot->addVector(1.0, *Utm1, c3);
+    int size = Ut->Size();
+    for (int i=0; i<size; i++) {
+        double utm1 = (*Utm1)(i);
+        (*Utdot)(i) = -c2*utm1;
+        (*Utdotdot)(i) = c3*(utm1 - 2.0*(*Ut)(i));
+    }
     
     // set the garbage response quantities for the nodes
     theModel->setVel(*Utdot);
@@ -148,6 +178,30 @@ int CentralDifference::newStep(double _deltaT)
 }
 
 
+int CentralDifference::formTangent(int statFlag)
+{
+    if (constantMass == true && tangentDeltaT == deltaT)
+        return 0;
+    
+    // the first time, make sure the damping will not change
+    if (constantMass == true && tangentDeltaT == 0.0 &&
+        this->isDampingConstant() == false) {
+        opserr << "WARNING CentralDifference::formTangent() - -constantMass ";
+        opserr << "needs a constant damping, the element damping is not ";
+        opserr << "a multiple of the mass; forming the tangent every step\n";
+        constantMass = false;
+    }
+    
+    int result = this->TransientIntegrator::formTangent(statFlag);
+    if (result == 0)
+        tangentDeltaT = deltaT;
+    else
+        tangentDeltaT = 0.0;
+    
+    return result;
+}
+
+
 int CentralDifference::formEleTangent(FE_Element *theEle)
 {
     theEle->zeroTangent();
@@ -170,6 +224,50 @@ int CentralDifference::formNodTangent(DOF_Group *theDof)
 }
 
 
+bool CentralDifference::isDampingConstant()
+{
+    // C = alphaM*M is constant, betaK*K, betaKi*Ki and betaKc*Kc or the
+    // element's own dampers are not known to be, so each element's
+    // damping must be a multiple of its mass
+    AnalysisModel *theModel = this->getAnalysisModel();
+    FE_EleIter &theEles = theModel->getFEs();
+    FE_Element *elePtr;
+    while ((elePtr = theEles()) != 0) {
+        Element *theEle = elePtr->getElement();
+        if (theEle == 0)
+            continue;
+        
+        // copy C, the element may return M and C in the same matrix
+        Matrix C(theEle->getDamp());
+        const Matrix &M = theEle->getMass();
+        int n = C.noRows();
+        if (M.noRows() != n || M.noCols() != C.noCols())
+            return false;
+        
+        double CM = 0.0, MM = 0.0, maxC = 0.0;
+        for (int i=0; i<n; i++)
+            for (int j=0; j<C.noCols(); j++) {
+                CM += C(i,j)*M(i,j);
+                MM += M(i,j)*M(i,j);
+                if (fabs(C(i,j)) > maxC)
+                    maxC = fabs(C(i,j));
+            }
+        if (maxC == 0.0)
+            continue;
+        if (MM == 0.0)
+            return false;
+        
+        double a = CM/MM;
+        for (int i=0; i<n; i++)
+            for (int j=0; j<C.noCols(); j++)
+                if (fabs(C(i,j) - a*M(i,j)) > 1.0e-10*maxC)
+                    return false;
+    }
+    
+    return true;
+}
+
+
 int CentralDifference::domainChanged()
 {
     AnalysisModel *theModel = this->getAnalysisModel();
@@ -177,6 +275,9 @@ int CentralDifference::domainChanged()
     const Vector &x = theLinSOE->getX();
     int size = x.Size();
     
+    // the LinearSOE has been resized, the tangent must be formed again
+    tangentDeltaT = 0.0;
+    
     // if damping factors exist set them in the element & node of the domain
     if (alphaM != 0.0 || betaK != 0.0 || betaKi != 0.0 || betaKc != 0.0)
         theModel->setRayleighDampingFactors(alphaM, betaK, betaKi, betaKc);
@@ -307,14 +408,12 @@ int CentralDifference::update(const Vector &U)
     }
     
     //  determine the response at t+deltaT
-    Udot->addVector(0.0, U, 3.0);
-    Udot->addVector(1.0, *Ut, -4.0);
-    Udot->addVector(1.0, *Utm1, 1.0);
-    (*Udot) *= c2;
-    
-    Udotdot->addVector(0.0, *Udot, 1.0);
-    Udotdot->addVector(1.0, *Utdot, -1.0);
-    (*Udotdot) /= deltaT;
+    int size = U.Size();
+    for (int i=0; i<size; i++) {
+        double udot = c2*(3.0*U(i) - 4.0*(*Ut)(i) + (*Utm1)(i));
+        (*Udot)(i) = udot;
+        (*Udotdot)(i) = (udot - (*Utdot)(i))/deltaT;
+    }
     
     // update the response at the DOFs
     theModel->setResponse(U, *Udot, *Udotdot);
@@ -355,11 +454,12 @@ CentralDifference::getVel()
 
 int CentralDifference::sendSelf(int cTag, Channel &theChannel)
 {
-    Vector data(4);
+    Vector data(5);
     data(0) = alphaM;
     data(1) = betaK;
     data(2) = betaKi;
     data(3) = betaKc;
+    data(4) = (constantMass == true) ? 1.0 : 0.0;
     
     if (theChannel.sendVector(this->getDbTag(), cTag, data) < 0)  {
         opserr << "WARNING CentralDifference::sendSelf() - could not send data\n";
@@ -372,7 +472,7 @@ int CentralDifference::sendSelf(int cTag, Channel &theChannel)
 
 int CentralDifference::recvSelf(int cTag, Channel &theChannel, FEM_ObjectBroker &theBroker)
 {
-    Vector data(4);
+    Vector data(5);
     if (theChannel.recvVector(this->getDbTag(), cTag, data) < 0)  {
         opserr << "WARNING CentralDifference::recvSelf() - could not receive data\n"; 
         return -1;
@@ -382,6 +482,8 @@ int CentralDifference::recvSelf(int cTag, Channel &theChannel, FEM_ObjectBroker
     betaK  = data(1);
     betaKi = data(2);
     betaKc = data(3);
+    constantMass = (data(4) != 0.0);
+    tangentDeltaT = 0.0;
     
     return 0;
 }
@@ -395,6 +497,8 @@ void CentralDifference::Print(OPS_Stream &s, int flag)
         s << "CentralDifference - currentTime: " << currentTime << endln;
         s << "  Rayleigh Damping - alphaM: " << alphaM << "  betaK: " << betaK;
         s << "  betaKi: " << betaKi << "  betaKc: " << betaKc << endln;	    
+        if (constantMass == true)
+            s << "  tangent formed once for each time step size\n";
     } else 
         s << "CentralDifference - no associated AnalysisModel\n";
 }
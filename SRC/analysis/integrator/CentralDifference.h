@@ -45,10 +45,23 @@ public:
     // constructors
     CentralDifference();
     CentralDifference(double alphaM, double betaK, double betaKi, double betaKc);
+    CentralDifference(bool constantMass);
     
     // destructor
     ~CentralDifference();
     
+    // with constantMass set the tangent, the mass and damping scaled by
+    // the time step, is formed and factored once after each
+    // domainChanged() and again only when the time step changes; the
+    // mass and damping of the nodes and elements must then not change.
+    // the first time it is formed each element's damping is checked to
+    // be a multiple of its mass; stiffness proportional damping, set
+    // here or by the elements' rayleigh factors, follows the stiffness
+    // and turns constantMass off with a warning. unlike the -factorOnce
+    // option of the Linear algorithm this forms the tangent again after
+    // the model changes or the time step changes.
+    int formTangent(int statFlag);
+
     // methods which define what the FE_Element and DOF_Groups add
     // to the system of equation object.
     int formEleTangent(FE_Element *theEle);
@@ -69,6 +82,8 @@ public:
 protected:
     
 private:
+    bool isDampingConstant(void);
+    
     double deltaT;
     
     // rayleigh damping factors
@@ -79,6 +94,8 @@ private:
     
     int updateCount;                // method should only have one update per step
     double c2, c3;                  // some constants we need to keep
+    bool constantMass;              // form the tangent once, see formTangent()
+    double tangentDeltaT;           // deltaT the tangent was formed for, 0 if not formed
     Vector *Utm1;                   // disp response quantity at time t-deltaT
     Vector *Ut, *Utdot, *Utdotdot;  // response quantities at time t
     Vector *Udot, *Udotdot;         // response quantities at time t+deltaT
@@ -10,13 +10,24 @@
 #include <Channel.h>
 #include <FEM_ObjectBroker.h>
 #include <elementAPI.h>
+#include <string.h>
 #define OPS_Export 
 
 
 void* OPS_ExplicitDifference(void)
 {
 	TransientIntegrator *theIntegrator = 0;
-	theIntegrator = new ExplicitDifference();
+
+	bool constantMass = false;
+	while (OPS_GetNumRemainingInputArgs() > 0) {
+		const char *arg = OPS_GetString();
+		if (strcmp(arg, "-constantMass") == 0)
+			constantMass = true;
+		else
+			opserr << "WARNING ExplicitDifference - ignoring unknown option " << arg << endln;
+	}
+
+	theIntegrator = new ExplicitDifference(constantMass);
 
 	if (theIntegrator == 0)
 		opserr << "WARNING - out of memory creating ExplicitDifference integrator\n";
@@ -30,6 +41,7 @@ ExplicitDifference::ExplicitDifference()
 	deltaT(0.0),
 	alphaM(0.0), betaK(0.0), betaKi(0.0), betaKc(0.0),
 	updateCount(0), c2(0.0), c3(0.0),
+	constantMass(false), massFormed(false),
     Ut(0), Utdot(0), Utdotdot(0),
 	Udot(0), Utdotdot1(0), U(0), Utdot1(0)
 {
@@ -43,6 +55,20 @@ ExplicitDifference::ExplicitDifference(
 	deltaT(0.0),
 	alphaM(_alphaM), betaK(_betaK), betaKi(_betaKi), betaKc(_betaKc),
 	updateCount(0), c2(0.0), c3(0.0),
+	constantMass(false), massFormed(false),
+	Ut(0), Utdot(0), Utdotdot(0),
+	Udot(0), Utdotdot1(0), U(0), Utdot1(0)
+{
+
+}
+
+
+ExplicitDifference::ExplicitDifference(bool _constantMass)
+	: TransientIntegrator(INTEGRATOR_TAGS_ExplicitDifference),
+	deltaT(0.0),
+	alphaM(0.0), betaK(0.0), betaKi(0.0), betaKc(0.0),
+	updateCount(0), c2(0.0), c3(0.0),
+	constantMass(_constantMass), massFormed(false),
 	Ut(0), Utdot(0), Utdotdot(0),
 	Udot(0), Utdotdot1(0), U(0), Utdot1(0)
 {
@@ -87,24 +113,23 @@ int ExplicitDifference::newStep(double _deltaT)
 	// get a pointer to the AnalysisModel
 	AnalysisModel *theModel = this->getAnalysisModel();
 
-	//calculate vel at t+0.5deltaT and U at t+delatT
-	Utdot->addVector(1.0, *Utdotdot, deltaT);
-	Ut->addVector(1.0, *Utdot, deltaT);
-
-	int size = Utdotdot->Size();
-
 	if (Ut == 0)  {
 		opserr << "ExplicitDifference::newStep() - domainChange() failed or hasn't been called\n";
 		return -2;
 	}
 
-	// for leap-frog method Ma=f-ku-cv, on the right side there is no Ma
-	(*Utdotdot) *= 0;
+	//calculate vel at t+0.5deltaT and U at t+delatT, and for leap-frog
+	//method Ma=f-ku-cv, on the right side there is no Ma
+	int size = Utdotdot->Size();
+	for (int i = 0; i < size; i++)  {
+		double v = (*Utdot)(i) + deltaT*(*Utdotdot)(i);
+		(*Utdot)(i) = v;
+		(*Ut)(i) += deltaT*v;
+		(*Utdotdot)(i) = 0.0;
+	}
 
 	// set the garbage response quantities for the nodes
-	theModel->setVel(*Utdot);
-	theModel->setAccel(*Utdotdot);
-	theModel->setDisp(*Ut);
+	theModel->setResponse(*Ut, *Utdot, *Utdotdot);
 
 	// increment the time to t and apply the load
 	double time = theModel->getCurrentDomainTime();
@@ -121,6 +146,19 @@ int ExplicitDifference::newStep(double _deltaT)
 }
 
 
+int ExplicitDifference::formTangent(int statFlag)
+{
+	if (constantMass == true && massFormed == true)
+		return 0;
+
+	int result = this->TransientIntegrator::formTangent(statFlag);
+	if (result == 0)
+		massFormed = true;
+
+	return result;
+}
+
+
 int ExplicitDifference::formEleTangent(FE_Element *theEle)
 {
 	theEle->zeroTangent();
@@ -149,6 +187,8 @@ int ExplicitDifference::domainChanged()
 	const Vector &x = theLinSOE->getX();
 	int size = x.Size();
 
+	// the LinearSOE has been resized, the mass must be formed again
+	massFormed = false;
 
 
 	// if damping factors exist set them in the element & node of the domain
@@ -302,12 +342,12 @@ int ExplicitDifference::update(const Vector &Udotdot)
 	// determine the response at t+deltaT
 	double halfT = deltaT *0.125;
 
-	Utdotdot1->addVector(0.0, Udotdot, 3.0);
-	Utdotdot1->addVector(1.0, *Utdotdot, 1.0);
-
 	//Velosity to output, because Utdot is velosity is defined at t+0.5deltaT
-	Utdot1->addVector(0.0, *Utdot, 1.0);
-	Utdot1->addVector(1.0, *Utdotdot1, halfT);
+	for (int i = 0; i < size; i++)  {
+		double a1 = 3.0*Udotdot(i) + (*Utdotdot)(i);
+		(*Utdotdot1)(i) = a1;
+		(*Utdot1)(i) = (*Utdot)(i) + halfT*a1;
+	}
 
 
 	theModel->setResponse(*Ut, *Utdot1, Udotdot);
@@ -345,11 +385,12 @@ int ExplicitDifference::commit(void)
 
 int ExplicitDifference::sendSelf(int cTag, Channel &theChannel)
 {
-	Vector data(4);
+	Vector data(5);
 	data(0) = alphaM;
 	data(1) = betaK;
 	data(2) = betaKi;
 	data(3) = betaKc;
+	data(4) = (constantMass == true) ? 1.0 : 0.0;
 
 	if (theChannel.sendVector(this->getDbTag(), cTag, data) < 0)  {
 		opserr << "WARNING ExplicitDifference::sendSelf() - could not send data\n";
@@ -362,7 +403,7 @@ int ExplicitDifference::sendSelf(int cTag, Channel &theChannel)
 
 int ExplicitDifference::recvSelf(int cTag, Channel &theChannel, FEM_ObjectBroker &theBroker)
 {
-	Vector data(4);
+	Vector data(5);
 	if (theChannel.recvVector(this->getDbTag(), cTag, data) < 0)  {
 		opserr << "WARNING ExplicitDifference::recvSelf() - could not receive data\n";
 		return -1;
@@ -372,6 +413,8 @@ int ExplicitDifference::recvSelf(int cTag, Channel &theChannel, FEM_ObjectBroker
 	betaK = data(1);
 	betaKi = data(2);
 	betaKc = data(3);
+	constantMass = (data(4) != 0.0);
+	massFormed = false;
 
 	return 0;
 }
@@ -385,6 +428,8 @@ void ExplicitDifference::Print(OPS_Stream &s, int flag)
 		s << "ExplicitDifference - currentTime: " << currentTime << endln;
 		s << "  Rayleigh Damping - alphaM: " << alphaM << "  betaK: " << betaK;
 		s << "  betaKi: " << betaKi << "  betaKc: " << betaKc << endln;
+		if (constantMass == true)
+			s << "  mass formed once\n";
 	}
 	else
 		s << "ExplicitDifference - no associated AnalysisModel\n";
@@ -14,10 +14,19 @@ class ExplicitDifference : public TransientIntegrator
 public:
 	ExplicitDifference();
 	ExplicitDifference(double alphaM, double betaK, double betaKi, double betaKc);
+	ExplicitDifference(bool constantMass);
 	~ExplicitDifference();                                                                //constructors and unconstructor
 
 	                                                 
 
+	// with constantMass set the mass is formed and factored once after
+	// each domainChanged(), the later calls returning at once and leaving
+	// the LinearSOE as it is; the nodal and element masses, and any modal
+	// damping, must then not change until the domain next changes. the
+	// Rayleigh and element damping only enter the residual, so they may
+	// depend on the current stiffness
+	int formTangent(int statFlag);
+
 	int formEleTangent(FE_Element *theEle);
 
 	int formNodTangent(DOF_Group *theDof);
@@ -47,6 +56,8 @@ private:
 
 	int updateCount;
 	double c2, c3;
+	bool constantMass;
+	bool massFormed;
 	Vector *U, *Ut;
 	Vector  *Utdotdot, *Utdotdot1;
 	Vector *Udot, *Utdot, *Utdot1;
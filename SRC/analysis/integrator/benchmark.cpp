@@ -0,0 +1,176 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// File: ~/analysis/integrator/benchmark.cpp
+//
+// Description: steps per second of the explicit integrators. A lattice of
+// nx x ny bays of trusses with lumped mass, fixed along its base and
+// pushed along its top, is analysed for numSteps steps with the
+// ExplicitDifference and CentralDifference integrators, the Linear
+// algorithm and a lumped DiagonalSOE, first forming the mass every step
+// and then with -constantMass, and with the nodal response set on 1, 2,
+// 4 .. up to maxThreads threads. The time, the steps per second and the
+// horizontal displacement of the top corner are printed. Built with
+// "make benchmark", run as
+//    "explicit_benchmark nx ny numSteps maxThreads <variant>"
+// where variant 1 to 4 runs only one of the four integrators. A model
+// built after another has been freed lies scattered over the heap and
+// runs up to twice as slow, so compare the variants run one per process.
+
+#include <Domain.h>
+#include <Node.h>
+#include <Truss.h>
+#include <ElasticMaterial.h>
+#include <SP_Constraint.h>
+#include <LoadPattern.h>
+#include <LinearSeries.h>
+#include <NodalLoad.h>
+#include <AnalysisModel.h>
+#include <PlainHandler.h>
+#include <PlainNumberer.h>
+#include <Linear.h>
+#include <DiagonalSOE.h>
+#include <DiagonalDirectSolver.h>
+#include <ExplicitDifference.h>
+#include <CentralDifference.h>
+#include <DirectIntegrationAnalysis.h>
+#include <ThreadPool.h>
+#include <Vector.h>
+#include <OPS_Globals.h>
+#include <StandardStream.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+
+StandardStream sserr;
+OPS_Stream *opserrPtr = &sserr;
+
+static void
+buildModel(Domain &theDomain, int nx, int ny)
+{
+  // the nodes, numbered row by row from the base
+  for (int j=0; j<=ny; j++)
+    for (int i=0; i<=nx; i++) {
+      int tag = j*(nx+1) + i + 1;
+      theDomain.addNode(new Node(tag, 2, (double)i, (double)j));
+    }
+
+  // a horizontal, a vertical and a diagonal truss for each bay
+  ElasticMaterial theMaterial(1, 1000.0);
+  int eleTag = 1;
+  for (int j=0; j<=ny; j++)
+    for (int i=0; i<=nx; i++) {
+      int node = j*(nx+1) + i + 1;
+      if (i < nx)
+	theDomain.addElement(new Truss(eleTag++, 2, node, node+1, theMaterial, 1.0, 1.0));
+      if (j < ny)
+	theDomain.addElement(new Truss(eleTag++, 2, node, node+nx+1, theMaterial, 1.0, 1.0));
+      if (i < nx && j < ny)
+	theDomain.addElement(new Truss(eleTag++, 2, node, node+nx+2, theMaterial, 0.5, 1.0));
+    }
+
+  // fix the base
+  for (int i=0; i<=nx; i++) {
+    theDomain.addSP_Constraint(new SP_Constraint(i+1, 0, 0.0, true));
+    theDomain.addSP_Constraint(new SP_Constraint(i+1, 1, 0.0, true));
+  }
+
+  // push the top, the load growing linearly with time
+  LoadPattern *thePattern = new LoadPattern(1);
+  thePattern->setTimeSeries(new LinearSeries(1, 1.0));
+  theDomain.addLoadPattern(thePattern);
+  Vector theForce(2);
+  theForce(0) = 1.0;
+  for (int i=0; i<=nx; i++)
+    theDomain.addNodalLoad(new NodalLoad(i+1, ny*(nx+1) + i + 1, theForce), 1);
+}
+
+static void
+run(const char *name, TransientIntegrator *theIntegrator,
+    int nx, int ny, int numSteps, double dT, int numThreads)
+{
+  Domain theDomain;
+  buildModel(theDomain, nx, ny);
+
+  AnalysisModel *theModel = new AnalysisModel();
+  theModel->setNumThreads(numThreads);
+  DiagonalSolver *theSolver = new DiagonalDirectSolver();
+  DirectIntegrationAnalysis theAnalysis(theDomain,
+					*(new PlainHandler()),
+					*(new PlainNumberer()),
+					*theModel,
+					*(new Linear()),
+					*(new DiagonalSOE(*theSolver, true)),
+					*theIntegrator);
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  int ok = theAnalysis.analyze(numSteps, dT);
+  double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  double corner = theDomain.getNode((ny+1)*(nx+1))->getDisp()(0);
+  printf("%-34s %8d %10.3f %12.1f %14.6e%s\n", name, numThreads, time,
+	 numSteps/time, corner, (ok < 0) ? " FAILED" : "");
+
+  theAnalysis.clearAll();
+}
+
+int main(int argc, char **argv)
+{
+  int nx = 200;
+  int ny = 100;
+  int numSteps = 500;
+  int maxThreads = ThreadPool::getNumProcessors();
+  if (argc > 1)
+    nx = atoi(argv[1]);
+  if (argc > 2)
+    ny = atoi(argv[2]);
+  if (argc > 3)
+    numSteps = atoi(argv[3]);
+  if (argc > 4)
+    maxThreads = atoi(argv[4]);
+  int variant = 0;
+  if (argc > 5)
+    variant = atoi(argv[5]);
+
+  double dT = 0.01;
+
+  printf("%d x %d bays, %d equations, %d steps of %g\n", nx, ny,
+	 2*(nx+1)*ny, numSteps, dT);
+  printf("%-34s %8s %10s %12s %14s\n", "integrator", "threads", "time",
+	 "steps/sec", "corner disp");
+
+  for (int numThreads = 1; numThreads <= maxThreads; numThreads *= 2) {
+    if (variant == 0 || variant == 1)
+      run("ExplicitDifference", new ExplicitDifference(),
+	  nx, ny, numSteps, dT, numThreads);
+    if (variant == 0 || variant == 2)
+      run("ExplicitDifference -constantMass", new ExplicitDifference(true),
+	  nx, ny, numSteps, dT, numThreads);
+    if (variant == 0 || variant == 3)
+      run("CentralDifference", new CentralDifference(),
+	  nx, ny, numSteps, dT, numThreads);
+    if (variant == 0 || variant == 4)
+      run("CentralDifference -constantMass", new CentralDifference(true),
+	  nx, ny, numSteps, dT, numThreads);
+  }
+
+  return 0;
+}
@@ -45,10 +45,13 @@
 #include <DOF_GrpIter.h>
 #include <FE_EleIter.h>
 #include <Graph.h>
+#include <GraphBuilder.h>
 #include <Vertex.h>
 #include <Node.h>
 #include <NodeIter.h>
 #include <ConstraintHandler.h>
+#include <NodeConstraintIndex.h>
+#include <ThreadPool.h>
 
 
 #include <MapOfTaggedObjects.h>
@@ -63,7 +66,9 @@ AnalysisModel::AnalysisModel(int theClassTag)
 :MovableObject(theClassTag),
  myDomain(0), myHandler(0),
  myDOFGraph(0), myGroupGraph(0),
- numFE_Ele(0), numDOF_Grp(0), numEqn(0)
+ myConstraintIndex(0), constraintIndexFormed(false),
+ numFE_Ele(0), numDOF_Grp(0), numEqn(0),
+ responsePlanFormed(false), maxPlanDOF(0), thePool(0)
 {
     theFEs     = new ArrayOfTaggedObjects(1024);
     theDOFs    =  new ArrayOfTaggedObjects(1024);
@@ -77,7 +82,9 @@ AnalysisModel::AnalysisModel()
 :MovableObject(AnaMODEL_TAGS_AnalysisModel),
  myDomain(0), myHandler(0),
  myDOFGraph(0), myGroupGraph(0),
- numFE_Ele(0), numDOF_Grp(0), numEqn(0)
+ myConstraintIndex(0), constraintIndexFormed(false),
+ numFE_Ele(0), numDOF_Grp(0), numEqn(0),
+ responsePlanFormed(false), maxPlanDOF(0), thePool(0)
 {
   theFEs     = new ArrayOfTaggedObjects(256);
   theDOFs    = new ArrayOfTaggedObjects(256);
@@ -90,7 +97,9 @@ AnalysisModel::AnalysisModel(TaggedObjectStorage &theFes, TaggedObjectStorage &t
 :MovableObject(AnaMODEL_TAGS_AnalysisModel),
  myDomain(0), myHandler(0),
  myDOFGraph(0), myGroupGraph(0),
- numFE_Ele(0), numDOF_Grp(0), numEqn(0)
+ myConstraintIndex(0), constraintIndexFormed(false),
+ numFE_Ele(0), numDOF_Grp(0), numEqn(0),
+ responsePlanFormed(false), maxPlanDOF(0), thePool(0)
 {
   theFEs     = &theFes;
   theDOFs    = &theDofs;
@@ -125,6 +134,12 @@ AnalysisModel::~AnalysisModel()
   if (myDOFGraph != 0) {
     delete myDOFGraph;
   }
+
+  if (myConstraintIndex != 0)
+    delete myConstraintIndex;
+
+  if (thePool != 0)
+    delete thePool;
 }    
 
 void
@@ -195,6 +210,7 @@ AnalysisModel::addDOF_Group(DOF_Group *theGroup)
   bool result = theDOFs->addComponent(theGroup);
   if (result == true) {
     numDOF_Grp++;
+    responsePlanFormed = false;
     return true;  // o.k.
   } else
     return false;
@@ -215,6 +231,8 @@ AnalysisModel::clearAll(void)
 
     myDOFGraph = 0;
     myGroupGraph = 0;
+    constraintIndexFormed = false;
+    responsePlanFormed = false;
     
     numFE_Ele =0;
     numDOF_Grp = 0;
@@ -237,6 +255,9 @@ AnalysisModel::clearDOFGroupGraph(void)
     delete myGroupGraph;    
   
   myGroupGraph = 0;
+
+  // the numberers clear the graph once they have set the equation numbers
+  responsePlanFormed = false;
 }
 
 
@@ -279,6 +300,7 @@ void
 AnalysisModel::setNumEqn(int theNumEqn)
 {
     numEqn = theNumEqn;
+    responsePlanFormed = false;
 }
 
 int 
@@ -292,27 +314,42 @@ Graph &
 AnalysisModel::getDOFGraph(void)
 {
   if (myDOFGraph == 0) {
-    int numVertex = this->getNumDOF_Groups();
 
-    //    myDOFGraph = new Graph(numVertex);
-    MapOfTaggedObjects *graphStorage = new MapOfTaggedObjects();
+    //
+    // the vertex tags are the equation numbers, find the largest so the
+    // vertices can be stored in an array indexed by tag
+    //
+
+    int maxEqn = START_EQN_NUM - 1;
+    DOF_Group *dofPtr =0;
+    DOF_GrpIter &theDOFs = this->getDOFs();
+    while ((dofPtr = theDOFs()) != 0) {
+      const ID &id = dofPtr->getID();
+      int size = id.Size();
+      for (int i=0; i<size; i++)
+	if (id(i) > maxEqn)
+	  maxEqn = id(i);
+    }
+    int numVertex = maxEqn - START_EQN_NUM + 1;
+
+    ArrayOfTaggedObjects *graphStorage = new ArrayOfTaggedObjects(numVertex);
     myDOFGraph = new Graph(*graphStorage);
 
     //
     // create a vertex for each dof
     //
     
-    DOF_Group *dofPtr =0;
-    DOF_GrpIter &theDOFs = this->getDOFs();
-    while ((dofPtr = theDOFs()) != 0) {
+    DOF_GrpIter &theDOFs2 = this->getDOFs();
+    while ((dofPtr = theDOFs2()) != 0) {
       const ID &id = dofPtr->getID();
       int size = id.Size();
       for (int i=0; i<size; i++) {
 	int dofTag = id(i);
 	if (dofTag >= START_EQN_NUM) {
-	  Vertex *vertexPtr = myDOFGraph->getVertexPtr(dofTag);
+	  int vertexTag = dofTag-START_EQN_NUM+START_VERTEX_NUM;
+	  Vertex *vertexPtr = myDOFGraph->getVertexPtr(vertexTag);
 	  if (vertexPtr == 0) {
-	    Vertex *vertexPtr = new Vertex(dofTag, dofTag);      
+	    Vertex *vertexPtr = new Vertex(vertexTag, dofTag);      
 	    if (vertexPtr == 0) {
 	      opserr << "WARNING AnalysisModel::getDOFGraph";
 	      opserr << " - Not Enough Memory to create " << i+1 << "th Vertex\n";
@@ -328,32 +365,17 @@ AnalysisModel::getDOFGraph(void)
     }
     
     // now add the edges, by looping over the FE_elements, getting their
-    // IDs and adding edges between DOFs for equation numbers >= START_EQN_NUM
+    // IDs and collecting the DOFs for equation numbers >= START_EQN_NUM;
+    // the adjacency of every vertex is then formed at once
     
+    GraphBuilder theBuilder(numVertex);
     FE_Element *elePtr =0;
     FE_EleIter &eleIter = this->getFEs();
-    int cnt = 0;
-    
-	myDOFGraph->startAddEdge();
-    while((elePtr = eleIter()) != 0) {
-      const ID &id = elePtr->getID();
-      cnt++;
-      int size = id.Size();
-      for (int i=0; i<size; i++) {
-	int eqn1 = id(i);
-	
-	// if eqnNum of DOF is a valid eqn number add an edge
-	// to all other DOFs with valid eqn numbers.
-	if (eqn1 >=START_EQN_NUM) {
-	  for (int j=i+1; j<size; j++) {
-	    int eqn2 = id(j);
-	    if (eqn2 >=START_EQN_NUM)
-	      myDOFGraph->addEdgeFast(eqn1-START_EQN_NUM+START_VERTEX_NUM,
-				  eqn2-START_EQN_NUM+START_VERTEX_NUM);
-	  }
-	}
-      }
-    }
+    while((elePtr = eleIter()) != 0)
+      theBuilder.addClique(elePtr->getID(), START_VERTEX_NUM-START_EQN_NUM);
+
+    if (theBuilder.build(*myDOFGraph) < 0)
+      opserr << "WARNING AnalysisModel::getDOFGraph - failed to add the edges\n";
   }    
 
   return *myDOFGraph;
@@ -372,17 +394,18 @@ AnalysisModel::getDOFGroupGraph(void)
 	exit(-1);
     }	
 
-    //    myGroupGraph = new Graph(numVertex);
-    MapOfTaggedObjects *graphStorage = new MapOfTaggedObjects();
-    myGroupGraph = new Graph(*graphStorage);
-
-    if (numVertex == 0) {
-	opserr << "WARNING AnalysisMode::getGroupGraph";
-	opserr << "  - out of memory\n";
-	exit(-1);
-    }	
-	
+    // the vertex tags are the DOF_Group tags, find the largest so the
+    // vertices can be stored in an array indexed by tag
     DOF_Group *dofPtr;
+    DOF_GrpIter &dofIter1 = this->getDOFs();
+    int maxTag = START_VERTEX_NUM - 1;
+    while ((dofPtr = dofIter1()) != 0)
+      if (dofPtr->getTag() > maxTag)
+	maxTag = dofPtr->getTag();
+    int numTag = maxTag - START_VERTEX_NUM + 1;
+
+    ArrayOfTaggedObjects *graphStorage = new ArrayOfTaggedObjects(numTag);
+    myGroupGraph = new Graph(*graphStorage);
 
     // now create the vertices with a reference equal to the DOF_Group number.
     // and a tag which ranges from 0 through numVertex-1
@@ -406,107 +429,262 @@ AnalysisModel::getDOFGroupGraph(void)
     }
 
     // now add the edges, by looping over the Elements, getting their
-    // IDs and adding edges between DOFs for equation numbers >= START_EQN_NUM
+    // DOF_Group tags and forming the adjacency of every vertex at once
     
+    GraphBuilder theBuilder(numTag);
     FE_Element *elePtr;
     FE_EleIter &eleIter = this->getFEs();
+    while((elePtr = eleIter()) != 0)
+      theBuilder.addClique(elePtr->getDOFtags());
 
-    while((elePtr = eleIter()) != 0) {
-	const ID &id = elePtr->getDOFtags();
-	int size = id.Size();
-	for (int i=0; i<size; i++) {
-	    int dof1 = id(i);
-	    for (int j=0; j<size; j++) 
-		if (i != j) {
-		    int dof2 = id(j);
-		    myGroupGraph->addEdge(dof1,dof2);
-		}
-	}
-    }
+    if (theBuilder.build(*myGroupGraph) < 0)
+      opserr << "WARNING AnalysisModel::getDOFGroupGraph - failed to add the edges\n";
   }
 
   return *myGroupGraph;
 }
 
 
+const NodeConstraintIndex &
+AnalysisModel::getNodeConstraintIndex(void)
+{
+  if (myConstraintIndex == 0)
+    myConstraintIndex = new NodeConstraintIndex();
 
+  if (constraintIndexFormed == false) {
+    if (myDomain == 0) {
+      opserr << "WARNING AnalysisModel::getNodeConstraintIndex";
+      opserr << " - no Domain, has setLinks() been called?\n";
+      myConstraintIndex->clear();
+      return *myConstraintIndex;
+    }
 
-void 
+    myConstraintIndex->form(*myDomain);
+    constraintIndexFormed = true;
+  }
+
+  return *myConstraintIndex;
+}
+
+
+void
 AnalysisModel::setResponse(const Vector &disp,
 			   const Vector &vel, 
 			   const Vector &accel)
 {
-    DOF_GrpIter &theDOFGrps = this->getDOFs();
-    DOF_Group 	*dofPtr;
-
-    while ((dofPtr = theDOFGrps()) != 0) {
-	dofPtr->setNodeDisp(disp);
-	dofPtr->setNodeVel(vel);
-	dofPtr->setNodeAccel(accel);	
-    }
+    this->scatterResponse(&disp, &vel, &accel, false);
 }	
 	
 void 
 AnalysisModel::setDisp(const Vector &disp)
 {
-    DOF_GrpIter &theDOFGrps = this->getDOFs();
-    DOF_Group 	*dofPtr;
-
-    while ((dofPtr = theDOFGrps()) != 0) 
-	dofPtr->setNodeDisp(disp);
+    this->scatterResponse(&disp, 0, 0, false);
 }	
 	
 void 
 AnalysisModel::setVel(const Vector &vel)
 {
-        DOF_GrpIter &theDOFGrps = this->getDOFs();
-    DOF_Group 	*dofPtr;
-    
-    while ((dofPtr = theDOFGrps()) != 0) 
-	dofPtr->setNodeVel(vel);
+    this->scatterResponse(0, &vel, 0, false);
 }	
 	
 
 void 
 AnalysisModel::setAccel(const Vector &accel)
 {
-    DOF_GrpIter &theDOFGrps = this->getDOFs();
-    DOF_Group 	*dofPtr;
-    
-    while ((dofPtr = theDOFGrps()) != 0) 
-	dofPtr->setNodeAccel(accel);	
+    this->scatterResponse(0, 0, &accel, false);
 }	
 
 void 
 AnalysisModel::incrDisp(const Vector &disp)
 {
-    DOF_GrpIter &theDOFGrps = this->getDOFs();
-    DOF_Group 	*dofPtr;
-
-    while ((dofPtr = theDOFGrps()) != 0) 
-	dofPtr->incrNodeDisp(disp);
+    this->scatterResponse(&disp, 0, 0, true);
 }	
 	
 void 
 AnalysisModel::incrVel(const Vector &vel)
 {
-        DOF_GrpIter &theDOFGrps = this->getDOFs();
-    DOF_Group 	*dofPtr;
-    
-    while ((dofPtr = theDOFGrps()) != 0) 
-	dofPtr->incrNodeVel(vel);
+    this->scatterResponse(0, &vel, 0, true);
 }	
 	
 void 
 AnalysisModel::incrAccel(const Vector &accel)
 {
-    DOF_GrpIter &theDOFGrps = this->getDOFs();
-    DOF_Group 	*dofPtr;
-    
-    while ((dofPtr = theDOFGrps()) != 0) 
-	dofPtr->incrNodeAccel(accel);	
+    this->scatterResponse(0, 0, &accel, true);
 }	
 
+void
+AnalysisModel::setNumThreads(int numThreads)
+{
+  if (numThreads == this->getNumThreads())
+    return;
+
+  if (thePool != 0) {
+    delete thePool;
+    thePool = 0;
+  }
+
+  if (numThreads > 1)
+    thePool = new ThreadPool(numThreads);
+
+  // the work area is sized by the number of threads
+  responsePlanFormed = false;
+}
+
+int
+AnalysisModel::getNumThreads(void) const
+{
+  if (thePool == 0)
+    return 1;
+  return thePool->getNumThreads();
+}
+
+// int formResponsePlan(void);
+//	Method to gather, in the order of the DOF_GrpIter, the Node and the
+//	equation numbers of every DOF_Group that sets the trial response of
+//	its Node straight from the equation numbers in its ID. The other
+//	DOF_Groups, e.g. the TransformationDOF_Groups, are kept aside and
+//	left to set their Node themselves.
+
+int
+AnalysisModel::formResponsePlan(void)
+{
+  planNodes.clear();
+  planStart.assign(1, 0);
+  planLoc.clear();
+  planConstrained.clear();
+  planGroups.clear();
+  maxPlanDOF = 0;
+
+  DOF_GrpIter &theDOFGrps = this->getDOFs();
+  DOF_Group *dofPtr;
+  while ((dofPtr = theDOFGrps()) != 0) {
+    Node *theNode = dofPtr->getResponseNode();
+    if (theNode == 0) {
+      planGroups.push_back(dofPtr);
+      continue;
+    }
+
+    const ID &theID = dofPtr->getID();
+    int numDOF = theID.Size();
+    bool constrained = false;
+    for (int i=0; i<numDOF; i++) {
+      int loc = theID(i);
+      if (loc < 0) {
+	loc = -1;
+	constrained = true;
+      }
+      planLoc.push_back(loc);
+    }
+
+    planNodes.push_back(theNode);
+    planStart.push_back(planLoc.size());
+    planConstrained.push_back(constrained);
+    if (numDOF > maxPlanDOF)
+      maxPlanDOF = numDOF;
+  }
+
+  planWork.resize(maxPlanDOF*this->getNumThreads());
+  responsePlanFormed = true;
+  return 0;
+}
+
+// fills work with the entries of u for the free dofs and, for the
+// constrained dofs, with the entries of current or 0 if there is none
+static void
+gatherResponse(double *work, const int *loc, int numDOF,
+	       const Vector &u, const Vector *current)
+{
+  for (int i=0; i<numDOF; i++) {
+    if (loc[i] >= 0)
+      work[i] = u(loc[i]);
+    else if (current != 0)
+      work[i] = (*current)(i);
+    else
+      work[i] = 0.0;
+  }
+}
+
+// void scatterResponse(const Vector *disp, const Vector *vel,
+//			const Vector *accel, bool incr);
+//	Method to set, or increment if incr is true, the trial response of
+//	the nodes to the non-zero vectors given. The nodes of the plan are
+//	swept from start to end, split over the threads of the pool as each
+//	node is only touched by one thread; the remaining DOF_Groups are
+//	then invoked on the calling thread as they use class wide vectors.
+
+void
+AnalysisModel::scatterResponse(const Vector *disp, const Vector *vel,
+			       const Vector *accel, bool incr)
+{
+  if (responsePlanFormed == false)
+    this->formResponsePlan();
+
+  int numNodes = planNodes.size();
+  auto sweep = [&](int begin, int end, int threadID) {
+    double *work = &planWork[threadID*maxPlanDOF];
+    for (int i=begin; i<end; i++) {
+      Node *theNode = planNodes[i];
+      const int *loc = &planLoc[planStart[i]];
+      int numDOF = planStart[i+1] - planStart[i];
+      bool keepCurrent = (planConstrained[i] != 0 && incr == false);
+      Vector theResponse(work, numDOF);
+
+      if (disp != 0) {
+	gatherResponse(work, loc, numDOF, *disp,
+		       keepCurrent ? &theNode->getTrialDisp() : 0);
+	if (incr == false)
+	  theNode->setTrialDisp(theResponse);
+	else
+	  theNode->incrTrialDisp(theResponse);
+      }
+
+      if (vel != 0) {
+	gatherResponse(work, loc, numDOF, *vel,
+		       keepCurrent ? &theNode->getTrialVel() : 0);
+	if (incr == false)
+	  theNode->setTrialVel(theResponse);
+	else
+	  theNode->incrTrialVel(theResponse);
+      }
+
+      if (accel != 0) {
+	gatherResponse(work, loc, numDOF, *accel,
+		       keepCurrent ? &theNode->getTrialAccel() : 0);
+	if (incr == false)
+	  theNode->setTrialAccel(theResponse);
+	else
+	  theNode->incrTrialAccel(theResponse);
+      }
+    }
+  };
+
+  if (numNodes > 0) {
+    if (thePool != 0)
+      thePool->parallelFor(numNodes, sweep);
+    else
+      sweep(0, numNodes, 0);
+  }
+
+  for (int i=0; i<(int)planGroups.size(); i++) {
+    DOF_Group *dofPtr = planGroups[i];
+    if (incr == false) {
+      if (disp != 0)
+	dofPtr->setNodeDisp(*disp);
+      if (vel != 0)
+	dofPtr->setNodeVel(*vel);
+      if (accel != 0)
+	dofPtr->setNodeAccel(*accel);
+    } else {
+      if (disp != 0)
+	dofPtr->incrNodeDisp(*disp);
+      if (vel != 0)
+	dofPtr->incrNodeVel(*vel);
+      if (accel != 0)
+	dofPtr->incrNodeAccel(*accel);
+    }
+  }
+}
+
 
 void 
 AnalysisModel::setNumEigenvectors(int numEigenvectors)
@@ -40,6 +40,7 @@
 // What: "@(#) AnalysisModel.h, revA"
 
 #include <MovableObject.h>
+#include <vector>
 
 class TaggedObjectStorage;
 class Domain;
@@ -51,6 +52,9 @@ class DOF_Group;
 class Vector;
 class FEM_ObjectBroker;
 class ConstraintHandler;
+class NodeConstraintIndex;
+class Node;
+class ThreadPool;
 
 class AnalysisModel: public MovableObject
 {
@@ -79,6 +83,10 @@ class AnalysisModel: public MovableObject
     virtual int getNumEqn(void) const ; 
     virtual Graph &getDOFGraph(void);
     virtual Graph &getDOFGroupGraph(void);
+
+    // method to access the constraints of each node, formed from the
+    // Domain on first use after clearAll()
+    virtual const NodeConstraintIndex &getNodeConstraintIndex(void);
     
     // methods to update the response quantities at the DOF_Groups,
     // which in turn set the new nodal trial response quantities.
@@ -93,6 +101,11 @@ class AnalysisModel: public MovableObject
     virtual void incrVel(const Vector &vel);        
     virtual void incrAccel(const Vector &vel);            
 
+    // methods to set the number of threads the above methods use to
+    // update the nodes, 1 for the calling thread only
+    virtual void setNumThreads(int numThreads);
+    virtual int  getNumThreads(void) const;
+
     // methods added to store the eigenvalues and vectors in the domain
     virtual void setNumEigenvectors(int numEigenvectors);
     virtual void setEigenvector(int mode, const Vector &);
@@ -125,11 +138,17 @@ class AnalysisModel: public MovableObject
 
     
   private:
+    int  formResponsePlan(void);
+    void scatterResponse(const Vector *disp, const Vector *vel,
+			 const Vector *accel, bool incr);
+
     Domain *myDomain;
     ConstraintHandler *myHandler;
 
     Graph *myDOFGraph;
     Graph *myGroupGraph;    
+    NodeConstraintIndex *myConstraintIndex;
+    bool constraintIndexFormed;
     
     int numFE_Ele;             // number of FE_Elements objects added
     int numDOF_Grp;            // number of DOF_Group objects added
@@ -140,6 +159,18 @@ class AnalysisModel: public MovableObject
     
     FE_EleIter    *theFEiter;     
     DOF_GrpIter   *theDOFiter;    
+
+    // the plan used to set the trial response of the nodes, formed on first
+    // use after the equations are numbered
+    bool responsePlanFormed;
+    std::vector<Node *> planNodes;       // nodes of the plain DOF_Groups
+    std::vector<int>    planStart;       // the dofs of node i are given by
+    std::vector<int>    planLoc;         // planLoc[planStart[i]:planStart[i+1]]
+    std::vector<char>   planConstrained; // node i has a constrained dof
+    std::vector<DOF_Group *> planGroups; // DOF_Groups setting their own node
+    std::vector<double> planWork;        // maxPlanDOF doubles for each thread
+    int maxPlanDOF;
+    ThreadPool *thePool;
 };
 
 #endif
@@ -0,0 +1,197 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// File: ~/analysis/model/NodeConstraintIndex.cpp
+//
+// Description: This file contains the implementation of NodeConstraintIndex.
+
+#include <NodeConstraintIndex.h>
+#include <Domain.h>
+#include <MP_Constraint.h>
+#include <MP_ConstraintIter.h>
+#include <SP_Constraint.h>
+#include <SP_ConstraintIter.h>
+
+NodeConstraintIndex::NodeConstraintIndex()
+{
+
+}
+
+NodeConstraintIndex::~NodeConstraintIndex()
+{
+
+}
+
+int
+NodeConstraintIndex::form(Domain &theDomain)
+{
+  this->clear();
+
+  // first pass: give each constrained node a location and count the
+  // constraints at each location, remembering the location of each
+  std::vector<int> mpLocation;
+  std::vector<int> spLocation;
+
+  MP_ConstraintIter &theMPs = theDomain.getMPs();
+  MP_Constraint *theMP;
+  while ((theMP = theMPs()) != 0) {
+    int nodeTag = theMP->getNodeConstrained();
+    std::pair<std::unordered_map<int, int>::iterator, bool> result =
+      nodeLocation.insert(std::make_pair(nodeTag, (int)nodeTags.size()));
+    if (result.second == true) {
+      nodeTags.push_back(nodeTag);
+      mpStart.push_back(0);
+    }
+    int loc = result.first->second;
+    mpStart[loc]++;
+    mpLocation.push_back(loc);
+    mps.push_back(theMP);
+  }
+
+  SP_ConstraintIter &theSPs = theDomain.getDomainAndLoadPatternSPs();
+  SP_Constraint *theSP;
+  while ((theSP = theSPs()) != 0) {
+    int nodeTag = theSP->getNodeTag();
+    std::pair<std::unordered_map<int, int>::iterator, bool> result =
+      nodeLocation.insert(std::make_pair(nodeTag, (int)nodeTags.size()));
+    if (result.second == true)
+      nodeTags.push_back(nodeTag);
+    int loc = result.first->second;
+    if (spStart.size() < nodeTags.size())
+      spStart.resize(nodeTags.size(), 0);
+    spStart[loc]++;
+    spLocation.push_back(loc);
+    sps.push_back(theSP);
+  }
+
+  // turn the counts into starts
+  int numNodes = nodeTags.size();
+  mpStart.resize(numNodes+1, 0);
+  spStart.resize(numNodes+1, 0);
+  int numMP = 0;
+  int numSP = 0;
+  for (int i=0; i<=numNodes; i++) {
+    int count = mpStart[i];
+    mpStart[i] = numMP;
+    numMP += count;
+    count = spStart[i];
+    spStart[i] = numSP;
+    numSP += count;
+  }
+
+  // second pass: place the constraints, keeping them in iterator order
+  std::vector<MP_Constraint *> theMPList(mps);
+  std::vector<int> next(mpStart.begin(), mpStart.end()-1);
+  for (int i=0; i<numMP; i++)
+    mps[next[mpLocation[i]]++] = theMPList[i];
+
+  std::vector<SP_Constraint *> theSPList(sps);
+  next.assign(spStart.begin(), spStart.end()-1);
+  for (int i=0; i<numSP; i++)
+    sps[next[spLocation[i]]++] = theSPList[i];
+
+  return 0;
+}
+
+void
+NodeConstraintIndex::clear(void)
+{
+  nodeLocation.clear();
+  nodeTags.clear();
+  mpStart.clear();
+  mps.clear();
+  spStart.clear();
+  sps.clear();
+}
+
+int
+NodeConstraintIndex::getNumMPs(void) const
+{
+  return mps.size();
+}
+
+int
+NodeConstraintIndex::getNumSPs(void) const
+{
+  return sps.size();
+}
+
+int
+NodeConstraintIndex::getNumConstrainedNodes(void) const
+{
+  return nodeTags.size();
+}
+
+int
+NodeConstraintIndex::getConstrainedNode(int i) const
+{
+  return nodeTags[i];
+}
+
+bool
+NodeConstraintIndex::isConstrained(int nodeTag) const
+{
+  return nodeLocation.find(nodeTag) != nodeLocation.end();
+}
+
+int
+NodeConstraintIndex::getNumMPs(int nodeTag) const
+{
+  int loc = this->getLocation(nodeTag);
+  if (loc < 0)
+    return 0;
+  return mpStart[loc+1] - mpStart[loc];
+}
+
+MP_Constraint *const *
+NodeConstraintIndex::getMPs(int nodeTag) const
+{
+  int loc = this->getLocation(nodeTag);
+  if (loc < 0)
+    return 0;
+  return mps.data() + mpStart[loc];
+}
+
+int
+NodeConstraintIndex::getNumSPs(int nodeTag) const
+{
+  int loc = this->getLocation(nodeTag);
+  if (loc < 0)
+    return 0;
+  return spStart[loc+1] - spStart[loc];
+}
+
+SP_Constraint *const *
+NodeConstraintIndex::getSPs(int nodeTag) const
+{
+  int loc = this->getLocation(nodeTag);
+  if (loc < 0)
+    return 0;
+  return sps.data() + spStart[loc];
+}
+
+int
+NodeConstraintIndex::getLocation(int nodeTag) const
+{
+  std::unordered_map<int, int>::const_iterator it = nodeLocation.find(nodeTag);
+  if (it == nodeLocation.end())
+    return -1;
+  return it->second;
+}
@@ -0,0 +1,80 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// File: ~/analysis/model/NodeConstraintIndex.h
+//
+// Description: This file contains the class definition for
+// NodeConstraintIndex. A NodeConstraintIndex holds the MP_Constraints and
+// the SP_Constraints of a Domain grouped by the tag of the node they
+// constrain, so that the ConstraintHandlers and DOF_Numberers can get the
+// constraints of a node in constant time instead of searching all the
+// constraints of the Domain for each node. The constraints of a node are
+// kept in the order the Domain iterators return them. The index is formed
+// by the AnalysisModel on first use after clearAll(), i.e. once each time
+// the Domain changes.
+
+#ifndef NodeConstraintIndex_h
+#define NodeConstraintIndex_h
+
+#include <vector>
+#include <unordered_map>
+
+class Domain;
+class MP_Constraint;
+class SP_Constraint;
+
+class NodeConstraintIndex
+{
+  public:
+    NodeConstraintIndex();
+    ~NodeConstraintIndex();
+
+    int form(Domain &theDomain);
+    void clear(void);
+
+    // the total numbers and the constrained nodes, the nodes in the
+    // order they are first met in the MPs and then in the SPs
+    int getNumMPs(void) const;
+    int getNumSPs(void) const;
+    int getNumConstrainedNodes(void) const;
+    int getConstrainedNode(int i) const;
+
+    // the constraints acting on a node, the methods return 0 constraints
+    // for a node without any
+    bool isConstrained(int nodeTag) const;
+    int getNumMPs(int nodeTag) const;
+    MP_Constraint *const *getMPs(int nodeTag) const;
+    int getNumSPs(int nodeTag) const;
+    SP_Constraint *const *getSPs(int nodeTag) const;
+
+  protected:
+
+  private:
+    int getLocation(int nodeTag) const;
+
+    std::unordered_map<int, int> nodeLocation;  // node tag -> location
+    std::vector<int> nodeTags;                  // location -> node tag
+    std::vector<int> mpStart;                   // MPs of location i in
+    std::vector<MP_Constraint *> mps;           // mps[mpStart[i]:mpStart[i+1]]
+    std::vector<int> spStart;
+    std::vector<SP_Constraint *> sps;
+};
+
+#endif
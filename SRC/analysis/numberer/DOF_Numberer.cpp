@@ -52,6 +52,7 @@
 #include <MP_Constraint.h>
 #include <Node.h>
 #include <MP_ConstraintIter.h>
+#include <NodeConstraintIndex.h>
 #include <DOF_GrpIter.h>
 // Constructor
 
@@ -170,6 +171,7 @@ DOF_Numberer::numberDOF(int lastDOF_Group)
 
     // iterate through the DOFs one last time setting any -4 values
     // iterate through  the DOFs second time setting -3 values
+    const NodeConstraintIndex &theIndex = theAnalysisModel->getNodeConstraintIndex();
     DOF_GrpIter &tDOFs = theAnalysisModel->getDOFs();
     DOF_Group *dofPtr;
     while ((dofPtr = tDOFs()) != 0) {
@@ -183,25 +185,23 @@ DOF_Numberer::numberDOF(int lastDOF_Group)
 		// loop through the MP_Constraints to see if any of the
 		// DOFs are constrained, note constraint matrix must be diagonal
 		// with 1's on the diagonal
-		MP_ConstraintIter &theMPs = theDomain->getMPs();
-		MP_Constraint *mpPtr;
-		while ((mpPtr = theMPs()) != 0 ) {
-			// note keep looping over all in case multiple constraints
-			// are used to constrain a node -- can't assume intelli user
-	    		if (mpPtr->getNodeConstrained() == nodeID) {
-	    			int nodeRetained = mpPtr->getNodeRetained();
-	    			Node *nodeRetainedPtr = theDomain->getNode(nodeRetained);
-	    			DOF_Group *retainedDOF = nodeRetainedPtr->getDOF_GroupPtr();
-	    			const ID&retainedDOFIDs = retainedDOF->getID();
-	    			const ID&constrainedDOFs = mpPtr->getConstrainedDOFs();
-	    			const ID&retainedDOFs = mpPtr->getRetainedDOFs();
-	    			for (int i=0; i<constrainedDOFs.Size(); i++) {
-	    				int dofC = constrainedDOFs(i);
-	    				int dofR = retainedDOFs(i);
-	    				int dofID = retainedDOFIDs(dofR);
-	    				dofPtr->setID(dofC, dofID);
-	    			}
-	    		}
+		int numMPs = theIndex.getNumMPs(nodeID);
+		MP_Constraint *const *mps = theIndex.getMPs(nodeID);
+		for (int k=0; k<numMPs; k++) {
+			// note there may be multiple constraints on a node -- can't assume intelli user
+			MP_Constraint *mpPtr = mps[k];
+			int nodeRetained = mpPtr->getNodeRetained();
+			Node *nodeRetainedPtr = theDomain->getNode(nodeRetained);
+			DOF_Group *retainedDOF = nodeRetainedPtr->getDOF_GroupPtr();
+			const ID&retainedDOFIDs = retainedDOF->getID();
+			const ID&constrainedDOFs = mpPtr->getConstrainedDOFs();
+			const ID&retainedDOFs = mpPtr->getRetainedDOFs();
+			for (int i=0; i<constrainedDOFs.Size(); i++) {
+				int dofC = constrainedDOFs(i);
+				int dofR = retainedDOFs(i);
+				int dofID = retainedDOFIDs(dofR);
+				dofPtr->setID(dofC, dofID);
+			}
 		}		
 	}	
     }
@@ -301,6 +301,7 @@ DOF_Numberer::numberDOF(ID &lastDOFs)
 
     // iterate through the DOFs one last time setting any -4 values
     // iterate through  the DOFs second time setting -3 values
+    const NodeConstraintIndex &theIndex = theAnalysisModel->getNodeConstraintIndex();
     DOF_GrpIter &tDOFs = theAnalysisModel->getDOFs();
     DOF_Group *dofPtr;
     while ((dofPtr = tDOFs()) != 0) {
@@ -314,25 +315,23 @@ DOF_Numberer::numberDOF(ID &lastDOFs)
 		// loop through the MP_Constraints to see if any of the
 		// DOFs are constrained, note constraint matrix must be diagonal
 		// with 1's on the diagonal
-		MP_ConstraintIter &theMPs = theDomain->getMPs();
-		MP_Constraint *mpPtr;
-		while ((mpPtr = theMPs()) != 0 ) {
-			// note keep looping over all in case multiple constraints
-			// are used to constrain a node -- can't assume intelli user
-	    		if (mpPtr->getNodeConstrained() == nodeID) {
-	    			int nodeRetained = mpPtr->getNodeRetained();
-	    			Node *nodeRetainedPtr = theDomain->getNode(nodeRetained);
-	    			DOF_Group *retainedDOF = nodeRetainedPtr->getDOF_GroupPtr();
-	    			const ID&retainedDOFIDs = retainedDOF->getID();
-	    			const ID&constrainedDOFs = mpPtr->getConstrainedDOFs();
-	    			const ID&retainedDOFs = mpPtr->getRetainedDOFs();
-	    			for (int i=0; i<constrainedDOFs.Size(); i++) {
-	    				int dofC = constrainedDOFs(i);
-	    				int dofR = retainedDOFs(i);
-	    				int dofID = retainedDOFIDs(dofR);
-	    				dofPtr->setID(dofC, dofID);
-	    			}
-	    		}
+		int numMPs = theIndex.getNumMPs(nodeID);
+		MP_Constraint *const *mps = theIndex.getMPs(nodeID);
+		for (int k=0; k<numMPs; k++) {
+			// note there may be multiple constraints on a node -- can't assume intelli user
+			MP_Constraint *mpPtr = mps[k];
+			int nodeRetained = mpPtr->getNodeRetained();
+			Node *nodeRetainedPtr = theDomain->getNode(nodeRetained);
+			DOF_Group *retainedDOF = nodeRetainedPtr->getDOF_GroupPtr();
+			const ID&retainedDOFIDs = retainedDOF->getID();
+			const ID&constrainedDOFs = mpPtr->getConstrainedDOFs();
+			const ID&retainedDOFs = mpPtr->getRetainedDOFs();
+			for (int i=0; i<constrainedDOFs.Size(); i++) {
+				int dofC = constrainedDOFs(i);
+				int dofR = retainedDOFs(i);
+				int dofID = retainedDOFIDs(dofR);
+				dofPtr->setID(dofC, dofID);
+			}
 		}		
 	}	
     }
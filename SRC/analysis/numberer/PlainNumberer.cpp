@@ -52,6 +52,7 @@
 #include <MP_Constraint.h>
 #include <Node.h>
 #include <MP_ConstraintIter.h>
+#include <NodeConstraintIndex.h>
 
 void* OPS_PlainNumberer()
 {
@@ -115,6 +116,7 @@ PlainNumberer::numberDOF(int lastDOF)
     }
 
     // iterate through the DOFs one last time setting any -4 values
+    const NodeConstraintIndex &theIndex = theModel->getNodeConstraintIndex();
     DOF_GrpIter &tDOFs = theModel->getDOFs();
     while ((dofPtr = tDOFs()) != 0) {
     	const ID &theID = dofPtr->getID();
@@ -127,25 +129,23 @@ PlainNumberer::numberDOF(int lastDOF)
 		// loop through the MP_Constraints to see if any of the
 		// DOFs are constrained, note constraint matrix must be diagonal
 		// with 1's on the diagonal
-		MP_ConstraintIter &theMPs = theDomain->getMPs();
-		MP_Constraint *mpPtr;
-		while ((mpPtr = theMPs()) != 0 ) {
-			// note keep looping over all in case multiple constraints
-			// are used to constrain a node -- can't assume intelli user
-	    		if (mpPtr->getNodeConstrained() == nodeID) {
-	    			int nodeRetained = mpPtr->getNodeRetained();
-	    			Node *nodeRetainedPtr = theDomain->getNode(nodeRetained);
-	    			DOF_Group *retainedDOF = nodeRetainedPtr->getDOF_GroupPtr();
-	    			const ID&retainedDOFIDs = retainedDOF->getID();
-	    			const ID&constrainedDOFs = mpPtr->getConstrainedDOFs();
-	    			const ID&retainedDOFs = mpPtr->getRetainedDOFs();
-	    			for (int i=0; i<constrainedDOFs.Size(); i++) {
-	    				int dofC = constrainedDOFs(i);
-	    				int dofR = retainedDOFs(i);
-	    				int dofID = retainedDOFIDs(dofR);
-	    				dofPtr->setID(dofC, dofID);
-	    			}
-	    		}
+		int numMPs = theIndex.getNumMPs(nodeID);
+		MP_Constraint *const *mps = theIndex.getMPs(nodeID);
+		for (int k=0; k<numMPs; k++) {
+			// note there may be multiple constraints on a node -- can't assume intelli user
+			MP_Constraint *mpPtr = mps[k];
+			int nodeRetained = mpPtr->getNodeRetained();
+			Node *nodeRetainedPtr = theDomain->getNode(nodeRetained);
+			DOF_Group *retainedDOF = nodeRetainedPtr->getDOF_GroupPtr();
+			const ID&retainedDOFIDs = retainedDOF->getID();
+			const ID&constrainedDOFs = mpPtr->getConstrainedDOFs();
+			const ID&retainedDOFs = mpPtr->getRetainedDOFs();
+			for (int i=0; i<constrainedDOFs.Size(); i++) {
+				int dofC = constrainedDOFs(i);
+				int dofR = retainedDOFs(i);
+				int dofID = retainedDOFIDs(dofR);
+				dofPtr->setID(dofC, dofID);
+			}
 		}		
 	}	
     }
@@ -220,6 +220,7 @@ PlainNumberer::numberDOF(ID &lastDOFs)
     }
     // iterate through the DOFs one last time setting any -4 values
     // iterate through the DOFs one last time setting any -4 values
+    const NodeConstraintIndex &theIndex = theModel->getNodeConstraintIndex();
     DOF_GrpIter &tDOFs = theModel->getDOFs();
     while ((dofPtr = tDOFs()) != 0) {
     	const ID &theID = dofPtr->getID();
@@ -232,25 +233,23 @@ PlainNumberer::numberDOF(ID &lastDOFs)
 		// loop through the MP_Constraints to see if any of the
 		// DOFs are constrained, note constraint matrix must be diagonal
 		// with 1's on the diagonal
-		MP_ConstraintIter &theMPs = theDomain->getMPs();
-		MP_Constraint *mpPtr;
-		while ((mpPtr = theMPs()) != 0 ) {
-			// note keep looping over all in case multiple constraints
-			// are used to constrain a node -- can't assume intelli user
-	    		if (mpPtr->getNodeConstrained() == nodeID) {
-	    			int nodeRetained = mpPtr->getNodeRetained();
-	    			Node *nodeRetainedPtr = theDomain->getNode(nodeRetained);
-	    			DOF_Group *retainedDOF = nodeRetainedPtr->getDOF_GroupPtr();
-	    			const ID&retainedDOFIDs = retainedDOF->getID();
-	    			const ID&constrainedDOFs = mpPtr->getConstrainedDOFs();
-	    			const ID&retainedDOFs = mpPtr->getRetainedDOFs();
-	    			for (int i=0; i<constrainedDOFs.Size(); i++) {
-	    				int dofC = constrainedDOFs(i);
-	    				int dofR = retainedDOFs(i);
-	    				int dofID = retainedDOFIDs(dofR);
-	    				dofPtr->setID(dofC, dofID);
-	    			}
-	    		}
+		int numMPs = theIndex.getNumMPs(nodeID);
+		MP_Constraint *const *mps = theIndex.getMPs(nodeID);
+		for (int k=0; k<numMPs; k++) {
+			// note there may be multiple constraints on a node -- can't assume intelli user
+			MP_Constraint *mpPtr = mps[k];
+			int nodeRetained = mpPtr->getNodeRetained();
+			Node *nodeRetainedPtr = theDomain->getNode(nodeRetained);
+			DOF_Group *retainedDOF = nodeRetainedPtr->getDOF_GroupPtr();
+			const ID&retainedDOFIDs = retainedDOF->getID();
+			const ID&constrainedDOFs = mpPtr->getConstrainedDOFs();
+			const ID&retainedDOFs = mpPtr->getRetainedDOFs();
+			for (int i=0; i<constrainedDOFs.Size(); i++) {
+				int dofC = constrainedDOFs(i);
+				int dofR = retainedDOFs(i);
+				int dofID = retainedDOFIDs(dofR);
+				dofPtr->setID(dofC, dofID);
+			}
 		}		
 	}	
     }
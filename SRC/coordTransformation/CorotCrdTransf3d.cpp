@@ -42,20 +42,29 @@
 #include <string>
 #include <CorotCrdTransf3d.h>
 
-// initialize static variables
-Matrix CorotCrdTransf3d::RI(3,3); 
-Matrix CorotCrdTransf3d::RJ(3,3); 
-Matrix CorotCrdTransf3d::Rbar(3,3); 
-Matrix CorotCrdTransf3d::e(3,3); 
-Matrix CorotCrdTransf3d::Tp(6,7); 
-Matrix CorotCrdTransf3d::T(7,12);
-Matrix CorotCrdTransf3d::Tlg(12,12);
-Matrix CorotCrdTransf3d::TlgInv(12, 12);
-Matrix CorotCrdTransf3d::Tbl(6,12);
-Matrix CorotCrdTransf3d::kg(12,12);
-Matrix CorotCrdTransf3d::Lr2(12,3);
-Matrix CorotCrdTransf3d::Lr3(12,3);
-Matrix CorotCrdTransf3d::A(3,3);
+// Permutation matrix (to renumber basic dof's), held by column
+//
+//       0 1  2 3 4  5 6  
+//
+// Tp=  [0 0  0 0 0  0 1;  0
+//       0 1  0 0 0  0 0;  1            
+//       0 0  0 0 1  0 0;  2
+//       0 0 -1 0 0  0 0;  3
+//       0 0  0 0 0 -1 0;  4
+//      -1 0  0 1 0  0 0]; 5 
+const MatrixND<6,7> CorotCrdTransf3d::Tp {{
+    { 0, 0, 0, 0, 0,-1},
+    { 0, 1, 0, 0, 0, 0},
+    { 0, 0, 0,-1, 0, 0},
+    { 0, 0, 0, 0, 0, 1},
+    { 0, 0, 1, 0, 0, 0},
+    { 0, 0, 0, 0,-1, 0},
+    { 1, 0, 0, 0, 0, 0}
+}};
+
+// the global stiffness matrix handed back to the element, one for each
+// thread
+thread_local Matrix CorotCrdTransf3d::kg(12,12);
 
 void* OPS_CorotCrdTransf3d()
 {
@@ -95,11 +104,13 @@ CorotCrdTransf3d::CorotCrdTransf3d(int tag, const Vector &vecInLocXZPlane,
                                    const Vector &rigJntOffsetI,
                                    const Vector &rigJntOffsetJ):
 CrdTransf(tag, CRDTR_TAG_CorotCrdTransf3d),
+nodeIPtr(0), nodeJPtr(0),
 vAxis(3), nodeIOffset(3), nodeJOffset(3), xAxis(3),
-nodeIPtr(0), nodeJPtr(0), R0(3,3), L(0), Ln(0), 
-alphaIq(4), alphaJq(4), 
-alphaIqcommit(4), alphaJqcommit(4), alphaI(3), alphaJ(3),
-ulcommit(7), ul(7),  ulpr(7),
+L(0), Ln(0), R0{}, 
+alphaIq{}, alphaJq{}, 
+alphaIqcommit{}, alphaJqcommit{}, alphaI{}, alphaJ{},
+ul{}, ulcommit{}, ulpr{},
+RI{}, RJ{}, Rbar{}, e{}, T{}, Lr2{}, Lr3{}, A{},
 nodeIInitialDisp(0), nodeJInitialDisp(0), initialDispChecked(false)
 {
     // check vector that defines local xz plane
@@ -143,33 +154,6 @@ nodeIInitialDisp(0), nodeJInitialDisp(0), initialDispChecked(false)
         nodeIOffset.Zero();
         nodeJOffset.Zero();
     }
-    
-    // Permutation matrix (to renumber basic dof's)
-    
-    //       0 1  2 3 4  5 6  
-    //
-    // Tp=  [0 0  0 0 0  0 1;  0
-    //       0 1  0 0 0  0 0;  1            
-    //       0 0  0 0 1  0 0;  2
-    //       0 0 -1 0 0  0 0;  3
-    //       0 0  0 0 0 -1 0;  4
-    //      -1 0  0 1 0  0 0]; 5 
-    
-    // using static matrix (one constant matrix for all objects)
-    
-    if (Tp(0, 6) == 0)  // initialize only once
-    {
-        Tp(0, 6) =  1;
-        Tp(1, 1) =  1;
-        Tp(2, 4) =  1;
-        Tp(3, 2) = -1;
-        Tp(4, 5) = -1;
-        Tp(5, 0) = -1;
-        Tp(5, 3) =  1;
-    }
-    
-    //opserr << "Tp: " << Tp;
-    
 }  
 
 
@@ -177,38 +161,15 @@ nodeIInitialDisp(0), nodeJInitialDisp(0), initialDispChecked(false)
 // invoked by a FEM_ObjectBroker, recvSelf() needs to be invoked on this object.
 CorotCrdTransf3d::CorotCrdTransf3d():
 CrdTransf(0, CRDTR_TAG_CorotCrdTransf3d),
+nodeIPtr(0), nodeJPtr(0),
 vAxis(3), nodeIOffset(3), nodeJOffset(3), xAxis(3),
-nodeIPtr(0), nodeJPtr(0), R0(3,3), L(0), Ln(0), 
-alphaIq(4), alphaJq(4), 
-alphaIqcommit(4), alphaJqcommit(4), alphaI(3), alphaJ(3),
-ulcommit(7), ul(7),  ulpr(7),
+L(0), Ln(0), R0{}, 
+alphaIq{}, alphaJq{}, 
+alphaIqcommit{}, alphaJqcommit{}, alphaI{}, alphaJ{},
+ul{}, ulcommit{}, ulpr{},
+RI{}, RJ{}, Rbar{}, e{}, T{}, Lr2{}, Lr3{}, A{},
 nodeIInitialDisp(0), nodeJInitialDisp(0), initialDispChecked(false)
 {
-    // Permutation matrix (to renumber basic dof's)
-    
-    //       0 1  2 3 4  5 6  
-    //
-    // Tp=  [0 0  0 0 0  0 1;  0
-    //       0 1  0 0 0  0 0;  1            
-    //       0 0  0 0 1  0 0;  2
-    //       0 0 -1 0 0  0 0;  3
-    //       0 0  0 0 0 -1 0;  4
-    //      -1 0  0 1 0  0 0]; 5 
-    
-    // using static matrix (one constant matrix for all objects)
-    
-    if (Tp(0, 6) == 0)  // initialize only once
-    {
-        Tp(0, 6) =  1;
-        Tp(1, 1) =  1;
-        Tp(2, 4) =  1;
-        Tp(3, 2) = -1;
-        Tp(4, 5) = -1;
-        Tp(5, 0) = -1;
-	Tp(5, 3) =  1;
-    }
-    
-    //opserr << "Tp: " << Tp;
 }
 
 
@@ -317,12 +278,8 @@ CorotCrdTransf3d::initialize(Node *nodeIPointer, Node *nodeJPointer)
 	initialDispChecked = true;
     }
     
-    static Vector XAxis(3);
-    static Vector YAxis(3);
-    static Vector ZAxis(3);
-    
     // get 3by3 rotation matrix
-    if ((error = this->getLocalAxes(XAxis, YAxis, ZAxis)))
+    if ((error = this->computeLocalAxes()))
       return error;
     
     // compute initial pseudo-vectors for nodal triads
@@ -370,8 +327,8 @@ CorotCrdTransf3d::update(void)
     **************************************************************/
     
     // determine global displacement increments from last iteration
-    static Vector dispI(6);
-    static Vector dispJ(6);
+    VectorND<6> dispI;
+    VectorND<6> dispJ;
     dispI = nodeIPtr->getTrialDisp();
     dispJ = nodeJPtr->getTrialDisp();
     
@@ -388,8 +345,8 @@ CorotCrdTransf3d::update(void)
     // get the iterative spins dAlphaI and dAlphaJ 
     // (rotational displacement increments at both nodes)
     
-    static Vector dAlphaI(3);
-    static Vector dAlphaJ(3);
+    VectorND<3> dAlphaI;
+    VectorND<3> dAlphaJ;
     
     for (k = 0; k < 3; k++) {
         dAlphaI(k) = dispI(k+3) - alphaI(k);
@@ -401,8 +358,8 @@ CorotCrdTransf3d::update(void)
     /************** END OF REPLACEMENT **************************/
     
     // update the nodal triads TI and RJ using quaternions
-    static Vector dAlphaIq(4);
-    static Vector dAlphaJq(4);
+    VectorND<4> dAlphaIq;
+    VectorND<4> dAlphaJq;
 
     dAlphaIq = this->getQuaternionFromPseudoRotVector (dAlphaI);
     dAlphaJq = this->getQuaternionFromPseudoRotVector (dAlphaJ);
@@ -414,9 +371,9 @@ CorotCrdTransf3d::update(void)
     RJ = this->getRotationMatrixFromQuaternion (alphaJq);
 
     // compute the mean nodal triad
-    static Matrix dRgamma(3,3); 
-    static Vector gammaq(4);
-    static Vector gammaw(3);
+    MatrixND<3,3> dRgamma; 
+    VectorND<4> gammaq;
+    VectorND<3> gammaw;
     
     dRgamma.Zero();
     
@@ -438,18 +395,21 @@ CorotCrdTransf3d::update(void)
             Rbar.addMatrixProduct(0.0, dRgamma, RI, 1.0);
             
             // compute the base vectors e1, e2, e3
-            static Vector e1(3);
-            static Vector e2(3);
-            static Vector e3(3);
+            VectorND<3> e1;
+            VectorND<3> e2;
+            VectorND<3> e3;
             
             // relative translation displacements
-            static Vector dJI(3);    
+            VectorND<3> dJI;    
             for (int kk = 0; kk < 3; kk++)
                 dJI(kk) = dispJ(kk) - dispI(kk);
             
             // element projection
-            static Vector xJI(3);
-            xJI = nodeJPtr->getCrds() - nodeIPtr->getCrds();
+            VectorND<3> xJI;
+            const Vector &crdI = nodeIPtr->getCrds();
+            const Vector &crdJ = nodeJPtr->getCrds();
+            for (int kk = 0; kk < 3; kk++)
+                xJI(kk) = crdJ(kk) - crdI(kk);
             
             if (nodeIInitialDisp != 0) {
                 xJI(0) -= nodeIInitialDisp[0];
@@ -463,7 +423,7 @@ CorotCrdTransf3d::update(void)
                 xJI(2) += nodeJInitialDisp[2];
             }
             
-            static Vector dx(3);
+            VectorND<3> dx;
             // dx = xJI + dJI;  
             dx = xJI;
             dx.addVector (1.0, dJI, 1.0);
@@ -483,9 +443,9 @@ CorotCrdTransf3d::update(void)
             
             // 'rotate' the mean rotation matrix Rbar on to e1 to 
             // obtain e2 and e3 (using the 'mid-point' procedure)
-            static Vector r1(3);
-            static Vector r2(3);
-            static Vector r3(3);
+            VectorND<3> r1;
+            VectorND<3> r2;
+            VectorND<3> r3;
             
             for (k = 0; k < 3; k ++)
             {
@@ -497,7 +457,7 @@ CorotCrdTransf3d::update(void)
             //    e2 = r2 - (e1 + r1)*((r2^ e1)*0.5);
             // e3 = r3 - (e1 + r1)*((r3^ e1)*0.5);
             
-            static Vector tmp(3);
+            VectorND<3> tmp;
             tmp = e1;
             tmp += r1;
             
@@ -513,8 +473,8 @@ CorotCrdTransf3d::update(void)
             e3.addVector(-1.0,  r3, 1.0);
             
             // compute the basic rotations
-            static Vector rI1(3), rI2(3), rI3(3);
-            static Vector rJ1(3), rJ2(3), rJ3(3);
+            VectorND<3> rI1, rI2, rI3;
+            VectorND<3> rJ1, rJ2, rJ3;
             
             for (k = 0; k < 3; k ++)
             {
@@ -559,10 +519,10 @@ CorotCrdTransf3d::compTransfMatrixBasicGlobal(void)
     int i, j, k;
     
     //opserr << "comprTransfMatrixBasicGlobal: *****************************\n";
-    static Vector r1(3), r2(3), r3(3);
-    static Vector e1(3), e2(3), e3(3);
-    static Vector rI1(3), rI2(3), rI3(3);
-    static Vector rJ1(3), rJ2(3), rJ3(3);
+    VectorND<3> r1, r2, r3;
+    VectorND<3> e1, e2, e3;
+    VectorND<3> rI1, rI2, rI3;
+    VectorND<3> rJ1, rJ2, rJ3;
     
     for (k = 0; k < 3; k ++)
     {
@@ -585,7 +545,7 @@ CorotCrdTransf3d::compTransfMatrixBasicGlobal(void)
     
     // compute the transformation matrix from the basic to the
     // global system
-    static Matrix I(3,3);
+    MatrixND<3,3> I {};
     
     //   A = (1/Ln)*(I - e1*e1');
     for (i = 0; i < 3; i++)
@@ -598,8 +558,8 @@ CorotCrdTransf3d::compTransfMatrixBasicGlobal(void)
         Lr2 = this->getLMatrix (r2);
         Lr3 = this->getLMatrix (r3);
         
-        static Matrix Sr1(3,3), Sr2(3,3), Sr3(3,3);
-        static Vector Se(3), At(3);
+        MatrixND<3,3> Sr1, Sr2, Sr3;
+        VectorND<3> Se, At;
         
         //   T1 = [      O', (-S(rI3)*e2 + S(rI2)*e3)',        O', O']';
         //   T2 = [(A*rI2)', (-S(rI2)*e1 + S(rI1)*e2)', -(A*rI2)', O']';
@@ -692,7 +652,7 @@ CorotCrdTransf3d::compTransfMatrixBasicGlobal(void)
         }
         
         // setup transformation matrix
-        static Vector Lr(12);
+        VectorND<12> Lr;
         
         // T(:,1) += Lr3*rI2 - Lr2*rI3;
         // T(:,2) +=           Lr2*rI1;
@@ -759,10 +719,10 @@ CorotCrdTransf3d::compTransfMatrixBasicGlobalNew(void)
     int i, j, k;
     
     //opserr << "comprTransfMatrixBasicGlobal: *****************************\n";
-    static Vector r1(3), r2(3), r3(3);
-    static Vector e1(3), e2(3), e3(3);
-    static Vector rI1(3), rI2(3), rI3(3);
-    static Vector rJ1(3), rJ2(3), rJ3(3);
+    VectorND<3> r1, r2, r3;
+    VectorND<3> e1, e2, e3;
+    VectorND<3> rI1, rI2, rI3;
+    VectorND<3> rJ1, rJ2, rJ3;
     
     for (k = 0; k < 3; k ++)
     {
@@ -785,7 +745,7 @@ CorotCrdTransf3d::compTransfMatrixBasicGlobalNew(void)
     
     // compute the transformation matrix from the basic to the
     // global system
-    static Matrix I(3,3);
+    MatrixND<3,3> I {};
     
     //   A = (1/Ln)*(I - e1*e1');
     for (i = 0; i < 3; i++)
@@ -818,8 +778,8 @@ CorotCrdTransf3d::compTransfMatrixBasicGlobalNew(void)
         // opserr << "Lr2: " << Lr2;
         // opserr << "Lr3: " << Lr3;
         
-        static Matrix Sr1(3,3), Sr2(3,3), Sr3(3,3);
-        static Vector Se(3), At(3);
+        MatrixND<3,3> Sr1, Sr2, Sr3;
+        VectorND<3> Se, At;
         
         
         // O = zeros(3,1);
@@ -830,12 +790,12 @@ CorotCrdTransf3d::compTransfMatrixBasicGlobalNew(void)
         // hJ2 = [(A*rJ3)', O', -(A*rJ3)', (-S(rJ3)*e1 + S(rJ1)*e3)']';
         // hJ3 = [(A*rJ2)', O', -(A*rJ2)', (-S(rJ2)*e1 + S(rJ1)*e2)']';
         
-        static Vector hI1(12);
-        static Vector hI2(12);
-        static Vector hI3(12);
-        static Vector hJ1(12);
-        static Vector hJ2(12);
-        static Vector hJ3(12);
+        VectorND<12> hI1 {};
+        VectorND<12> hI2 {};
+        VectorND<12> hI3 {};
+        VectorND<12> hJ1 {};
+        VectorND<12> hJ2 {};
+        VectorND<12> hJ3 {};
         
         Sr1 = this->getSkewSymMatrix(rI1);
         Sr2 = this->getSkewSymMatrix(rI2);
@@ -928,7 +888,7 @@ CorotCrdTransf3d::compTransfMatrixBasicGlobalNew(void)
         
         // T = F'
         T.Zero();
-        static Vector Lr(12);
+        VectorND<12> Lr;
         
         // f1 =  [-e1' O' e1' O'];
         for (i=0; i<3; i++) {
@@ -936,8 +896,8 @@ CorotCrdTransf3d::compTransfMatrixBasicGlobalNew(void)
             T(i+3,0) = e1(i);
         }
         
-        static Vector thetaI(3);
-        static Vector thetaJ(3);
+        VectorND<3> thetaI;
+        VectorND<3> thetaJ;
         
         
         thetaI(0) = ul(0);
@@ -1001,7 +961,7 @@ CorotCrdTransf3d::compTransfMatrixBasicGlobalNew(void)
 
 
 void
-CorotCrdTransf3d::compTransfMatrixLocalGlobal(Matrix &Tlg) 
+CorotCrdTransf3d::compTransfMatrixLocalGlobal(MatrixND<12,12> &Tlg) 
 {
     // setup transformation matrix from local to global
     Tlg.Zero();
@@ -1019,16 +979,17 @@ CorotCrdTransf3d::compTransfMatrixLocalGlobal(Matrix &Tlg)
 
 
 void
-CorotCrdTransf3d::compTransfMatrixBasicLocal(Matrix &Tbl)
+CorotCrdTransf3d::compTransfMatrixBasicLocal(MatrixND<6,12> &Tbl)
 {
     // setup transformation matrix from basic to local
     Tbl.Zero();
 
     // first get transformation matrix from basic to global 
-    static Matrix Tbg(6, 12);
+    MatrixND<6,12> Tbg;
     Tbg.addMatrixProduct(0.0, Tp, T, 1.0);
 
     // get inverse of transformation matrix from local to global
+    MatrixND<12,12> Tlg, TlgInv;
     this->compTransfMatrixLocalGlobal(Tlg);
     // Tlg.Invert(TlgInv);
     TlgInv.addMatrixTranspose(0.0, Tlg, 1.0);  // for square rot-matrix: Tlg^-1 = Tlg'
@@ -1041,7 +1002,7 @@ CorotCrdTransf3d::compTransfMatrixBasicLocal(Matrix &Tbl)
 const Vector &
 CorotCrdTransf3d::getBasicTrialDisp(void)
 {
-    static Vector ub(6);
+    static thread_local Vector ub(6);
     
     // use transformation matrix to renumber the degrees of freedom
     ub.addMatrixVector(0.0, Tp, ul, 1.0);
@@ -1053,8 +1014,8 @@ CorotCrdTransf3d::getBasicTrialDisp(void)
 const Vector &
 CorotCrdTransf3d::getBasicIncrDeltaDisp(void)
 {
-    static Vector dub(6);
-    static Vector dul(7);
+    static thread_local Vector dub(6);
+    VectorND<7> dul;
     
     // dul = ul - ulpr;
     dul = ul;
@@ -1070,8 +1031,8 @@ CorotCrdTransf3d::getBasicIncrDeltaDisp(void)
 const Vector &
 CorotCrdTransf3d::getBasicIncrDisp(void)
 {
-    static Vector Dub(6);
-    static Vector Dul(7);
+    static thread_local Vector Dub(6);
+    VectorND<7> Dul;
     
     // Dul = ul - ulcommit;
     Dul = ul;
@@ -1111,14 +1072,16 @@ CorotCrdTransf3d::getGlobalResistingForce(const Vector &pb, const Vector &p0)
 {
     this->update();
     
-    static Vector pg(12);
-    pg.Zero();
+    static thread_local Vector pg(12);
+
+    VectorND<6> qb;
+    qb = pb;
     
     // if there are no element loads present
     if (p0 == 0.0) {
         // transform resisting forces from the basic system to local coordinates
-        static Vector pl(7);
-        pl.addMatrixTransposeVector(0.0, Tp, pb, 1.0);    // pl = Tp ^ pb;
+        VectorND<7> pl;
+        pl.addMatrixTransposeVector(0.0, Tp, qb, 1.0);    // pl = Tp ^ pb;
 
         // transform resisting forces from local to global coordinates
         pg.addMatrixTransposeVector(0.0, T, pl, 1.0);   // pg = T ^ pl; residual
@@ -1147,24 +1110,25 @@ CorotCrdTransf3d::getGlobalResistingForce(const Vector &pb, const Vector &p0)
         // FASTER!!!! TRANSFORM REACTIONS AND ADD AT END
         // =============================================
         // transform resisting forces from the basic system to local coordinates
-        static Vector pl(7);
-        pl.addMatrixTransposeVector(0.0, Tp, pb, 1.0);    // pl = Tp ^ pb;
+        VectorND<7> pl;
+        pl.addMatrixTransposeVector(0.0, Tp, qb, 1.0);    // pl = Tp ^ pb;
 
         // transform resisting forces from local to global coordinates
-        pg.addMatrixTransposeVector(0.0, T, pl, 1.0);   // pg = T ^ pl; residual
+        VectorND<12> pgl;
+        pgl.addMatrixTransposeVector(0.0, T, pl, 1.0);   // pg = T ^ pl; residual
 
         // add end forces due to element p0 loads
         // assuming member loads are in local system
-        static Vector pl0(12), pg0(12);
-        pl0.Zero();
+        VectorND<12> pl0 {};
         pl0(0) = p0(0);
         pl0(1) = p0(1);
         pl0(7) = p0(2);
         pl0(2) = p0(3);
         pl0(8) = p0(4);
+        MatrixND<12,12> Tlg;
         this->compTransfMatrixLocalGlobal(Tlg);
-        pg0.addMatrixTransposeVector(0.0, Tlg, pl0, 1.0);
-        pg.addVector(1.0, pg0, 1.0);
+        pgl.addMatrixTransposeVector(1.0, Tlg, pl0, 1.0);
+        pg = pgl;
     }
     
     return pg;
@@ -1178,32 +1142,36 @@ CorotCrdTransf3d::getGlobalStiffMatrix(const Matrix &kb, const Vector &pb)
     
     int i, j, k;   
     // transform tangent stiffness matrix from the basic system to local coordinates
-    static Matrix kl(7,7);
-    kl.addMatrixTripleProduct(0.0, Tp, kb, 1.0);      // kl = Tp ^ kb * Tp;
+    MatrixND<6,6> kbnd;
+    kbnd = kb;
+    MatrixND<7,7> kl;
+    kl.addMatrixTripleProduct(0.0, Tp, kbnd, 1.0);      // kl = Tp ^ kb * Tp;
 
     //    opserr << "kb: " << kb;
     //    opserr << "Tp: " << Tp;
     
     // transform resisting forces from the basic system to local coordinates
-    static Vector pl(7);
-    pl.addMatrixTransposeVector(0.0, Tp, pb, 1.0);    // pl = Tp ^ pb;
+    VectorND<6> qb;
+    qb = pb;
+    VectorND<7> pl;
+    pl.addMatrixTransposeVector(0.0, Tp, qb, 1.0);    // pl = Tp ^ pb;
     
     // transform tangent  stiffness matrix from local to global coordinates
-    //static Matrix kg(12,12);
+    MatrixND<12,12> kt;
     
     // compute the tangent stiffness matrix in global coordinates
-    kg.addMatrixTripleProduct(0.0, T, kl, 1.0);
+    kt.addMatrixTripleProduct(0.0, T, kl, 1.0);
     
-    static Vector m(6);
+    VectorND<6> m;
     for (i = 0; i < 6; i++)
         m(i) = pl(i)/(2*cos(ul(i)));
     
     // compute the basic rotations
     
-    static Vector e1(3), e2(3), e3(3);
-    static Vector r1(3), r2(3), r3(3);
-    static Vector rI1(3), rI2(3), rI3(3);
-    static Vector rJ1(3), rJ2(3), rJ3(3);
+    VectorND<3> e1, e2, e3;
+    VectorND<3> r1, r2, r3;
+    VectorND<3> rI1, rI2, rI3;
+    VectorND<3> rJ1, rJ2, rJ3;
     
     for (k = 0; k < 3; k ++)
     {
@@ -1230,9 +1198,9 @@ CorotCrdTransf3d::getGlobalStiffMatrix(const Matrix &kb, const Vector &pb)
     //        m(5)*ks2r2u1 + m(6)*ks2r3u1 + ...
     //        ks3 + ks3' + ks4 + ks5;
     
-    static Matrix Se1(3,3), Se2(3,3), Se3(3,3);
-    static Matrix SrI1(3,3), SrI2(3,3), SrI3(3,3);
-    static Matrix SrJ1(3,3), SrJ2(3,3), SrJ3(3,3);
+    MatrixND<3,3> Se1, Se2, Se3;
+    MatrixND<3,3> SrI1, SrI2, SrI3;
+    MatrixND<3,3> SrJ1, SrJ2, SrJ3;
     
     Se1 = this->getSkewSymMatrix(e1);
     Se2 = this->getSkewSymMatrix(e2);
@@ -1256,10 +1224,10 @@ CorotCrdTransf3d::getGlobalStiffMatrix(const Matrix &kb, const Vector &pb)
     
     double factor;
     
-    kg.Assemble(A, 0, 0,  pl(6));
-    kg.Assemble(A, 0, 6, -pl(6));
-    kg.Assemble(A, 6, 0, -pl(6));
-    kg.Assemble(A, 6, 6,  pl(6));
+    kt.Assemble(A, 0, 0,  pl(6));
+    kt.Assemble(A, 0, 6, -pl(6));
+    kt.Assemble(A, 6, 0, -pl(6));
+    kt.Assemble(A, 6, 6,  pl(6));
     
     //opserr << "kg += ksigma1: " << kg;
     
@@ -1272,8 +1240,8 @@ CorotCrdTransf3d::getGlobalStiffMatrix(const Matrix &kb, const Vector &pb)
     
     //     ks3 = [o kbar2 o kbar4];
     
-    static Matrix Sm(3,3);
-    static Matrix kbar(12,3);
+    MatrixND<3,3> Sm;
+    MatrixND<12,3> kbar;
     
     Sm.addMatrix(0.0, SrI3,  m(3));
     Sm.addMatrix(1.0, SrI1,  m(1));
@@ -1285,8 +1253,8 @@ CorotCrdTransf3d::getGlobalStiffMatrix(const Matrix &kb, const Vector &pb)
     
     kbar.addMatrixProduct(1.0, Lr3, Sm,  1.0);
     
-    kg.Assemble(kbar, 0, 3, 1.0);
-    kg.AssembleTranspose(kbar, 3, 0, 1.0);
+    kt.Assemble(kbar, 0, 3, 1.0);
+    kt.AssembleTranspose(kbar, 3, 0, 1.0);
     
     Sm.addMatrix(0.0, SrJ3,  m(3));
     Sm.addMatrix(1.0, SrJ1, -m(4));
@@ -1298,8 +1266,8 @@ CorotCrdTransf3d::getGlobalStiffMatrix(const Matrix &kb, const Vector &pb)
     
     kbar.addMatrixProduct(1.0, Lr3, Sm,  -1.0);
     
-    kg.Assemble(kbar, 0, 9, 1.0);
-    kg.AssembleTranspose(kbar, 9, 0, 1.0);
+    kt.Assemble(kbar, 0, 9, 1.0);
+    kt.AssembleTranspose(kbar, 9, 0, 1.0);
     
     //opserr << "kg += ksigma3: " << kg;
     
@@ -1317,7 +1285,7 @@ CorotCrdTransf3d::getGlobalStiffMatrix(const Matrix &kb, const Vector &pb)
     //           O    O     O    O;
     //           O    O     O  Ks4_44];
     
-    static Matrix ks33(3,3);
+    MatrixND<3,3> ks33;
     
     ks33.addMatrixProduct(0.0, Se2, SrI3,  m(3));
     ks33.addMatrixProduct(1.0, Se3, SrI2, -m(3));
@@ -1328,7 +1296,7 @@ CorotCrdTransf3d::getGlobalStiffMatrix(const Matrix &kb, const Vector &pb)
     ks33.addMatrixProduct(1.0, Se3, SrI1,  m(2));
     ks33.addMatrixProduct(1.0, Se1, SrI3, -m(2));
     
-    kg.Assemble(ks33, 3, 3, 1.0);
+    kt.Assemble(ks33, 3, 3, 1.0);
     
     ks33.addMatrixProduct(0.0, Se2, SrJ3, -m(3));
     ks33.addMatrixProduct(1.0, Se3, SrJ2,  m(3));
@@ -1339,7 +1307,7 @@ CorotCrdTransf3d::getGlobalStiffMatrix(const Matrix &kb, const Vector &pb)
     ks33.addMatrixProduct(1.0, Se3, SrJ1,  m(5));
     ks33.addMatrixProduct(1.0, Se1, SrJ3, -m(5));
     
-    kg.Assemble(ks33, 9, 9, 1.0);
+    kt.Assemble(ks33, 9, 9, 1.0);
     
     //opserr << "kg += ksigma4: " << kg;
     
@@ -1351,7 +1319,7 @@ CorotCrdTransf3d::getGlobalStiffMatrix(const Matrix &kb, const Vector &pb)
     //          Ks5_14t     O   -Ks5_14t   O];
     
     // v = (1/Ln)*(m(2)*rI2 + m(3)*rI3 + m(5)*rJ2 + m(6)*rJ3);
-    static Vector v(3);
+    VectorND<3> v;
     v.addVector (0.0, rI2, m(1));
     v.addVector (1.0, rI3, m(2));
     v.addVector (1.0, rJ2, m(4));
@@ -1360,7 +1328,7 @@ CorotCrdTransf3d::getGlobalStiffMatrix(const Matrix &kb, const Vector &pb)
     v /= Ln;
     
     //Ks5_11 = A*v*e1' + e1*v'*A + (e1'*v)*A;
-    static Matrix m33(3,3);
+    MatrixND<3,3> m33;
     double  e1tv = 0;   // dot product e1. v
     
     for (i = 0; i < 3; i++)
@@ -1380,55 +1348,55 @@ CorotCrdTransf3d::getGlobalStiffMatrix(const Matrix &kb, const Vector &pb)
             
             ks33.addMatrixProduct (1.0, m33, A, 1.0);
             
-            kg.Assemble(ks33, 0, 0,  1.0);
-            kg.Assemble(ks33, 0, 6, -1.0);
-            kg.Assemble(ks33, 6, 0, -1.0);
-            kg.Assemble(ks33, 6, 6,  1.0);
+            kt.Assemble(ks33, 0, 0,  1.0);
+            kt.Assemble(ks33, 0, 6, -1.0);
+            kt.Assemble(ks33, 6, 0, -1.0);
+            kt.Assemble(ks33, 6, 6,  1.0);
             
             //Ks5_12 = -(m(2)*A*S(rI2) + m(3)*A*S(rI3));
             
             ks33.addMatrixProduct(0.0, A, SrI2, -m(1));
             ks33.addMatrixProduct(1.0, A, SrI3, -m(2));
             
-            kg.Assemble(ks33, 0, 3,  1.0);
-            kg.Assemble(ks33, 6, 3, -1.0);
+            kt.Assemble(ks33, 0, 3,  1.0);
+            kt.Assemble(ks33, 6, 3, -1.0);
             
-            kg.AssembleTranspose(ks33, 3, 0,  1.0);
-            kg.AssembleTranspose(ks33, 3, 6, -1.0);
+            kt.AssembleTranspose(ks33, 3, 0,  1.0);
+            kt.AssembleTranspose(ks33, 3, 6, -1.0);
             
             //  Ks5_14 = -(m(5)*A*S(rJ2) + m(6)*A*S(rJ3));
             
             ks33.addMatrixProduct(0.0, A, SrJ2, -m(4));
             ks33.addMatrixProduct(1.0, A, SrJ3, -m(5));
             
-            kg.Assemble(ks33, 0, 9,  1.0);
-            kg.Assemble(ks33, 6, 9, -1.0);
+            kt.Assemble(ks33, 0, 9,  1.0);
+            kt.Assemble(ks33, 6, 9, -1.0);
             
-            kg.AssembleTranspose(ks33, 9, 0,  1.0);
-            kg.AssembleTranspose(ks33, 9, 6, -1.0);
+            kt.AssembleTranspose(ks33, 9, 0,  1.0);
+            kt.AssembleTranspose(ks33, 9, 6, -1.0);
             
             //opserr << "kg += ksigma5: " << kg;
             
             // Ksigma -------------------------------
-            static Vector rm(3);
+            VectorND<3> rm;
             
             rm = rI3;
             rm.addVector (1.0, rJ3, -1.0); 
             //opserr << "ks2(r2,rI3-rJ3):\n "; 
-            kg.addMatrix (1.0, this->getKs2Matrix(r2, rm), m(3));
+            kt.addMatrix (1.0, this->getKs2Matrix(r2, rm), m(3));
             
             rm = rJ2;
             rm.addVector (1.0, rI2, -1.0); 
             //opserr << "ks2(r3,rJ2-rI2):\n "; 
-            kg.addMatrix (1.0, this->getKs2Matrix(r3, rm), m(3));
+            kt.addMatrix (1.0, this->getKs2Matrix(r3, rm), m(3));
             //opserr << "ks2(r2,rI1):\n "; 
-            kg.addMatrix (1.0, this->getKs2Matrix(r2, rI1), m(1));
+            kt.addMatrix (1.0, this->getKs2Matrix(r2, rI1), m(1));
             //opserr << "ks2(r3,rI1):\n "; 
-            kg.addMatrix (1.0, this->getKs2Matrix(r3, rI1), m(2));
+            kt.addMatrix (1.0, this->getKs2Matrix(r3, rI1), m(2));
             //opserr << "ks2(r2,rJ1):\n "; 
-            kg.addMatrix (1.0, this->getKs2Matrix(r2, rJ1), m(4));
+            kt.addMatrix (1.0, this->getKs2Matrix(r2, rJ1), m(4));
             //opserr << "ks2(r3,rJ1):\n "; 
-            kg.addMatrix (1.0, this->getKs2Matrix(r3, rJ1), m(5));
+            kt.addMatrix (1.0, this->getKs2Matrix(r3, rJ1), m(5));
             
             //opserr << "kg += ksigma2: " << kg;
             
@@ -1439,11 +1407,12 @@ CorotCrdTransf3d::getGlobalStiffMatrix(const Matrix &kb, const Vector &pb)
                 factor = pl(k) * tan(ul(k));
                 for (i = 0; i < 12; i++)
                     for (j = 0; j < 12; j++)
-                        kg(i,j) += T(k,i) * factor * T(k,j);
+                        kt(i,j) += T(k,i) * factor * T(k,j);
             }
             
 	    //            opserr << "COROATIONAL 3d: kg final: " << kg;
             
+            kg = kt;
             return kg;
 }
 
@@ -1452,27 +1421,33 @@ const Matrix &
 CorotCrdTransf3d::getInitialGlobalStiffMatrix(const Matrix &kb)
 {
     // transform tangent stiffness matrix from the basic system to local coordinates
-    static Matrix kl(7,7);
-    kl.addMatrixTripleProduct(0.0, Tp, kb, 1.0);      // kl = Tp ^ kb * Tp;
+    MatrixND<6,6> kbnd;
+    kbnd = kb;
+    MatrixND<7,7> kl;
+    kl.addMatrixTripleProduct(0.0, Tp, kbnd, 1.0);      // kl = Tp ^ kb * Tp;
     
     // transform tangent  stiffness matrix from local to global coordinates
-    //static Matrix kg(12,12);
+    MatrixND<12,12> kt;
     
     // compute the tangent stiffness matrix in global coordinates
-    kg.addMatrixTripleProduct(0.0, T, kl, 1.0);
+    kt.addMatrixTripleProduct(0.0, T, kl, 1.0);
     
+    kg = kt;
     return kg;
 }
 
 
 int 
-CorotCrdTransf3d::getLocalAxes(Vector &XAxis, Vector &YAxis, Vector &ZAxis)
+CorotCrdTransf3d::computeLocalAxes(void)
 {
     // element projection
     
-    static Vector dx(3);
+    VectorND<3> dx;
     
-    dx = (nodeJPtr->getCrds() + nodeJOffset) - (nodeIPtr->getCrds() + nodeIOffset);  
+    const Vector &crdI = nodeIPtr->getCrds();
+    const Vector &crdJ = nodeJPtr->getCrds();
+    for (int i = 0; i < 3; i++)
+        dx(i) = (crdJ(i) + nodeJOffset(i)) - (crdI(i) + nodeIOffset(i));  
     if (nodeIInitialDisp != 0) {
         dx(0) -= nodeIInitialDisp[0];
         dx(1) -= nodeIInitialDisp[1];
@@ -1498,12 +1473,11 @@ CorotCrdTransf3d::getLocalAxes(Vector &XAxis, Vector &YAxis, Vector &ZAxis)
     
     // calculate the element local x axis components (direction cossines)
     // wrt to the global coordinates 
-    xAxis = dx/L;
-    
-    XAxis(0) = xAxis(0);    XAxis(1) = xAxis(1);    XAxis(2) = xAxis(2);
+    for (int i = 0; i < 3; i++)
+        xAxis(i) = dx(i)/L;
     
     // calculate the cross-product y = v * x   
-    static Vector yAxis(3), zAxis(3);
+    VectorND<3> yAxis, zAxis;
     
     yAxis(0) = vAxis(1)*xAxis(2) - vAxis(2)*xAxis(1);
     yAxis(1) = vAxis(2)*xAxis(0) - vAxis(0)*xAxis(2);
@@ -1519,14 +1493,12 @@ CorotCrdTransf3d::getLocalAxes(Vector &XAxis, Vector &YAxis, Vector &ZAxis)
     }
     
     yAxis /= ynorm;
-    YAxis(0) = yAxis(0);    YAxis(1) = yAxis(1);    YAxis(2) = yAxis(2);
     
     // calculate the cross-product z = x * y 
     
     zAxis(0) = xAxis(1)*yAxis(2) - xAxis(2)*yAxis(1);
     zAxis(1) = xAxis(2)*yAxis(0) - xAxis(0)*yAxis(2);
     zAxis(2) = xAxis(0)*yAxis(1) - xAxis(1)*yAxis(0);
-    ZAxis(0) = zAxis(0);    ZAxis(1) = zAxis(1);    ZAxis(2) = zAxis(2);
     
     for (int i=0; i < 3; i++) {
         R0(i,0) = xAxis(i);
@@ -1537,6 +1509,23 @@ CorotCrdTransf3d::getLocalAxes(Vector &XAxis, Vector &YAxis, Vector &ZAxis)
     return 0;
 }
 
+
+int 
+CorotCrdTransf3d::getLocalAxes(Vector &XAxis, Vector &YAxis, Vector &ZAxis)
+{
+    int error;
+    if ((error = this->computeLocalAxes()))
+        return error;
+    
+    for (int i=0; i < 3; i++) {
+        XAxis(i) = R0(i,0);
+        YAxis(i) = R0(i,1);
+        ZAxis(i) = R0(i,2);
+    }
+    
+    return 0;
+}
+
 int
 CorotCrdTransf3d::getRigidOffsets(Vector &offsets)
 {
@@ -1564,14 +1553,14 @@ CorotCrdTransf3d::getDeformedLength(void)
 }
 
 
-const Vector &
-CorotCrdTransf3d::getQuaternionFromRotMatrix(const Matrix &R) const
+VectorND<4>
+CorotCrdTransf3d::getQuaternionFromRotMatrix(const MatrixND<3,3> &R) const
 {
     // obtains the normalised quaternion from the rotation matrix
     int i, j, k;
     double trR;              // trace of R
     double a    ;
-    static Vector q(4);      // normalized quaternion
+    VectorND<4> q {};      // normalized quaternion
     
     trR = R(0,0) + R(1,1) + R(2,2);    
     
@@ -1611,12 +1600,12 @@ CorotCrdTransf3d::getQuaternionFromRotMatrix(const Matrix &R) const
 }
 
 
-const Vector &
-CorotCrdTransf3d::getQuaternionFromPseudoRotVector(const Vector  &theta) const
+VectorND<4>
+CorotCrdTransf3d::getQuaternionFromPseudoRotVector(const VectorND<3> &theta) const
 {
     double t;                // norm of the pseudo rotation vector
     double factor;
-    static Vector q(4);      // normalized quaternion
+    VectorND<4> q;      // normalized quaternion
     
     t = theta.Norm();
     
@@ -1635,14 +1624,14 @@ CorotCrdTransf3d::getQuaternionFromPseudoRotVector(const Vector  &theta) const
 }
 
 
-const Vector &
-CorotCrdTransf3d::quaternionProduct(const Vector &q1, const Vector &q2) const
+VectorND<4>
+CorotCrdTransf3d::quaternionProduct(const VectorND<4> &q1, const VectorND<4> &q2) const
 {
     
-    static Vector q12(4);
+    VectorND<4> q12;
     int i;
     double q1Tq2= 0;  // dot product
-    static Vector q1xq2(3);     // cross product
+    VectorND<3> q1xq2;     // cross product
     
     // calculate the dot product q1.q2
     for (i = 0; i < 3; i++)       // NOTE i <3, not i<4
@@ -1663,15 +1652,14 @@ CorotCrdTransf3d::quaternionProduct(const Vector &q1, const Vector &q2) const
 }
 
 
-const Matrix &
-CorotCrdTransf3d::getRotationMatrixFromQuaternion(const Vector &q) const
+MatrixND<3,3>
+CorotCrdTransf3d::getRotationMatrixFromQuaternion(const VectorND<4> &q) const
 { 
     int i, j;
     double factor;
-    static Matrix I(3,3); // identity matrix
-    static Matrix qqT(3,3); 
-    static Matrix S(3,3);
-    static Matrix R(3,3);
+    MatrixND<3,3> qqT; 
+    MatrixND<3,3> S;
+    MatrixND<3,3> R;
     
     // R = (q0^2 - q' * q) * I + 2 * q * q' + 2*q0*S(q);
     
@@ -1683,7 +1671,7 @@ CorotCrdTransf3d::getRotationMatrixFromQuaternion(const Vector &q) const
             qqT(i,j) = q(i) * q(j);
         
         // get skew symmetric matrix	     
-        S = this->getSkewSymMatrix (q);
+        S = this->getSkewSymMatrix (VectorND<3> {q(0), q(1), q(2)});
         
         R.Zero();
         
@@ -1697,10 +1685,10 @@ CorotCrdTransf3d::getRotationMatrixFromQuaternion(const Vector &q) const
 }
 
 
-const Vector &
-CorotCrdTransf3d::getTangScaledPseudoVectorFromQuaternion(const Vector &q) const
+VectorND<3>
+CorotCrdTransf3d::getTangScaledPseudoVectorFromQuaternion(const VectorND<4> &q) const
 { 
-    static Vector w(3);
+    VectorND<3> w;
     
     for (int i = 0; i < 3; i++)
         w(i) = 2.0 * q(i)/q(3);
@@ -1709,13 +1697,13 @@ CorotCrdTransf3d::getTangScaledPseudoVectorFromQuaternion(const Vector &q) const
 }
 
 
-const Matrix &
-CorotCrdTransf3d::getRotMatrixFromTangScaledPseudoVector(const Vector &w) const
+MatrixND<3,3>
+CorotCrdTransf3d::getRotMatrixFromTangScaledPseudoVector(const VectorND<3> &w) const
 { 
     // Rotation matrix in terms of the tangent-scaled pseudo-vector
-    static Matrix S(3,3);
-    static Matrix S2(3,3);
-    static Matrix R(3,3);
+    MatrixND<3,3> S;
+    MatrixND<3,3> S2;
+    MatrixND<3,3> R;
     double normw2;
     
     S = this->getSkewSymMatrix(w);
@@ -1738,10 +1726,10 @@ CorotCrdTransf3d::getRotMatrixFromTangScaledPseudoVector(const Vector &w) const
 }
 
 
-const Matrix &
-CorotCrdTransf3d::getSkewSymMatrix(const Vector &theta) const
+MatrixND<3,3>
+CorotCrdTransf3d::getSkewSymMatrix(const VectorND<3> &theta) const
 {
-    static Matrix S(3,3);
+    MatrixND<3,3> S;
     
     //  St = [   0       -theta(2)  theta(1);
     //         theta(2)     0      -theta(0);
@@ -1766,17 +1754,17 @@ CorotCrdTransf3d::getSkewSymMatrix(const Vector &theta) const
 }   
 
 
-const Matrix &
-CorotCrdTransf3d::getLMatrix(const Vector &ri) const
+MatrixND<12,3>
+CorotCrdTransf3d::getLMatrix(const VectorND<3> &ri) const
 {
-    static Matrix L1(3,3), L2(3,3);
-    static Vector r1(3), e1(3);
+    MatrixND<3,3> L1, L2;
+    VectorND<3> r1, e1;
     double rie1, e1r1k;
-    static Matrix rie1r1(3,3);
-    static Matrix e1e1r1(3,3);
-    static Matrix Sri(3,3);
-    static Matrix Sr1(3,3);
-    static Matrix L(12,3);
+    MatrixND<3,3> rie1r1;
+    MatrixND<3,3> e1e1r1;
+    MatrixND<3,3> Sri;
+    MatrixND<3,3> Sr1;
+    MatrixND<12,3> L;
     
     int j, k;
     
@@ -1838,11 +1826,11 @@ CorotCrdTransf3d::getLMatrix(const Vector &ri) const
 }
 
 
-const Matrix &
-CorotCrdTransf3d::getKs2Matrix(const Vector &ri, const Vector &z) const
+MatrixND<12,12>
+CorotCrdTransf3d::getKs2Matrix(const VectorND<3> &ri, const VectorND<3> &z) const
 {
-    static Matrix ks2(12,12);
-    static Vector e1(3), r1(3);
+    MatrixND<12,12> ks2;
+    VectorND<3> e1, r1;
     
     //opserr << "\ngetKs2Matrix:\n";
     //opserr << "ri: " << ri;
@@ -1871,9 +1859,9 @@ CorotCrdTransf3d::getKs2Matrix(const Vector &ri, const Vector &z) const
         ztr1  += z(i)*r1(i);
     }
     
-    static Matrix zrit(3,3), ze1t(3,3);
-    static Matrix rizt(3,3), r1e1t(3,3), rie1t(3,3);
-    static Matrix e1zt(3,3);
+    MatrixND<3,3> zrit, ze1t;
+    MatrixND<3,3> rizt, r1e1t, rie1t;
+    MatrixND<3,3> e1zt;
     
     for (i = 0; i < 3; i++)
         for (j = 0; j < 3; j++)
@@ -1886,7 +1874,7 @@ CorotCrdTransf3d::getKs2Matrix(const Vector &ri, const Vector &z) const
             rie1t(i,j) = ri(i)*e1(j);
         }
         
-        static Matrix U(3,3);
+        MatrixND<3,3> U;
         //opserr << " rite1: "<< rite1;
         //opserr << " zte1: "<< zte1;
         //opserr << " ztr1: "<< ztr1;
@@ -1906,7 +1894,7 @@ CorotCrdTransf3d::getKs2Matrix(const Vector &ri, const Vector &z) const
         U.addMatrixProduct (1.0, A, rie1t, (zte1 + ztr1)/(2*Ln));
         
         //opserr << "U: " << U;
-        static Matrix ks(3,3);
+        MatrixND<3,3> ks;
         
         //K11 = U + U' + ri'*e1*(2*(e1'*z)+z'*r1)*A/(2*Ln);
         
@@ -1928,7 +1916,7 @@ CorotCrdTransf3d::getKs2Matrix(const Vector &ri, const Vector &z) const
             ks2.Assemble(ks, 6, 0, -1.0);
             ks2.Assemble(ks, 6, 6,  1.0);
             
-            static Matrix Sri(3,3), Sr1(3,3), Sz(3,3), Se1(3,3);
+            MatrixND<3,3> Sri, Sr1, Sz, Se1;
             
             Sri = this->getSkewSymMatrix(ri);  
             Sr1 = this->getSkewSymMatrix(r1);
@@ -1937,7 +1925,7 @@ CorotCrdTransf3d::getKs2Matrix(const Vector &ri, const Vector &z) const
             
             //K12 = (1/4)*(-A*z*e1'*Sri - A*ri*z'*Sr1 - z'*(e1+r1)*A*Sri);
             
-            static Matrix m1(3,3);
+            MatrixND<3,3> m1;
             
             m1.addMatrixProduct(0.0, A, ze1t, -1.0);
             ks.addMatrixProduct(0.0, m1, Sri, 0.25);
@@ -2012,8 +2000,19 @@ CorotCrdTransf3d::getCopy3d(void)
     theCopy->alphaJq = alphaJq;
     theCopy->alphaIqcommit = alphaIqcommit;
     theCopy->alphaJqcommit = alphaJqcommit;
+    theCopy->alphaI = alphaI;
+    theCopy->alphaJ = alphaJ;
     theCopy->ul = ul;
     theCopy->ulcommit = ulcommit;
+    theCopy->ulpr = ulpr;
+    theCopy->RI = RI;
+    theCopy->RJ = RJ;
+    theCopy->Rbar = Rbar;
+    theCopy->e = e;
+    theCopy->T = T;
+    theCopy->Lr2 = Lr2;
+    theCopy->Lr3 = Lr3;
+    theCopy->A = A;
     
     
     return theCopy;
@@ -2023,7 +2022,7 @@ CorotCrdTransf3d::getCopy3d(void)
 int 
 CorotCrdTransf3d::sendSelf(int cTag, Channel &theChannel)
 {
-  static Vector data(48);
+  Vector data(48);
   for (int i=0; i<7; i++) 
     data(i) = ulcommit(i);
   for (int j=0; j<4; j++) {
@@ -2087,7 +2086,7 @@ CorotCrdTransf3d::sendSelf(int cTag, Channel &theChannel)
 int 
 CorotCrdTransf3d::recvSelf(int cTag, Channel &theChannel, FEM_ObjectBroker &theBroker)
 {
-  static Vector data(48);
+  Vector data(48);
   if (theChannel.recvVector(this->getDbTag(), cTag, data) < 0) {
     opserr << " CorotCrdTransf3d::recvSelf() - data could not be received\n" ;
     return -1;
@@ -2146,6 +2145,7 @@ CorotCrdTransf3d::recvSelf(int cTag, Channel &theChannel, FEM_ObjectBroker &theB
 const Matrix &
 CorotCrdTransf3d::getGlobalMatrixFromLocal(const Matrix &local)
 {
+    MatrixND<12,12> Tlg;
     this->compTransfMatrixLocalGlobal(Tlg);  // OPTIMIZE LATER
     kg.addMatrixTripleProduct(0.0, Tlg, local, 1.0);  // OPTIMIZE LATER
 
@@ -39,6 +39,11 @@
 #include <CrdTransf.h>
 #include <Vector.h>
 #include <Matrix.h>
+#include <VectorND.h>
+#include <MatrixND.h>
+
+using OpenSees::VectorND;
+using OpenSees::MatrixND;
 
 class CorotCrdTransf3d: public CrdTransf
 {
@@ -89,19 +94,20 @@ public:
   int getRigidOffsets(Vector &offsets);
   
 private:
+    int computeLocalAxes(void);
     void compTransfMatrixBasicGlobal(void);
     void compTransfMatrixBasicGlobalNew(void);
-    void compTransfMatrixLocalGlobal(Matrix &Tlg);
-    void compTransfMatrixBasicLocal(Matrix &Tbl);
-    const Vector &getQuaternionFromRotMatrix(const Matrix &RotMatrix) const;
-    const Vector &getQuaternionFromPseudoRotVector(const Vector &theta) const;
-    const Vector &getTangScaledPseudoVectorFromQuaternion(const Vector &theta) const;
-    const Vector &quaternionProduct(const Vector &q1, const Vector &q2) const;
-    const Matrix &getRotationMatrixFromQuaternion(const Vector &q) const;
-    const Matrix &getRotMatrixFromTangScaledPseudoVector(const Vector &w) const;
-    const Matrix &getSkewSymMatrix(const Vector &theta) const;
-    const Matrix &getLMatrix(const Vector &ri) const;
-    const Matrix &getKs2Matrix(const Vector &ri, const Vector &z) const;
+    void compTransfMatrixLocalGlobal(MatrixND<12,12> &Tlg);
+    void compTransfMatrixBasicLocal(MatrixND<6,12> &Tbl);
+    VectorND<4> getQuaternionFromRotMatrix(const MatrixND<3,3> &RotMatrix) const;
+    VectorND<4> getQuaternionFromPseudoRotVector(const VectorND<3> &theta) const;
+    VectorND<3> getTangScaledPseudoVectorFromQuaternion(const VectorND<4> &theta) const;
+    VectorND<4> quaternionProduct(const VectorND<4> &q1, const VectorND<4> &q2) const;
+    MatrixND<3,3> getRotationMatrixFromQuaternion(const VectorND<4> &q) const;
+    MatrixND<3,3> getRotMatrixFromTangScaledPseudoVector(const VectorND<3> &w) const;
+    MatrixND<3,3> getSkewSymMatrix(const VectorND<3> &theta) const;
+    MatrixND<12,3> getLMatrix(const VectorND<3> &ri) const;
+    MatrixND<12,12> getKs2Matrix(const VectorND<3> &ri, const VectorND<3> &z) const;
     
     // internal data
     Node *nodeIPtr, *nodeJPtr;  // pointers to the element two endnodes
@@ -113,31 +119,30 @@ private:
     double L;                   // undeformed element length
     double Ln;                  // deformed element length
     
-    Matrix R0;                  // rotation matrix from local to global coordinates
+    MatrixND<3,3> R0;           // rotation matrix from local to global coordinates
                                 // (the columns of which are the element local axes)
-    Vector alphaIq;             // quaternion for node I
-    Vector alphaJq;             // quaternion for node I
-    
-    Vector alphaIqcommit;       // committed quaternion for node I
-    Vector alphaJqcommit;       // committed quaternion for node J
-    Vector alphaI;              // last trial rotations end i
-    Vector alphaJ;              // last trial rotatations end j
-    
-    Vector ul;                  // local displacements
-    Vector ulcommit;            // committed local displacements
-    Vector ulpr;                // previous local displacements
-    
-    static Matrix RI;           // nodal triad for node 1
-    static Matrix RJ;           // nodal triad for node 2
-    static Matrix Rbar;         // mean nodal triad 
-    static Matrix e;            // base vectors
-    static Matrix Tp;           // transformation matrix to renumber dofs
-    static Matrix T;            // transformation matrix from basic to global system
-    static Matrix Tlg;          // transformation matrix from global to local system
-    static Matrix TlgInv;       // inverse of transformation matrix from global to local system
-    static Matrix Tbl;          // transformation matrix from local to basic system
-    static Matrix kg;           // global stiffness matrix
-    static Matrix Lr2, Lr3, A;  // auxiliary matrices
+    VectorND<4> alphaIq;        // quaternion for node I
+    VectorND<4> alphaJq;        // quaternion for node I
+    
+    VectorND<4> alphaIqcommit;  // committed quaternion for node I
+    VectorND<4> alphaJqcommit;  // committed quaternion for node J
+    VectorND<3> alphaI;         // last trial rotations end i
+    VectorND<3> alphaJ;         // last trial rotatations end j
+    
+    VectorND<7> ul;             // local displacements
+    VectorND<7> ulcommit;       // committed local displacements
+    VectorND<7> ulpr;           // previous local displacements
+    
+    MatrixND<3,3> RI;           // nodal triad for node 1
+    MatrixND<3,3> RJ;           // nodal triad for node 2
+    MatrixND<3,3> Rbar;         // mean nodal triad 
+    MatrixND<3,3> e;            // base vectors
+    MatrixND<7,12> T;           // transformation matrix from basic to global system
+    MatrixND<12,3> Lr2, Lr3;    // auxiliary matrices
+    MatrixND<3,3> A;
+    
+    static const MatrixND<6,7> Tp;  // transformation matrix to renumber dofs
+    static thread_local Matrix kg;  // global stiffness matrix, one for each thread
     
     double *nodeIInitialDisp, *nodeJInitialDisp;
     bool initialDispChecked;
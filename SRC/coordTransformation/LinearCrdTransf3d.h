@@ -39,6 +39,9 @@
 #include <CrdTransf.h>
 #include <Vector.h>
 #include <Matrix.h>
+#include <MatrixND.h>
+
+using OpenSees::MatrixND;
 
 class LinearCrdTransf3d: public CrdTransf
 {
@@ -95,7 +98,8 @@ public:
    /////////////////////////////////////////////////////////////    
 private:
     int computeElemtLengthAndOrient(void);
-    void compTransfMatrixLocalGlobal(Matrix &Tlg);
+    int computeLocalAxes(void);
+    void compTransfMatrixLocalGlobal(MatrixND<12,12> &Tlg);
     
     // internal data
     Node *nodeIPtr, *nodeJPtr;  // pointers to the element two endnodes
@@ -105,8 +109,7 @@ private:
     double R[3][3];	 // rotation matrix
     double L;        // undeformed element length
 
-    static Matrix Tlg;  // matrix that transforms from global to local coordinates
-    static Matrix kg;   // global stiffness matrix
+    static thread_local Matrix kg;   // global stiffness matrix
 
     double *nodeIInitialDisp, *nodeJInitialDisp;
     bool initialDispChecked;
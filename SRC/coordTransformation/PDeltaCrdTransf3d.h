@@ -39,6 +39,9 @@
 #include <CrdTransf.h>
 #include <Vector.h>
 #include <Matrix.h>
+#include <MatrixND.h>
+
+using OpenSees::MatrixND;
 
 class PDeltaCrdTransf3d: public CrdTransf
 {
@@ -92,7 +95,8 @@ public:
   
 private:
     int computeElemtLengthAndOrient(void);
-    void compTransfMatrixLocalGlobal(Matrix &Tlg);
+    int computeLocalAxes(void);
+    void compTransfMatrixLocalGlobal(MatrixND<12,12> &Tlg);
     
     // internal data
     Node *nodeIPtr, *nodeJPtr;  // pointers to the element two endnodes
@@ -104,8 +108,7 @@ private:
     double ul17;	// Transverse local displacement offsets of P-Delta
     double ul28;
 
-    static Matrix Tlg;  // matrix that transforms from global to local coordinates
-    static Matrix kg;   // global stiffness matrix
+    static thread_local Matrix kg;   // global stiffness matrix
 
     double *nodeIInitialDisp, *nodeJInitialDisp;
     bool initialDispChecked;
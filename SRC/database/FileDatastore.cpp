@@ -283,52 +283,23 @@ FileDatastore::sendID(int dataTag, int commitTag,
   }
 
   //
-  // find location in file to place the data
+  // find location in file to place the data, a record already in the
+  // file is found through the index built when the file was opened,
+  // otherwise the data goes at the end
   //
 
   fstream *theStream = theFileStruct->theFile;
-  bool found = false;  
-  STREAM_POSITION_TYPE pos = theStream->tellg();  
   STREAM_POSITION_TYPE fileEnd = theFileStruct->fileEnd;
-  
-  // we first check if the data can go at the end of the file
-  // true if commitTag larger than any we have encountered so far
+  STREAM_POSITION_TYPE pos;
 
-  if (theFileStruct->maxDbTag < dataTag)  {
+  FILE_INDEX_ITERATOR theRecord = theFileStruct->theIndex.find(dataTag);
+  if (theRecord != theFileStruct->theIndex.end())
+    pos = theRecord->second;
+  else {
     pos = fileEnd;
-    found = true;
-    theFileStruct->maxDbTag = dataTag;
-  } 
-  
-  // try current location    
-  if (pos < fileEnd && found == false) {
-// #ifdef _WIN32
-    // must be a bug in the vc compiler! .. we are here already tellg() above!!
-    theStream->seekg(pos, ios::beg);
-// #endif
-    theStream->read(data, stepSize);
-    if (*(theIntData.dbTag) == dataTag ) { 
-      found = true;
-    }
-  }
-  
-  // we have to search from the beginning of the file  
-  if (found == false) {
-    *(theIntData.dbTag) = -1;
-    pos = sizeof(int);
-    theStream->seekg(pos, ios::beg);
-    while (pos < fileEnd && found == false) {
-      theStream->read(data, stepSize);
-      
-      if (*(theIntData.dbTag) == dataTag) 
-	found = true;
-      else 
-	pos += stepSize;
-    }
-    
-    if (found == false) {
-      pos = fileEnd;
-    }
+    theFileStruct->theIndex.insert(FILE_INDEX_TYPE(dataTag, pos));
+    if (theFileStruct->maxDbTag < dataTag)
+      theFileStruct->maxDbTag = dataTag;
   }
   
   //
@@ -443,44 +414,20 @@ FileDatastore::recvID(int dataTag, int commitTag,
     } 
   }
 
-  fstream *theStream = theFileStruct->theFile;
-  STREAM_POSITION_TYPE fileEnd = theFileStruct->fileEnd;
-  STREAM_POSITION_TYPE pos = theStream->tellg();
-  
   //
-  // find location in file to place the data
+  // find the location of the data in the file from the index
   //
-  
-  bool found = false;  
-
-  // we try the current file position first
-
-  if (pos < fileEnd) {
-    theStream->read(data, stepSize);
-    if (*(theIntData.dbTag) == dataTag) {
-      found = true;
-      pos += stepSize;
-    } 
-  }
-
-  // we must search from the beginning of the file
-  if (found == false) {
-    pos = sizeof(int);
-    theStream->seekg(pos, ios::beg); 
-    while ((pos < fileEnd) && (found == false)) {
-      theStream->read(data, stepSize);
-      if (*(theIntData.dbTag) == dataTag) 
-	found = true;
-      else 
-	pos += stepSize;
-    }
-  }
 
-  if (found == false) {
+  fstream *theStream = theFileStruct->theFile;
+  FILE_INDEX_ITERATOR theRecord = theFileStruct->theIndex.find(dataTag);
+  if (theRecord == theFileStruct->theIndex.end()) {
     opserr << "FileDatastore::recvID() - failed\n";
     return -1;
   }
 
+  theStream->seekg(theRecord->second, ios::beg); 
+  theStream->read(data, stepSize);
+
   //opserr << "READ: " << dataTag << " " << pos << endln;
 
   // we now place the received data into the ID 
@@ -583,52 +530,23 @@ FileDatastore::sendMatrix(int dataTag, int commitTag,
   }
 
   //
-  // find location in file to place the data
+  // find location in file to place the data, a record already in the
+  // file is found through the index built when the file was opened,
+  // otherwise the data goes at the end
   //
-  
+
   fstream *theStream = theFileStruct->theFile;
-  bool found = false;  
-  STREAM_POSITION_TYPE pos = theStream->tellg();  
   STREAM_POSITION_TYPE fileEnd = theFileStruct->fileEnd;
-  
-  // we first check if the data can go at the end of the file
-  // true if commitTag larger than any we have encountered so far
-  
-  if (theFileStruct->maxDbTag < dataTag)  {
+  STREAM_POSITION_TYPE pos;
+
+  FILE_INDEX_ITERATOR theRecord = theFileStruct->theIndex.find(dataTag);
+  if (theRecord != theFileStruct->theIndex.end())
+    pos = theRecord->second;
+  else {
     pos = fileEnd;
-    found = true;
-    theFileStruct->maxDbTag = dataTag;
-  } 
-  
-  // try current location    
-  if (pos < fileEnd && found == false) {
-// #ifdef _WIN32
-    // must be a bug in the vc compiler! .. we are here already tellg() above!!
-    theStream->seekg(pos, ios::beg);
-// #endif
-    theStream->read(data, stepSize);
-    if (*(theIntData.dbTag) == dataTag ) { 
-      found = true;
-    }
-  }
-  
-  // we have to search from the beginning of the file  
-  if (found == false) {
-    *(theIntData.dbTag) = -1;
-    pos = sizeof(int);
-    theStream->seekg(pos, ios::beg);
-    while (pos < fileEnd && found == false) {
-      theStream->read(data, stepSize);
-      
-      if (*(theIntData.dbTag) == dataTag) 
-	found = true;
-      else 
-	pos += stepSize;
-    }
-    
-    if (found == false) {
-      pos = fileEnd;
-    }
+    theFileStruct->theIndex.insert(FILE_INDEX_TYPE(dataTag, pos));
+    if (theFileStruct->maxDbTag < dataTag)
+      theFileStruct->maxDbTag = dataTag;
   }
 
   //
@@ -750,44 +668,20 @@ FileDatastore::recvMatrix(int dataTag, int commitTag,
   }
 
 
-  fstream *theStream = theFileStruct->theFile;
-  STREAM_POSITION_TYPE fileEnd = theFileStruct->fileEnd;
-  STREAM_POSITION_TYPE pos = theStream->tellg();
-  
   //
-  // find location in file to place the data
+  // find the location of the data in the file from the index
   //
-  
-  bool found = false;  
 
-  // we try the current file position first
-
-  if (pos < fileEnd) {
-    theStream->read(data, stepSize);
-    if (*(theIntData.dbTag) == dataTag) {
-      found = true;
-      pos += stepSize;
-    } 
-  }
-
-  // we must search from the beginning of the file
-  if (found == false) {
-    pos = sizeof(int);
-    theStream->seekg(pos, ios::beg); 
-    while ((pos < fileEnd) && (found == false)) {
-      theStream->read(data, stepSize);
-      if (*(theIntData.dbTag) == dataTag) 
-	found = true;
-      else 
-	pos += stepSize;
-    }
-  }
-
-  if (found == false) {
+  fstream *theStream = theFileStruct->theFile;
+  FILE_INDEX_ITERATOR theRecord = theFileStruct->theIndex.find(dataTag);
+  if (theRecord == theFileStruct->theIndex.end()) {
     opserr << "FileDatastore::recvMatrix() - failed\n";
     return -1;
   }
 
+  theStream->seekg(theRecord->second, ios::beg); 
+  theStream->read(data, stepSize);
+
   int loc=0;
   for (int j=0; j<noMatCols; j++)
     for (int k=0; k < noMatRows; k++) {
@@ -888,55 +782,23 @@ FileDatastore::sendVector(int dataTag, int commitTag,
   }
 
   //
-  // find location in file to place the data
+  // find location in file to place the data, a record already in the
+  // file is found through the index built when the file was opened,
+  // otherwise the data goes at the end
   //
-  
+
   fstream *theStream = theFileStruct->theFile;
-  bool found = false;  
-  STREAM_POSITION_TYPE pos = theStream->tellg();  
   STREAM_POSITION_TYPE fileEnd = theFileStruct->fileEnd;
-  
-  // we first check if the data can go at the end of the file
-  // true if commitTag larger than any we have encountered so far
-  found = false;
-  
-  
-  if (theFileStruct->maxDbTag < dataTag)  {
-    pos = fileEnd;
-    found = true;
-    theFileStruct->maxDbTag = dataTag;
-  } 
+  STREAM_POSITION_TYPE pos;
 
-  
-  // try current location    
-  if (pos < fileEnd && found == false) {
-// #ifdef _WIN32
-    // must be a bug in the vc compiler! .. we are here already tellg() above!!
-    theStream->seekg(pos, ios::beg);
-// #endif
-    theStream->read(data, stepSize);
-    if (*(theIntData.dbTag) == dataTag ) { 
-      found = true;
-    }
-  }
-  
-  // we have to search from the beginning of the file  
-  if (found == false) {
-    *(theIntData.dbTag) = -1;
-    pos = sizeof(int);
-    theStream->seekg(pos, ios::beg);
-    while (pos < fileEnd && found == false) {
-      theStream->read(data, stepSize);
-      
-      if (*(theIntData.dbTag) == dataTag) 
-	found = true;
-      else 
-	pos += stepSize;
-    }
-    
-    if (found == false) {
-      pos = fileEnd;
-    }
+  FILE_INDEX_ITERATOR theRecord = theFileStruct->theIndex.find(dataTag);
+  if (theRecord != theFileStruct->theIndex.end())
+    pos = theRecord->second;
+  else {
+    pos = fileEnd;
+    theFileStruct->theIndex.insert(FILE_INDEX_TYPE(dataTag, pos));
+    if (theFileStruct->maxDbTag < dataTag)
+      theFileStruct->maxDbTag = dataTag;
   }
 
   //
@@ -1048,44 +910,20 @@ FileDatastore::recvVector(int dataTag, int commitTag,
     } 
   }
 
-  fstream *theStream = theFileStruct->theFile;
-  STREAM_POSITION_TYPE fileEnd = theFileStruct->fileEnd;
-  STREAM_POSITION_TYPE pos = theStream->tellg();
-  
   //
-  // find location in file to place the data
+  // find the location of the data in the file from the index
   //
-  
-  bool found = false;  
-
-  // we try the current file position first
-
-  if (pos < fileEnd) {
-    theStream->read(data, stepSize);
-    if ((*(theIntData.dbTag) == dataTag)) {
-      found = true;
-      pos += stepSize;
-    } 
-  }
-
-  // we must search from the beginning of the file
-  if (found == false) {
-    pos = sizeof(int);
-    theStream->seekg(pos, ios::beg); 
-    while ((pos < fileEnd) && (found == false)) {
-      theStream->read(data, stepSize);
-      if (*(theIntData.dbTag) == dataTag) 
-	found = true;
-      else 
-	pos += stepSize;
-    }
-  }
 
-  if (found == false) {
+  fstream *theStream = theFileStruct->theFile;
+  FILE_INDEX_ITERATOR theRecord = theFileStruct->theIndex.find(dataTag);
+  if (theRecord == theFileStruct->theIndex.end()) {
     opserr << "FileDatastore::recvVector() - failed\n";
     return -1;
   }
 
+  theStream->seekg(theRecord->second, ios::beg); 
+  theStream->read(data, stepSize);
+
   for (int i=0; i<vectSize; i++)
     theVector(i) = theDoubleData.data[i];
 
@@ -1233,6 +1071,15 @@ FileDatastore::openFile(char *fileName, FileDatastoreOutputFile *theFileStruct,
     maxDataTag = *(theIntData.dbTag);
   }
 
+  // index the records already in the file by their dbTag, so that
+  // a record is found without searching the file from the start
+  theFileStruct->theIndex.clear();
+  for (STREAM_POSITION_TYPE pos = sizeof(int); pos + dataSize <= fileEnd; pos += dataSize) {
+    res->seekg(pos, ios::beg);
+    res->read(data, sizeof(int));
+    theFileStruct->theIndex.insert(FILE_INDEX_TYPE(*(theIntData.dbTag), pos));
+  }
+
   // move to start of data part
   res->seekp(sizeof(int), ios::beg);
   res->seekg(sizeof(int), ios::beg);
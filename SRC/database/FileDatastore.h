@@ -33,7 +33,9 @@
 // FileDatastore is a concrete subclas of FE_Datastore. A FileDatastore 
 // object is used in the program to store/restore the geometry and state 
 // information in a domain at a particular instance in the analysis. The
-// information is stored in text files.
+// information is stored in binary files, one for each size of ID, Vector
+// and Matrix, of fixed size records; the records of an open file are
+// indexed by dbTag.
 //
 // What: "@(#) FileDatastore.h, revA"
 
@@ -41,6 +43,7 @@
 
 #include <fstream>
 #include <map>
+#include <unordered_map>
 using std::fstream;
 using std::map;
 
@@ -49,10 +52,16 @@ using std::map;
 
 class FEM_ObjectBroker;
 
+// position in the file of the record with each dbTag
+typedef std::unordered_map<int, STREAM_POSITION_TYPE> FILE_INDEX;
+typedef FILE_INDEX::value_type                         FILE_INDEX_TYPE;
+typedef FILE_INDEX::iterator                           FILE_INDEX_ITERATOR;
+
 typedef struct fileDatastoreOutputFile {
   fstream *theFile;
   STREAM_POSITION_TYPE fileEnd;
   int      maxDbTag;
+  FILE_INDEX theIndex;
 } FileDatastoreOutputFile;
 
 typedef map<int, FileDatastoreOutputFile *>      MAP_FILES;
@@ -0,0 +1,114 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// File: ~/database/benchmark.cpp
+//
+// Description: restart benchmark for FileDatastore. numRecords IDs,
+// Vectors and Matrices are written under one commitTag, as a database 
+// save of a model would, and then read back through a second
+// FileDatastore opened on the same files, as a restore would, with the
+// records requested in a shuffled order. The time to open and read is
+// printed with a check of the data read. Built with "make benchmark", run
+// as "database_benchmark numRecords".
+
+#include <FileDatastore.h>
+#include <FEM_ObjectBroker.h>
+#include <Domain.h>
+#include <ID.h>
+#include <Vector.h>
+#include <Matrix.h>
+#include <OPS_Globals.h>
+#include <StandardStream.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <random>
+
+StandardStream sserr;
+OPS_Stream *opserrPtr = &sserr;
+
+int main(int argc, char **argv)
+{
+  int numRecords = 20000;
+  if (argc > 1)
+    numRecords = atoi(argv[1]);
+
+  const char *dataBase = "benchmarkDatastore";
+  const int commitTag = 1;
+
+  Domain theDomain;
+  FEM_ObjectBroker theBroker;
+
+  ID theID(6);
+  Vector theVector(12);
+  Matrix theMatrix(6,6);
+
+  // save
+  std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+  {
+    FileDatastore theStore(dataBase, theDomain, theBroker);
+    for (int dbTag=1; dbTag<=numRecords; dbTag++) {
+      for (int i=0; i<6; i++)
+	theID(i) = dbTag + i;
+      for (int i=0; i<12; i++)
+	theVector(i) = dbTag;
+      theMatrix(0,0) = theMatrix(5,5) = dbTag;
+      theStore.sendID(dbTag, commitTag, theID);
+      theStore.sendVector(dbTag, commitTag, theVector);
+      theStore.sendMatrix(dbTag, commitTag, theMatrix);
+    }
+  }
+  std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+
+  // restore, in the order the objects are asked for their data rather
+  // than the order they were written
+  std::vector<int> dbTags(numRecords);
+  for (int i=0; i<numRecords; i++)
+    dbTags[i] = i+1;
+  std::shuffle(dbTags.begin(), dbTags.end(), std::mt19937(1));
+
+  int numErrors = 0;
+  std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+  {
+    FileDatastore theStore(dataBase, theDomain, theBroker);
+    for (int i=0; i<numRecords; i++) {
+      int dbTag = dbTags[i];
+      if (theStore.recvID(dbTag, commitTag, theID) < 0 ||
+	  theStore.recvVector(dbTag, commitTag, theVector) < 0 ||
+	  theStore.recvMatrix(dbTag, commitTag, theMatrix) < 0) {
+	numErrors++;
+	continue;
+      }
+      if (theID(5) != dbTag + 5 || theVector(11) != dbTag || theMatrix(5,5) != dbTag)
+	numErrors++;
+    }
+  }
+  std::chrono::steady_clock::time_point t3 = std::chrono::steady_clock::now();
+
+  printf("%d records of each type\n", numRecords);
+  printf("save    %10.3f ms\n", std::chrono::duration<double, std::milli>(t1 - t0).count());
+  printf("restore %10.3f ms\n", std::chrono::duration<double, std::milli>(t3 - t2).count());
+  printf("errors  %10d\n", numErrors);
+
+  return numErrors == 0 ? 0 : -1;
+}
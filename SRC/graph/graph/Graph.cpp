@@ -40,10 +40,11 @@
 #include <Channel.h>
 #include <FEM_ObjectBroker.h>
 #include <Vector.h>
+#include <ID.h>
 
 Graph::Graph()
   :myVertices(0), theVertexIter(0), numEdge(0), nextFreeTag(START_VERTEX_NUM),
-  vertices()
+  vertices(), compressed(false)
 {
     myVertices = new MapOfTaggedObjects();
     theVertexIter = new VertexIter(myVertices);
@@ -52,7 +53,7 @@ Graph::Graph()
 
 Graph::Graph(int numVertices)
   :myVertices(0), theVertexIter(0), numEdge(0), nextFreeTag(START_VERTEX_NUM),
-  vertices()
+  vertices(), compressed(false)
 {
     myVertices = new MapOfTaggedObjects();
     theVertexIter = new VertexIter(myVertices);
@@ -61,7 +62,7 @@ Graph::Graph(int numVertices)
 
 Graph::Graph(TaggedObjectStorage &theVerticesStorage)
   :myVertices(&theVerticesStorage), theVertexIter(0), numEdge(0), nextFreeTag(START_VERTEX_NUM),
-  vertices()
+  vertices(), compressed(false)
 {
   TaggedObject *theObject;
   TaggedObjectIter &theObjects = theVerticesStorage.getComponents();
@@ -76,7 +77,7 @@ Graph::Graph(TaggedObjectStorage &theVerticesStorage)
 
 Graph::Graph(Graph &other) 
   :myVertices(0), theVertexIter(0), numEdge(0), nextFreeTag(START_VERTEX_NUM),
-  vertices()
+  vertices(), compressed(false)
 {
   myVertices = new MapOfTaggedObjects();
   theVertexIter = new VertexIter(myVertices);
@@ -157,6 +158,7 @@ Graph::addVertex(Vertex *vertexPtr, bool checkAdjacency)
 
 
     bool result = myVertices->addComponent(vertexPtr);
+    compressed = false;
     if (result == false) {
       opserr << *this;
       opserr << "BAD VERTEX\n: " << *vertexPtr;
@@ -199,6 +201,7 @@ Graph::addEdge(int vertexTag, int otherVertexTag)
 	if (result == 1)
 		return 0;  // already there
 	else if (result == 0) {  // added to vertexTag now add to other
+		compressed = false;
 		if ((result = vertex2->addEdge(vertexTag)) == 0) {
 			numEdge++;
 		}
@@ -255,6 +258,7 @@ Graph::addEdgeFast(int vertexTag, int otherVertexTag)
 	if (result == 1)
 		return 0;  // already there
 	else if (result == 0) {  // added to vertexTag now add to other
+		compressed = false;
 		if ((result = vertex2->addEdge(vertexTag)) == 0) {
 			numEdge++;
 		}
@@ -275,6 +279,59 @@ Graph::addEdgeFast(int vertexTag, int otherVertexTag)
     return result;
 }
 
+int
+Graph::setEdges(std::vector<int> &start, std::vector<int> &adjacency)
+{
+    int numRow = start.size() - 1;
+    if (numRow < 0 || start[numRow] != (int)adjacency.size()) {
+	opserr << "WARNING Graph::setEdges() - start and adjacency do not agree\n";
+	return -1;
+    }
+
+    // give each vertex its adjacency, a row may only be empty if the
+    // vertex is not in the graph
+    int *adjacencyData = adjacency.data();
+    for (int i=0; i<numRow; i++) {
+	int rowSize = start[i+1] - start[i];
+	Vertex *vertexPtr = this->getVertexPtr(i + START_VERTEX_NUM);
+	if (vertexPtr == 0) {
+	    if (rowSize == 0)
+		continue;
+	    opserr << "WARNING Graph::setEdges() - vertex ";
+	    opserr << i + START_VERTEX_NUM << " not in Graph\n";
+	    return -1;
+	}
+	ID rowAdjacency(adjacencyData + start[i], rowSize, false);
+	vertexPtr->setAdjacency(rowAdjacency);
+    }
+
+    numEdge = adjacency.size()/2;
+
+    // keep the compressed form if it covers every vertex
+    compressed = (numRow == this->getNumVertex());
+    if (compressed == true) {
+	edgeStart.swap(start);
+	edgeAdjacency.swap(adjacency);
+    } else {
+	edgeStart.clear();
+	edgeAdjacency.clear();
+    }
+    
+    return 0;
+}
+
+const int *
+Graph::getEdgeStart(void) const
+{
+    return compressed ? edgeStart.data() : 0;
+}
+
+const int *
+Graph::getEdgeAdjacency(void) const
+{
+    return compressed ? edgeAdjacency.data() : 0;
+}
+
 Vertex *
 Graph::getVertexPtr(int vertexTag)
 {
@@ -317,6 +374,7 @@ Graph::removeVertex(int tag, bool flag)
 {
     TaggedObject *mc = myVertices->removeComponent(tag);
     if (mc == 0) return 0;
+    compressed = false;
     Vertex *result = (Vertex *)mc;
     
     if (flag == true) { // remove all edges associated with the vertex
@@ -473,6 +531,7 @@ Graph::recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &theBroker)
 
     numEdge = 0;
     myVertices->clearAll();
+    compressed = false;
   }
 
   // recv numEdge & numVertices
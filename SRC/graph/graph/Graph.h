@@ -59,6 +59,16 @@ class Graph
     virtual int addEdge(int vertexTag, int otherVertexTag);
     virtual void startAddEdge();
     virtual int addEdgeFast(int vertexTag, int otherVertexTag);
+
+    // replace the edges of all vertices at once, the sorted adjacency of
+    // vertex START_VERTEX_NUM+i being adjacency[start[i]:start[i+1]]
+    virtual int setEdges(std::vector<int> &start, std::vector<int> &adjacency);
+
+    // the same adjacency in compressed row form, available while the edges
+    // are those of the last setEdges() and there is a row for every vertex,
+    // otherwise 0
+    const int *getEdgeStart(void) const;
+    const int *getEdgeAdjacency(void) const;
     
     virtual Vertex *getVertexPtr(int vertexTag);
     virtual VertexIter &getVertices(void);
@@ -83,6 +93,10 @@ class Graph
     int numEdge;
     int nextFreeTag;
     std::vector<Vertex*> vertices;
+
+    bool compressed;
+    std::vector<int> edgeStart;
+    std::vector<int> edgeAdjacency;
 };
 
 #endif
@@ -0,0 +1,113 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// File: ~/graph/graph/GraphBuilder.cpp
+//
+// Description: This file contains the implementation of GraphBuilder.
+
+#include <GraphBuilder.h>
+#include <Graph.h>
+#include <Vertex.h>
+#include <ID.h>
+#include <OPS_Globals.h>
+
+#include <algorithm>
+
+GraphBuilder::GraphBuilder(int numV)
+  :numVertex(numV), members(), cliqueStart(1, 0)
+{
+  if (numVertex < 0)
+    numVertex = 0;
+}
+
+GraphBuilder::~GraphBuilder()
+{
+
+}
+
+void
+GraphBuilder::addClique(const ID &tags, int shift)
+{
+  int size = tags.Size();
+  for (int i=0; i<size; i++) {
+    int vertex = tags(i) + shift - START_VERTEX_NUM;
+    if (vertex >= 0 && vertex < numVertex)
+      members.push_back(vertex);
+  }
+  cliqueStart.push_back(members.size());
+}
+
+int
+GraphBuilder::getNumVertex(void) const
+{
+  return numVertex;
+}
+
+int
+GraphBuilder::build(Graph &theGraph)
+{
+  int numClique = cliqueStart.size() - 1;
+
+  // the cliques each vertex is in
+  std::vector<int> vertexStart(numVertex+1, 0);
+  for (int member : members)
+    vertexStart[member+1]++;
+  for (int v=0; v<numVertex; v++)
+    vertexStart[v+1] += vertexStart[v];
+
+  std::vector<int> vertexCliques(members.size());
+  std::vector<int> next(vertexStart.begin(), vertexStart.end()-1);
+  for (int c=0; c<numClique; c++)
+    for (int k=cliqueStart[c]; k<cliqueStart[c+1]; k++)
+      vertexCliques[next[members[k]]++] = c;
+
+  // the adjacency of vertex v is the union of its cliques less v, marker
+  // keeps each neighbour from being added more than once
+  std::vector<int> start(numVertex+1, 0);
+  std::vector<int> adjacency;
+  adjacency.reserve(members.size());
+  std::vector<int> &marker = next;
+  marker.assign(numVertex, -1);
+
+  for (int v=0; v<numVertex; v++) {
+    marker[v] = v;
+    for (int i=vertexStart[v]; i<vertexStart[v+1]; i++) {
+      int c = vertexCliques[i];
+      for (int k=cliqueStart[c]; k<cliqueStart[c+1]; k++) {
+	int other = members[k];
+	if (marker[other] != v) {
+	  marker[other] = v;
+	  adjacency.push_back(other + START_VERTEX_NUM);
+	}
+      }
+    }
+    start[v+1] = adjacency.size();
+    std::sort(adjacency.begin() + start[v], adjacency.end());
+  }
+
+  // release the cliques before the graph takes its copy of the adjacency
+  members.clear();
+  members.shrink_to_fit();
+  cliqueStart.assign(1, 0);
+  vertexCliques.clear();
+  vertexCliques.shrink_to_fit();
+
+  return theGraph.setEdges(start, adjacency);
+}
@@ -0,0 +1,60 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef GraphBuilder_h
+#define GraphBuilder_h
+
+// File: ~/graph/graph/GraphBuilder.h
+//
+// Description: This file contains the class definition for GraphBuilder.
+// A GraphBuilder collects the edges of a graph whose vertices have tags
+// START_VERTEX_NUM to START_VERTEX_NUM+numVertex-1 as cliques, i.e. the
+// DOFs or DOF_Groups of one FE_Element, and forms the adjacency of every
+// vertex in one pass once all the cliques are in. This replaces adding the
+// edges one pair at a time, which costs a search and a shift of the
+// adjacency ID for every pair. The result is given to the Graph with
+// Graph::setEdges(), which also keeps it in compressed row form for the
+// numberers and the system of equations.
+
+#include <vector>
+
+class ID;
+class Graph;
+
+class GraphBuilder
+{
+  public:
+    GraphBuilder(int numVertex);
+    ~GraphBuilder();
+
+    // adds an edge between every pair of the vertices tags(i)+shift;
+    // those outside the range of the graph (constrained dofs) are skipped
+    void addClique(const ID &tags, int shift = 0);
+
+    int getNumVertex(void) const;
+    int build(Graph &theGraph);
+    
+  private:
+    int numVertex;
+    std::vector<int> members;       // vertex numbers of all the cliques
+    std::vector<int> cliqueStart;   // start of each clique in members
+};
+
+#endif
@@ -63,6 +63,19 @@ AMD::number(Graph &theGraph, int startVertex)
 
   theResult.resize(numVertex);
 
+  // if the graph holds its adjacency in compressed form it is passed
+  // to amd as it is
+  const int *edgeStart = theGraph.getEdgeStart();
+  const int *edgeAdjacency = theGraph.getEdgeAdjacency();
+  if (edgeStart != 0) {
+    int *P = new int[numVertex];
+    amd_order(numVertex, edgeStart, edgeAdjacency, P, (double *)NULL, (double *)NULL);
+    for (int i=0; i<numVertex; i++)
+      theResult[i] = P[i];
+    delete [] P;
+    return theResult;
+  }
+
   int nnz = 0;
   Vertex *vertexPtr;
   VertexIter &vertexIter = theGraph.getVertices();
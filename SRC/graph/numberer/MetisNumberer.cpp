@@ -243,8 +243,19 @@ Metis::partition(Graph &theGraph, int numPart)
     int indexEdge = 0;
     xadj[0] = 0;
 
+    // if the graph holds its adjacency in compressed form copy it over
+    const int *edgeStart = theGraph.getEdgeStart();
+    const int *edgeAdjacency = theGraph.getEdgeAdjacency();
+    if (edgeStart != 0) {
+	for (int vertex =0; vertex<numVertex; vertex++) {
+	    for (int i=edgeStart[vertex]; i<edgeStart[vertex+1]; i++)
+		adjncy[indexEdge++] = edgeAdjacency[i]-START_VERTEX_NUM;
+	    xadj[vertex+1] = indexEdge;
+	}
+    }
+
     Vertex *vertexPtr;
-    for (int vertex =0; vertex<numVertex; vertex++) {
+    for (int vertex =0; edgeStart == 0 && vertex<numVertex; vertex++) {
 	vertexPtr = theGraph.getVertexPtr(vertex+START_VERTEX_NUM);
 	
 	// check we don't have an invalid vertex numbering scheme
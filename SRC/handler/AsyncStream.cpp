@@ -0,0 +1,410 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// File: ~/handler/AsyncStream.cpp
+//
+// Description: This file contains the implementation of AsyncStream.
+
+#include <AsyncStream.h>
+#include <Vector.h>
+
+AsyncStream::AsyncStream(OPS_Stream *stream, int rows)
+ : OPS_Stream(OPS_STREAM_TAGS_AsyncStream),
+   theStream(stream), bufferRows(rows),
+   writing(false), shutdown(false)
+{
+  if (bufferRows < 1)
+    bufferRows = 256;
+
+  writer = std::thread(&AsyncStream::work, this);
+}
+
+AsyncStream::~AsyncStream()
+{
+  // write the rows still buffered, then stop the writer
+  {
+    std::unique_lock<std::mutex> lock(theMutex);
+    shutdown = true;
+  }
+  workCondition.notify_one();
+  writer.join();
+
+  if (theStream != 0)
+    delete theStream;
+}
+
+void
+AsyncStream::work(void)
+{
+  std::unique_lock<std::mutex> lock(theMutex);
+
+  while (true) {
+    workCondition.wait(lock, [this] {
+      return !front.sizes.empty() || shutdown;
+    });
+
+    if (front.sizes.empty() && shutdown)
+      return;
+
+    // take the rows written so far, leaving write() the other buffer
+    std::swap(front, back);
+    writing = true;
+    lock.unlock();
+    doneCondition.notify_all();
+
+    const double *values = back.values.data();
+    for (int n : back.sizes) {
+      Vector row(const_cast<double *>(values), n);
+      theStream->write(row);
+      values += n;
+    }
+    back.values.clear();
+    back.sizes.clear();
+
+    lock.lock();
+    writing = false;
+    doneCondition.notify_all();
+  }
+}
+
+void
+AsyncStream::drain(void)
+{
+  std::unique_lock<std::mutex> lock(theMutex);
+  doneCondition.wait(lock, [this] {
+    return front.sizes.empty() && !writing;
+  });
+}
+
+int
+AsyncStream::write(Vector &data)
+{
+  int n = data.Size();
+  {
+    std::unique_lock<std::mutex> lock(theMutex);
+
+    // both buffers full, wait for the writer to take the front one
+    doneCondition.wait(lock, [this] {
+      return (int)front.sizes.size() < bufferRows;
+    });
+
+    for (int i=0; i<n; i++)
+      front.values.push_back(data(i));
+    front.sizes.push_back(n);
+  }
+  workCondition.notify_one();
+
+  return 0;
+}
+
+int
+AsyncStream::setFile(const char *fileName, openMode mode, bool echo)
+{
+  this->drain();
+  return theStream->setFile(fileName, mode, echo);
+}
+
+int
+AsyncStream::setPrecision(int prec)
+{
+  this->drain();
+  return theStream->setPrecision(prec);
+}
+
+int
+AsyncStream::setFloatField(floatField field)
+{
+  this->drain();
+  return theStream->setFloatField(field);
+}
+
+int
+AsyncStream::precision(int prec)
+{
+  this->drain();
+  return theStream->precision(prec);
+}
+
+int
+AsyncStream::width(int w)
+{
+  this->drain();
+  return theStream->width(w);
+}
+
+int
+AsyncStream::tag(const char *tagName)
+{
+  this->drain();
+  return theStream->tag(tagName);
+}
+
+int
+AsyncStream::tag(const char *tagName, const char *value)
+{
+  this->drain();
+  return theStream->tag(tagName, value);
+}
+
+int
+AsyncStream::endTag()
+{
+  this->drain();
+  return theStream->endTag();
+}
+
+int
+AsyncStream::attr(const char *name, int value)
+{
+  this->drain();
+  return theStream->attr(name, value);
+}
+
+int
+AsyncStream::attr(const char *name, double value)
+{
+  this->drain();
+  return theStream->attr(name, value);
+}
+
+int
+AsyncStream::attr(const char *name, const char *value)
+{
+  this->drain();
+  return theStream->attr(name, value);
+}
+
+int
+AsyncStream::flush()
+{
+  this->drain();
+  return theStream->flush();
+}
+
+int
+AsyncStream::open(void)
+{
+  this->drain();
+  return theStream->open();
+}
+
+int
+AsyncStream::close(openMode nextOpen)
+{
+  this->drain();
+  return theStream->close(nextOpen);
+}
+
+OPS_Stream&
+AsyncStream::write(const char *s, int n)
+{
+  this->drain();
+  theStream->write(s, n);
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::write(const unsigned char *s, int n)
+{
+  this->drain();
+  theStream->write(s, n);
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::write(const signed char *s, int n)
+{
+  this->drain();
+  theStream->write(s, n);
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::write(const void *s, int n)
+{
+  this->drain();
+  theStream->write(s, n);
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::write(const double *s, int n)
+{
+  this->drain();
+  theStream->write(s, n);
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(char c)
+{
+  this->drain();
+  *theStream << c;
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(unsigned char c)
+{
+  this->drain();
+  *theStream << c;
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(signed char c)
+{
+  this->drain();
+  *theStream << c;
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(const char *s)
+{
+  this->drain();
+  *theStream << s;
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(const unsigned char *s)
+{
+  this->drain();
+  *theStream << s;
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(const signed char *s)
+{
+  this->drain();
+  *theStream << s;
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(const void *p)
+{
+  this->drain();
+  *theStream << p;
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(int n)
+{
+  this->drain();
+  *theStream << n;
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(unsigned int n)
+{
+  this->drain();
+  *theStream << n;
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(long n)
+{
+  this->drain();
+  *theStream << n;
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(unsigned long n)
+{
+  this->drain();
+  *theStream << n;
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(short n)
+{
+  this->drain();
+  *theStream << n;
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(unsigned short n)
+{
+  this->drain();
+  *theStream << n;
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(bool b)
+{
+  this->drain();
+  *theStream << b;
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(double n)
+{
+  this->drain();
+  *theStream << n;
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(float n)
+{
+  this->drain();
+  *theStream << n;
+  return *this;
+}
+
+void
+AsyncStream::setAddCommon(int flag)
+{
+  this->drain();
+  theStream->setAddCommon(flag);
+}
+
+int
+AsyncStream::setOrder(const ID &order)
+{
+  this->drain();
+  return theStream->setOrder(order);
+}
+
+int
+AsyncStream::sendSelf(int commitTag, Channel &theChannel)
+{
+  opserr << "AsyncStream::sendSelf() - not available in parallel\n";
+  return -1;
+}
+
+int
+AsyncStream::recvSelf(int commitTag, Channel &theChannel,
+		      FEM_ObjectBroker &theBroker)
+{
+  opserr << "AsyncStream::recvSelf() - not available in parallel\n";
+  return -1;
+}
@@ -0,0 +1,127 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// File: ~/handler/AsyncStream.h
+//
+// Description: This file contains the class definition for AsyncStream.
+// An AsyncStream wraps another OPS_Stream and moves the writing of the
+// data rows to a thread of its own: write(Vector &) only copies the row
+// into the front of two buffers and returns, while the writer thread
+// swaps the buffers and writes the rows of the back one to the wrapped
+// stream. When the front buffer is full, write() waits for the writer to
+// take it, which bounds the memory held to two buffers. Every other call
+// (the xml tags and attributes, text, flush, close) first waits for the
+// rows written before it to reach the wrapped stream, so the output is
+// the same as without the AsyncStream. The rows still buffered are
+// written when the AsyncStream is destroyed with its recorder, i.e. on
+// wipe, and on exit and quit, which wipe the model first.
+// The AsyncStream deletes the stream it wraps.
+
+#ifndef _AsyncStream
+#define _AsyncStream
+
+#include <OPS_Stream.h>
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+class AsyncStream : public OPS_Stream
+{
+ public:
+  AsyncStream(OPS_Stream *theStream, int bufferRows = 256);
+  ~AsyncStream();
+
+  // output format
+  int setFile(const char *fileName, openMode mode = OVERWRITE, bool echo = false);
+  int setPrecision(int precision);
+  int setFloatField(floatField);
+  int precision(int precision);
+  int width(int width);
+
+  // xml stuff
+  int tag(const char *);
+  int tag(const char *, const char *);
+  int endTag();
+  int attr(const char *name, int value);
+  int attr(const char *name, double value);
+  int attr(const char *name, const char *value);
+  int write(Vector &data);
+  int flush();
+  int open(void);
+  int close(openMode nextOpen = APPEND);
+
+  // regular stuff
+  OPS_Stream& write(const char *s, int n);
+  OPS_Stream& write(const unsigned char *s, int n);
+  OPS_Stream& write(const signed char *s, int n);
+  OPS_Stream& write(const void *s, int n);
+  OPS_Stream& write(const double *s, int n);
+
+  OPS_Stream& operator<<(char c);
+  OPS_Stream& operator<<(unsigned char c);
+  OPS_Stream& operator<<(signed char c);
+  OPS_Stream& operator<<(const char *s);
+  OPS_Stream& operator<<(const unsigned char *s);
+  OPS_Stream& operator<<(const signed char *s);
+  OPS_Stream& operator<<(const void *p);
+  OPS_Stream& operator<<(int n);
+  OPS_Stream& operator<<(unsigned int n);
+  OPS_Stream& operator<<(long n);
+  OPS_Stream& operator<<(unsigned long n);
+  OPS_Stream& operator<<(short n);
+  OPS_Stream& operator<<(unsigned short n);
+  OPS_Stream& operator<<(bool b);
+  OPS_Stream& operator<<(double n);
+  OPS_Stream& operator<<(float n);
+
+  // parallel stuff
+  void setAddCommon(int);
+  int setOrder(const ID &order);
+  int sendSelf(int commitTag, Channel &theChannel);
+  int recvSelf(int commitTag, Channel &theChannel,
+	       FEM_ObjectBroker &theBroker);
+
+ private:
+  // a buffer of rows, stored one after the other
+  struct Buffer {
+    std::vector<double> values;
+    std::vector<int> sizes;
+  };
+
+  void work(void);
+  void drain(void);
+
+  OPS_Stream *theStream;
+  int bufferRows;
+
+  Buffer front;                 // filled by write()
+  Buffer back;                  // written by the writer thread
+
+  std::thread writer;
+  std::mutex theMutex;
+  std::condition_variable workCondition;   // rows in front or shutdown
+  std::condition_variable doneCondition;   // front taken or back written
+  bool writing;                 // the writer is writing back
+  bool shutdown;
+};
+
+#endif
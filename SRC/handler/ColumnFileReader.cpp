@@ -0,0 +1,361 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// File: ~/handler/ColumnFileReader.cpp
+//
+// Description: This file contains the implementation of ColumnFileReader.
+
+#include <ColumnFileReader.h>
+#include <ColumnFileStream.h>
+#include <OPS_Globals.h>
+#include <string.h>
+
+using std::ios;
+
+template <typename T> static bool
+readValue(std::ifstream &theFile, T &value)
+{
+  theFile.read((char *)&value, sizeof(T));
+  return theFile.good();
+}
+
+ColumnFileReader::ColumnFileReader()
+ : fileSize(0), flags(0), chunkRows(0),
+   numRows(0), dataStart(0), dataEnd(0)
+{
+
+}
+
+ColumnFileReader::~ColumnFileReader()
+{
+  this->close();
+}
+
+int
+ColumnFileReader::open(const char *fileName)
+{
+  this->close();
+
+  theFile.open(fileName, ios::in | ios::binary);
+  if (!theFile.is_open()) {
+    opserr << "WARNING ColumnFileReader::open() - could not open file ";
+    opserr << fileName << endln;
+    return -1;
+  }
+
+  theFile.seekg(0, ios::end);
+  fileSize = theFile.tellg();
+  theFile.seekg(0, ios::beg);
+
+  // the header
+  char magic[8];
+  unsigned int theVersion, numColumns;
+  theFile.read(magic, 8);
+  if (!theFile.good() || memcmp(magic, ColumnFileStream::headerMagic, 8) != 0) {
+    opserr << "WARNING ColumnFileReader::open() - " << fileName;
+    opserr << " was not written by a ColumnFileStream\n";
+    this->close();
+    return -1;
+  }
+
+  readValue(theFile, theVersion);
+  if (theVersion != ColumnFileStream::version) {
+    opserr << "WARNING ColumnFileReader::open() - " << fileName;
+    if (theVersion == (ColumnFileStream::version << 24))
+      opserr << " was written with the other byte order\n";
+    else
+      opserr << " has unknown version " << (int)theVersion << endln;
+    this->close();
+    return -1;
+  }
+
+  readValue(theFile, flags);
+  readValue(theFile, chunkRows);
+  if (!readValue(theFile, numColumns)) {
+    this->close();
+    return -1;
+  }
+
+  for (unsigned int j=0; j<numColumns; j++) {
+    unsigned int length;
+    if (!readValue(theFile, length) || length > fileSize) {
+      opserr << "WARNING ColumnFileReader::open() - the header of ";
+      opserr << fileName << " is incomplete\n";
+      this->close();
+      return -1;
+    }
+    std::string name(length, ' ');
+    theFile.read(&name[0], length);
+    theColumns.push_back(name);
+  }
+  if (!theFile.good()) {
+    this->close();
+    return -1;
+  }
+  dataStart = theFile.tellg();
+
+  // the chunk index, from the footer or else by reading the chunks
+  if (this->readIndex() != 0)
+    this->scanChunks();
+
+  theFile.clear();
+  return 0;
+}
+
+void
+ColumnFileReader::close(void)
+{
+  if (theFile.is_open())
+    theFile.close();
+  theFile.clear();
+
+  fileSize = 0;
+  flags = 0;
+  chunkRows = 0;
+  theColumns.clear();
+  chunkOffset.clear();
+  chunkFirstRow.clear();
+  chunkNumRows.clear();
+  numRows = 0;
+  dataStart = 0;
+  dataEnd = 0;
+}
+
+int
+ColumnFileReader::getNumColumns(void) const
+{
+  return theColumns.size();
+}
+
+unsigned long long
+ColumnFileReader::getNumRows(void) const
+{
+  return numRows;
+}
+
+const char *
+ColumnFileReader::getColumnName(int col) const
+{
+  if (col < 0 || col >= (int)theColumns.size())
+    return 0;
+  return theColumns[col].c_str();
+}
+
+int
+ColumnFileReader::getColumn(const char *name) const
+{
+  for (size_t j=0; j<theColumns.size(); j++)
+    if (theColumns[j] == name)
+      return j;
+  return -1;
+}
+
+bool
+ColumnFileReader::isCompressed(void) const
+{
+  return (flags & ColumnFileStream::compressedFlag) != 0;
+}
+
+int
+ColumnFileReader::getChunkRows(void) const
+{
+  return chunkRows;
+}
+
+int
+ColumnFileReader::readColumn(int col, std::vector<double> &values,
+			     unsigned long long firstRow,
+			     unsigned long long n)
+{
+  values.clear();
+
+  int numColumns = theColumns.size();
+  if (col < 0 || col >= numColumns) {
+    opserr << "WARNING ColumnFileReader::readColumn() - no column " << col << endln;
+    return -1;
+  }
+
+  if (firstRow >= numRows)
+    return 0;
+  if (n > numRows - firstRow)
+    n = numRows - firstRow;
+  unsigned long long lastRow = firstRow + n;
+
+  values.reserve(n);
+  sizes.resize(numColumns);
+
+  int numChunks = chunkOffset.size();
+  for (int i=0; i<numChunks; i++) {
+    unsigned long long chunkFirst = chunkFirstRow[i];
+    unsigned long long chunkLast = chunkFirst + chunkNumRows[i];
+    if (chunkLast <= firstRow || chunkFirst >= lastRow)
+      continue;
+
+    // skip to the block of the column
+    theFile.seekg(chunkOffset[i] + sizeof(unsigned int), ios::beg);
+    theFile.read((char *)sizes.data(), numColumns*sizeof(unsigned long long));
+    unsigned long long offset = 0;
+    for (int j=0; j<col; j++)
+      offset += sizes[j];
+    theFile.seekg(offset, ios::cur);
+
+    int numChunkRows = chunkNumRows[i];
+    block.resize(numChunkRows);
+    if (this->isCompressed()) {
+      bytes.resize(sizes[col]);
+      theFile.read(bytes.data(), sizes[col]);
+      if (theFile.good() &&
+	  ColumnFileStream::decodeColumn(bytes.data(), sizes[col],
+					 block.data(), numChunkRows) < 0) {
+	opserr << "WARNING ColumnFileReader::readColumn() - chunk " << i;
+	opserr << " is corrupt\n";
+	return -1;
+      }
+    } else
+      theFile.read((char *)block.data(), numChunkRows*sizeof(double));
+
+    if (!theFile.good()) {
+      opserr << "WARNING ColumnFileReader::readColumn() - could not read chunk ";
+      opserr << i << endln;
+      theFile.clear();
+      return -1;
+    }
+
+    unsigned long long start = (firstRow > chunkFirst) ? firstRow - chunkFirst : 0;
+    unsigned long long end = (lastRow < chunkLast) ? lastRow - chunkFirst : numChunkRows;
+    values.insert(values.end(), block.begin() + start, block.begin() + end);
+  }
+
+  return values.size();
+}
+
+int
+ColumnFileReader::getNumChunks(void) const
+{
+  return chunkOffset.size();
+}
+
+unsigned long long
+ColumnFileReader::getChunkOffset(int i) const
+{
+  return chunkOffset[i];
+}
+
+unsigned long long
+ColumnFileReader::getChunkFirstRow(int i) const
+{
+  return chunkFirstRow[i];
+}
+
+unsigned int
+ColumnFileReader::getChunkNumRows(int i) const
+{
+  return chunkNumRows[i];
+}
+
+unsigned long long
+ColumnFileReader::getDataEnd(void) const
+{
+  return dataEnd;
+}
+
+int
+ColumnFileReader::readIndex(void)
+{
+  // the end of the footer: total rows, footer offset and magic
+  const unsigned long long tailSize = 2*sizeof(unsigned long long) + 8;
+  if (fileSize < dataStart + sizeof(unsigned int) + tailSize)
+    return -1;
+
+  unsigned long long theNumRows, footerOffset;
+  char magic[8];
+  theFile.seekg(fileSize - tailSize, ios::beg);
+  readValue(theFile, theNumRows);
+  readValue(theFile, footerOffset);
+  theFile.read(magic, 8);
+  if (!theFile.good() || memcmp(magic, ColumnFileStream::footerMagic, 8) != 0
+      || footerOffset < dataStart || footerOffset >= fileSize)
+    return -1;
+
+  unsigned int numChunks;
+  theFile.seekg(footerOffset, ios::beg);
+  if (!readValue(theFile, numChunks))
+    return -1;
+
+  for (unsigned int i=0; i<numChunks; i++) {
+    unsigned long long offset, firstRow;
+    unsigned int n;
+    readValue(theFile, offset);
+    readValue(theFile, firstRow);
+    if (!readValue(theFile, n)) {
+      chunkOffset.clear();
+      chunkFirstRow.clear();
+      chunkNumRows.clear();
+      return -1;
+    }
+    chunkOffset.push_back(offset);
+    chunkFirstRow.push_back(firstRow);
+    chunkNumRows.push_back(n);
+  }
+
+  numRows = theNumRows;
+  dataEnd = footerOffset;
+  return 0;
+}
+
+int
+ColumnFileReader::scanChunks(void)
+{
+  theFile.clear();
+
+  int numColumns = theColumns.size();
+  sizes.resize(numColumns);
+
+  unsigned long long offset = dataStart;
+  numRows = 0;
+  dataEnd = dataStart;
+
+  while (offset < fileSize) {
+    unsigned int n;
+    theFile.seekg(offset, ios::beg);
+    if (!readValue(theFile, n) || n == 0 || n > chunkRows)
+      break;
+    theFile.read((char *)sizes.data(), numColumns*sizeof(unsigned long long));
+    if (!theFile.good())
+      break;
+
+    unsigned long long end = offset + sizeof(unsigned int)
+      + numColumns*sizeof(unsigned long long);
+    for (int j=0; j<numColumns; j++)
+      end += sizes[j];
+    if (end > fileSize)
+      break;
+
+    chunkOffset.push_back(offset);
+    chunkFirstRow.push_back(numRows);
+    chunkNumRows.push_back(n);
+    numRows += n;
+    offset = end;
+    dataEnd = end;
+  }
+
+  theFile.clear();
+  return 0;
+}
@@ -0,0 +1,88 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// File: ~/handler/ColumnFileReader.h
+//
+// Description: This file contains the class definition for
+// ColumnFileReader. A ColumnFileReader reads the files written by a
+// ColumnFileStream, a column or a range of rows at a time. open() reads
+// the header and the chunk index in the footer; for a file that was not
+// closed, and so has no footer, it finds the chunks by reading their
+// headers in turn, stopping at the first incomplete chunk.
+
+#ifndef ColumnFileReader_h
+#define ColumnFileReader_h
+
+#include <vector>
+#include <string>
+#include <fstream>
+
+class ColumnFileReader
+{
+ public:
+  ColumnFileReader();
+  ~ColumnFileReader();
+
+  int open(const char *fileName);
+  void close(void);
+
+  int getNumColumns(void) const;
+  unsigned long long getNumRows(void) const;
+  const char *getColumnName(int col) const;
+  int getColumn(const char *name) const;    // -1 if there is no such column
+  bool isCompressed(void) const;
+  int getChunkRows(void) const;
+
+  // the values of a column for rows [firstRow, firstRow+numRows), fewer
+  // if the file ends before; returns the number of rows read or -1
+  int readColumn(int col, std::vector<double> &values,
+		 unsigned long long firstRow = 0,
+		 unsigned long long numRows = ~0ULL);
+
+  // the chunk index, used by ColumnFileStream to append to a file
+  int getNumChunks(void) const;
+  unsigned long long getChunkOffset(int i) const;
+  unsigned long long getChunkFirstRow(int i) const;
+  unsigned int getChunkNumRows(int i) const;
+  unsigned long long getDataEnd(void) const;
+
+ private:
+  int readIndex(void);
+  int scanChunks(void);
+
+  std::ifstream theFile;
+  unsigned long long fileSize;
+  unsigned int flags;
+  unsigned int chunkRows;
+  std::vector<std::string> theColumns;
+
+  std::vector<unsigned long long> chunkOffset;
+  std::vector<unsigned long long> chunkFirstRow;
+  std::vector<unsigned int> chunkNumRows;
+  unsigned long long numRows;
+  unsigned long long dataStart;   // offset of the first chunk
+  unsigned long long dataEnd;     // offset of the end of the last chunk
+
+  std::vector<unsigned long long> sizes;
+  std::vector<char> bytes;
+  std::vector<double> block;
+};
+
+#endif
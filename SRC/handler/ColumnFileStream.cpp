@@ -0,0 +1,515 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// File: ~/handler/ColumnFileStream.cpp
+//
+// Description: This file contains the implementation of ColumnFileStream.
+
+#include <ColumnFileStream.h>
+#include <ColumnFileReader.h>
+#include <Vector.h>
+#include <string.h>
+#include <stdio.h>
+
+using std::ios;
+
+const char ColumnFileStream::headerMagic[9] = "OPSCOL01";
+const char ColumnFileStream::footerMagic[9] = "OPSCOLIX";
+
+template <typename T> static void
+writeValue(std::fstream &theFile, T value)
+{
+  theFile.write((const char *)&value, sizeof(T));
+}
+
+ColumnFileStream::ColumnFileStream(const char *name, openMode mode,
+				   bool compressIt, int rows)
+ : OPS_Stream(OPS_STREAM_TAGS_ColumnFileStream),
+   fileOpen(0), theOpenMode(mode),
+   compress(compressIt), chunkRows(rows),
+   headerWritten(false), warnedSize(false), warnedText(false),
+   numChunkRows(0), numRows(0), dataEnd(0)
+{
+  if (chunkRows < 1)
+    chunkRows = 1024;
+
+  if (name != 0)
+    this->setFile(name, mode);
+}
+
+ColumnFileStream::~ColumnFileStream()
+{
+  this->close();
+}
+
+int
+ColumnFileStream::setFile(const char *name, openMode mode, bool echo)
+{
+  if (name == 0) {
+    opserr << "ColumnFileStream::setFile() - no name passed\n";
+    return -1;
+  }
+
+  // finish the current file
+  if (fileOpen == 1)
+    this->close();
+
+  if (fileName != name) {
+    this->clearIndex();
+    fileName = name;
+  }
+  theOpenMode = mode;
+
+  return 0;
+}
+
+int
+ColumnFileStream::open(void)
+{
+  if (fileName.empty()) {
+    opserr << "ColumnFileStream::open() - no file name has been set\n";
+    return -1;
+  }
+
+  if (fileOpen == 1)
+    return 0;
+
+  // to append to a file this stream did not write, read its index
+  if (theOpenMode == APPEND && headerWritten == false)
+    if (this->readIndex() != 0)
+      theOpenMode = OVERWRITE;
+
+  if (theOpenMode == OVERWRITE) {
+    this->clearIndex();
+    theFile.open(fileName.c_str(), ios::out | ios::trunc | ios::binary);
+  } else
+    theFile.open(fileName.c_str(), ios::in | ios::out | ios::binary);
+
+  theOpenMode = APPEND;
+
+  if (!theFile.is_open() || theFile.bad()) {
+    opserr << "WARNING - ColumnFileStream::open()";
+    opserr << " - could not open file " << fileName.c_str() << endln;
+    fileOpen = 0;
+    return -1;
+  }
+
+  fileOpen = 1;
+  return 0;
+}
+
+int
+ColumnFileStream::close(openMode nextOpen)
+{
+  if (fileOpen == 1) {
+    if (headerWritten == true) {
+      this->writeChunk();
+      this->writeFooter();
+    }
+    theFile.close();
+    fileOpen = 0;
+  }
+
+  theOpenMode = nextOpen;
+  return 0;
+}
+
+int
+ColumnFileStream::flush(void)
+{
+  // the rows of a partly filled chunk stay buffered, writing them would
+  // leave a small chunk each time a recorder flushes
+  if (fileOpen == 1)
+    theFile.flush();
+  return 0;
+}
+
+int
+ColumnFileStream::tag(const char *tagName)
+{
+  openTags.push_back(tagName);
+  openAttrs.push_back(std::string());
+  return 0;
+}
+
+int
+ColumnFileStream::tag(const char *tagName, const char *value)
+{
+  if (headerWritten == true)
+    return 0;
+
+  // a tag with a value names a column: the path of the open tags and
+  // their attributes, then the value
+  std::string name;
+  for (size_t i=0; i<openTags.size(); i++) {
+    if (openTags[i] == "Data")
+      continue;
+    name += openTags[i];
+    if (!openAttrs[i].empty())
+      name += "[" + openAttrs[i] + "]";
+    name += "/";
+  }
+  name += value;
+
+  theColumns.push_back(name);
+  return 0;
+}
+
+int
+ColumnFileStream::endTag()
+{
+  if (!openTags.empty()) {
+    openTags.pop_back();
+    openAttrs.pop_back();
+  }
+  return 0;
+}
+
+int
+ColumnFileStream::attr(const char *name, int value)
+{
+  char buffer[24];
+  sprintf(buffer, "%d", value);
+  return this->attr(name, buffer);
+}
+
+int
+ColumnFileStream::attr(const char *name, double value)
+{
+  // real attributes are coordinates and the like, not part of the name
+  return 0;
+}
+
+int
+ColumnFileStream::attr(const char *name, const char *value)
+{
+  if (openAttrs.empty())
+    return 0;
+
+  std::string &attrs = openAttrs.back();
+  if (!attrs.empty())
+    attrs += ",";
+  attrs += name;
+  attrs += "=";
+  attrs += value;
+  return 0;
+}
+
+int
+ColumnFileStream::write(Vector &data)
+{
+  int n = data.Size();
+  if (this->addRow(0, n) != 0)
+    return -1;
+
+  // place the row in the chunk
+  int numColumns = theColumns.size();
+  double *row = chunk.data() + numChunkRows;
+  for (int j=0; j<numColumns; j++)
+    row[j*chunkRows] = (j < n) ? data(j) : 0.0;
+
+  numChunkRows++;
+  numRows++;
+  if (numChunkRows == chunkRows)
+    return this->writeChunk();
+
+  return 0;
+}
+
+OPS_Stream&
+ColumnFileStream::write(const double *s, int n)
+{
+  if (this->addRow(s, n) != 0)
+    return *this;
+
+  int numColumns = theColumns.size();
+  double *row = chunk.data() + numChunkRows;
+  for (int j=0; j<numColumns; j++)
+    row[j*chunkRows] = (j < n) ? s[j] : 0.0;
+
+  numChunkRows++;
+  numRows++;
+  if (numChunkRows == chunkRows)
+    this->writeChunk();
+
+  return *this;
+}
+
+OPS_Stream&
+ColumnFileStream::write(const char *s, int n)
+{
+  this->dropText(s, n);
+  return *this;
+}
+
+OPS_Stream&
+ColumnFileStream::operator<<(const char *s)
+{
+  if (s != 0)
+    this->dropText(s, strlen(s));
+  return *this;
+}
+
+int
+ColumnFileStream::sendSelf(int commitTag, Channel &theChannel)
+{
+  opserr << "ColumnFileStream::sendSelf() - not available in parallel\n";
+  return -1;
+}
+
+int
+ColumnFileStream::recvSelf(int commitTag, Channel &theChannel,
+			   FEM_ObjectBroker &theBroker)
+{
+  opserr << "ColumnFileStream::recvSelf() - not available in parallel\n";
+  return -1;
+}
+
+int
+ColumnFileStream::addRow(const double *values, int n)
+{
+  if (fileOpen == 0)
+    if (this->open() != 0)
+      return -1;
+
+  // the columns are fixed by the first row
+  if (headerWritten == false) {
+    if (theColumns.empty()) {
+      char buffer[24];
+      for (int j=0; j<n; j++) {
+	sprintf(buffer, "%d", j+1);
+	theColumns.push_back(buffer);
+      }
+    }
+    if (this->writeHeader() != 0)
+      return -1;
+  }
+
+  if (n != (int)theColumns.size() && warnedSize == false) {
+    opserr << "WARNING ColumnFileStream::write() - row of " << n;
+    opserr << " values for " << (int)theColumns.size() << " columns in ";
+    opserr << fileName.c_str() << ", rows are cut or padded with 0\n";
+    warnedSize = true;
+  }
+
+  if (chunk.size() != theColumns.size()*chunkRows)
+    chunk.assign(theColumns.size()*chunkRows, 0.0);
+
+  return 0;
+}
+
+int
+ColumnFileStream::writeHeader(void)
+{
+  theFile.seekp(0, ios::beg);
+  theFile.write(headerMagic, 8);
+
+  unsigned int flags = (compress == true) ? compressedFlag : 0;
+  writeValue<unsigned int>(theFile, version);
+  writeValue<unsigned int>(theFile, flags);
+  writeValue<unsigned int>(theFile, chunkRows);
+  writeValue<unsigned int>(theFile, theColumns.size());
+
+  for (const std::string &name : theColumns) {
+    writeValue<unsigned int>(theFile, name.size());
+    theFile.write(name.data(), name.size());
+  }
+
+  if (theFile.bad()) {
+    opserr << "WARNING ColumnFileStream - could not write the header of ";
+    opserr << fileName.c_str() << endln;
+    return -1;
+  }
+
+  dataEnd = theFile.tellp();
+  headerWritten = true;
+  return 0;
+}
+
+int
+ColumnFileStream::writeChunk(void)
+{
+  if (numChunkRows == 0)
+    return 0;
+
+  int numColumns = theColumns.size();
+
+  // form the column blocks
+  std::vector<unsigned long long> sizes(numColumns);
+  bytes.clear();
+  for (int j=0; j<numColumns; j++) {
+    const double *column = chunk.data() + j*chunkRows;
+    size_t start = bytes.size();
+    if (compress == true)
+      encodeColumn(column, numChunkRows, bytes);
+    else
+      bytes.insert(bytes.end(), (const char *)column,
+		   (const char *)(column + numChunkRows));
+    sizes[j] = bytes.size() - start;
+  }
+
+  theFile.seekp(dataEnd, ios::beg);
+  chunkOffset.push_back(dataEnd);
+  chunkFirstRow.push_back(numRows - numChunkRows);
+  chunkNumRows.push_back(numChunkRows);
+
+  writeValue<unsigned int>(theFile, numChunkRows);
+  theFile.write((const char *)sizes.data(), numColumns*sizeof(unsigned long long));
+  theFile.write(bytes.data(), bytes.size());
+
+  numChunkRows = 0;
+
+  if (theFile.bad()) {
+    opserr << "WARNING ColumnFileStream - could not write to ";
+    opserr << fileName.c_str() << endln;
+    return -1;
+  }
+
+  dataEnd = theFile.tellp();
+  return 0;
+}
+
+int
+ColumnFileStream::writeFooter(void)
+{
+  theFile.seekp(dataEnd, ios::beg);
+
+  unsigned int numChunks = chunkOffset.size();
+  writeValue<unsigned int>(theFile, numChunks);
+  for (unsigned int i=0; i<numChunks; i++) {
+    writeValue<unsigned long long>(theFile, chunkOffset[i]);
+    writeValue<unsigned long long>(theFile, chunkFirstRow[i]);
+    writeValue<unsigned int>(theFile, chunkNumRows[i]);
+  }
+  writeValue<unsigned long long>(theFile, numRows);
+  writeValue<unsigned long long>(theFile, dataEnd);
+  theFile.write(footerMagic, 8);
+
+  return theFile.bad() ? -1 : 0;
+}
+
+int
+ColumnFileStream::readIndex(void)
+{
+  ColumnFileReader theReader;
+  if (theReader.open(fileName.c_str()) != 0)
+    return -1;
+
+  this->clearIndex();
+
+  theColumns.clear();
+  int numColumns = theReader.getNumColumns();
+  for (int j=0; j<numColumns; j++)
+    theColumns.push_back(theReader.getColumnName(j));
+  compress = theReader.isCompressed();
+  chunkRows = theReader.getChunkRows();
+
+  int numChunks = theReader.getNumChunks();
+  for (int i=0; i<numChunks; i++) {
+    chunkOffset.push_back(theReader.getChunkOffset(i));
+    chunkFirstRow.push_back(theReader.getChunkFirstRow(i));
+    chunkNumRows.push_back(theReader.getChunkNumRows(i));
+  }
+  numRows = theReader.getNumRows();
+  dataEnd = theReader.getDataEnd();
+  headerWritten = true;
+
+  return 0;
+}
+
+// text has no column to go to; white space, e.g. the line ends some
+// recorders write after each row, is dropped quietly
+void
+ColumnFileStream::dropText(const char *s, int n)
+{
+  if (warnedText == true)
+    return;
+
+  for (int i=0; i<n; i++) {
+    if (s[i] != ' ' && s[i] != '\t' && s[i] != '\n' && s[i] != '\r') {
+      opserr << "WARNING ColumnFileStream - text written to " << fileName.c_str();
+      opserr << " is not stored, only the rows of numbers are\n";
+      warnedText = true;
+      return;
+    }
+  }
+}
+
+void
+ColumnFileStream::clearIndex(void)
+{
+  headerWritten = false;
+  warnedSize = false;
+  numChunkRows = 0;
+  chunkOffset.clear();
+  chunkFirstRow.clear();
+  chunkNumRows.clear();
+  numRows = 0;
+  dataEnd = 0;
+}
+
+void
+ColumnFileStream::encodeColumn(const double *values, int n, std::vector<char> &bytes)
+{
+  unsigned long long previous = 0;
+  for (int i=0; i<n; i++) {
+    unsigned long long bits;
+    memcpy(&bits, &values[i], 8);
+    unsigned long long x = bits ^ previous;
+    previous = bits;
+
+    // numbers of zero bytes at the top and bottom of x
+    int lead = 0;
+    while (lead < 8 && ((x >> (56 - 8*lead)) & 0xff) == 0)
+      lead++;
+    int trail = 0;
+    if (lead < 8)
+      while (((x >> (8*trail)) & 0xff) == 0)
+	trail++;
+
+    bytes.push_back((char)((lead << 4) | trail));
+    for (int b=trail; b<8-lead; b++)
+      bytes.push_back((char)((x >> (8*b)) & 0xff));
+  }
+}
+
+int
+ColumnFileStream::decodeColumn(const char *bytes, int numBytes, double *values, int n)
+{
+  unsigned long long previous = 0;
+  int loc = 0;
+  for (int i=0; i<n; i++) {
+    if (loc >= numBytes)
+      return -1;
+    unsigned char control = bytes[loc++];
+    int lead = control >> 4;
+    int trail = control & 0x0f;
+    if (lead + trail > 8 || loc + 8 - lead - trail > numBytes)
+      return -1;
+
+    unsigned long long x = 0;
+    for (int b=trail; b<8-lead; b++)
+      x |= (unsigned long long)(unsigned char)bytes[loc++] << (8*b);
+
+    previous ^= x;
+    memcpy(&values[i], &previous, 8);
+  }
+  return loc;
+}
@@ -0,0 +1,139 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// File: ~/handler/ColumnFileStream.h
+//
+// Description: This file contains the class definition for
+// ColumnFileStream. A ColumnFileStream writes the rows given to write()
+// to a binary file organised by columns, so that a reader can get some of
+// the columns of a large output without reading the others. The file is
+// self describing:
+//
+//   header   "OPSCOL01", version, flags, rows per chunk, number of columns,
+//            and the name of each column (length and characters)
+//   chunks   number of rows, the size in bytes of each column block, then
+//            the column blocks, each holding the values of one column for
+//            the rows of the chunk
+//   footer   number of chunks, the offset, first row and number of rows of
+//            each chunk, the total number of rows, the offset of the
+//            footer and "OPSCOLIX"
+//
+// All numbers are stored in the byte order of the writer; the version
+// number doubles as a byte order mark. The column names are formed from
+// the tag() and attr() calls the recorders make for the xml output, e.g.
+// "NodeOutput[nodeTag=3]/disp1", the names of the open tags and their int
+// and string attributes followed by the value of the innermost tag. With
+// compression each value of a column is stored as the exclusive or with
+// the previous value of the column, less its leading and trailing zero
+// bytes, after a control byte giving their numbers; constant and slowly
+// varying columns then take from one to a few bytes per value. A file
+// that was not closed has no footer; ColumnFileReader then finds the
+// chunks by reading them in turn.
+
+#ifndef _ColumnFileStream
+#define _ColumnFileStream
+
+#include <OPS_Stream.h>
+
+#include <vector>
+#include <string>
+#include <fstream>
+
+class ColumnFileStream : public OPS_Stream
+{
+ public:
+  ColumnFileStream(const char *fileName = 0, openMode mode = OVERWRITE,
+		   bool compress = false, int chunkRows = 1024);
+  ~ColumnFileStream();
+
+  int setFile(const char *fileName, openMode mode = OVERWRITE, bool echo = false);
+  int open(void);
+  int close(openMode nextOpen = APPEND);
+  int flush(void);
+
+  // xml stuff, used for the column names
+  int tag(const char *);
+  int tag(const char *, const char *);
+  int endTag();
+  int attr(const char *name, int value);
+  int attr(const char *name, double value);
+  int attr(const char *name, const char *value);
+  int write(Vector &data);
+
+  // regular stuff; rows of doubles are data, text is not stored and a
+  // warning is given the first time any is written
+  OPS_Stream& write(const double *s, int n);
+  OPS_Stream& write(const char *s, int n);
+  OPS_Stream& operator<<(const char *s);
+  using OPS_Stream::write;
+  using OPS_Stream::operator<<;
+
+  int sendSelf(int commitTag, Channel &theChannel);
+  int recvSelf(int commitTag, Channel &theChannel,
+	       FEM_ObjectBroker &theBroker);
+
+  // the layout of the file, shared with ColumnFileReader
+  static const char headerMagic[9];
+  static const char footerMagic[9];
+  static const unsigned int version = 1;
+  static const unsigned int compressedFlag = 1;
+
+  static void encodeColumn(const double *values, int n, std::vector<char> &bytes);
+  static int decodeColumn(const char *bytes, int numBytes, double *values, int n);
+
+ private:
+  int addRow(const double *values, int n);
+  int writeHeader(void);
+  int writeChunk(void);
+  int writeFooter(void);
+  int readIndex(void);
+  void clearIndex(void);
+  void dropText(const char *s, int n);
+
+  std::fstream theFile;
+  int fileOpen;
+  openMode theOpenMode;
+  std::string fileName;
+
+  bool compress;
+  int chunkRows;
+
+  // column names, formed from the tags until the first row is written
+  std::vector<std::string> theColumns;
+  std::vector<std::string> openTags;
+  std::vector<std::string> openAttrs;
+  bool headerWritten;
+  bool warnedSize;
+  bool warnedText;
+
+  // the rows of the current chunk, stored by column
+  std::vector<double> chunk;
+  int numChunkRows;
+  std::vector<char> bytes;
+
+  // the index of the chunks written
+  std::vector<unsigned long long> chunkOffset;
+  std::vector<unsigned long long> chunkFirstRow;
+  std::vector<unsigned int> chunkNumRows;
+  unsigned long long numRows;
+  unsigned long long dataEnd;     // offset of the end of the last chunk
+};
+
+#endif
@@ -137,6 +137,13 @@ class Matrix
 
     int Eigen3(const Matrix &M);
 
+    // products needing at least numMults multiply-adds are passed to the
+    // BLAS dgemm/dgemv routines, smaller ones use the loops in this class;
+    // 0 sends every product to the BLAS, a negative value none of them.
+    // the initial value may be set with the OPS_BLAS_THRESHOLD variable.
+    static void setBlasThreshold(int numMults);
+    static int getBlasThreshold(void);
+
     friend OPS_Stream &operator<<(OPS_Stream &s, const Matrix &M);
     //    friend istream &operator>>(istream &s, Matrix &M);    
     friend Matrix operator*(double a, const Matrix &M);
@@ -155,11 +162,16 @@ class Matrix
   protected:
 
   private:
+    int tripleProductFixed(double thisFact, const Matrix &T, const Matrix &B, double otherFact);
+
+    // work areas of the calling thread, grown to at least size
+    static double *getDoubleWork(int size, int *sizeWork = 0);
+    static int *getIntWork(int size);
+
+    static inline bool useBlas(int numMults);
+    static int blasThreshold;
+
     static double MATRIX_NOT_VALID_ENTRY;
-    static double *matrixWork;
-    static int *intWork;
-    static int sizeDoubleWork;
-    static int sizeIntWork;
 
     int numRows;
     int numCols;
@@ -170,6 +182,12 @@ class Matrix
 
 
 /********* INLINED MATRIX FUNCTIONS ***********/
+inline bool
+Matrix::useBlas(int numMults)
+{
+  return blasThreshold >= 0 && numMults >= blasThreshold;
+}
+
 inline int 
 Matrix::noRows() const 
 {
@@ -0,0 +1,275 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// File: ~/matrix/MatrixND.h
+//
+// Description: This file contains the definition of MatrixND, an NR x NC
+// matrix whose size is known at compile time, the counterpart of
+// VectorND. The entries are held in the object itself in column order,
+// as in Matrix, so that a MatrixND converts to a Matrix viewing its
+// entries and can be passed wherever a const Matrix & is expected. The
+// methods follow those of Matrix, with the sizes of the operands checked
+// by the compiler instead of at run time.
+
+#ifndef MatrixND_h
+#define MatrixND_h
+
+#include <Matrix.h>
+#include <VectorND.h>
+
+namespace OpenSees {
+
+template <int NR, int NC>
+struct MatrixND
+{
+  double values[NC][NR];      // values[j][i] is entry (i,j)
+
+  // utility methods
+  constexpr int
+  noRows(void) const
+  {
+    return NR;
+  }
+
+  constexpr int
+  noCols(void) const
+  {
+    return NC;
+  }
+
+  void
+  Zero(void)
+  {
+    for (int j=0; j<NC; j++)
+      for (int i=0; i<NR; i++)
+	values[j][i] = 0.0;
+  }
+
+  MatrixND<NC, NR>
+  transpose(void) const
+  {
+    MatrixND<NC, NR> result;
+    for (int j=0; j<NC; j++)
+      for (int i=0; i<NR; i++)
+	result.values[i][j] = values[j][i];
+    return result;
+  }
+
+  // this = this * thisFact + other * otherFact
+  int
+  addMatrix(double thisFact, const MatrixND<NR, NC> &other, double otherFact)
+  {
+    if (thisFact == 0.0) {
+      for (int j=0; j<NC; j++)
+	for (int i=0; i<NR; i++)
+	  values[j][i] = other.values[j][i]*otherFact;
+    } else {
+      for (int j=0; j<NC; j++)
+	for (int i=0; i<NR; i++)
+	  values[j][i] = values[j][i]*thisFact + other.values[j][i]*otherFact;
+    }
+    return 0;
+  }
+
+  // this = this * thisFact + other' * otherFact
+  int
+  addMatrixTranspose(double thisFact, const MatrixND<NC, NR> &other, double otherFact)
+  {
+    this->scale(thisFact);
+    for (int j=0; j<NC; j++)
+      for (int i=0; i<NR; i++)
+	values[j][i] += other.values[i][j]*otherFact;
+    return 0;
+  }
+
+  // this = this * thisFact + A * B * otherFact
+  template <int NK>
+  int
+  addMatrixProduct(double thisFact, const MatrixND<NR, NK> &A,
+		   const MatrixND<NK, NC> &B, double otherFact)
+  {
+    this->scale(thisFact);
+    for (int j=0; j<NC; j++)
+      for (int k=0; k<NK; k++) {
+	double bkj = B.values[j][k]*otherFact;
+	for (int i=0; i<NR; i++)
+	  values[j][i] += A.values[k][i]*bkj;
+      }
+    return 0;
+  }
+
+  // this = this * thisFact + A' * B * otherFact
+  template <int NK>
+  int
+  addMatrixTransposeProduct(double thisFact, const MatrixND<NK, NR> &A,
+			    const MatrixND<NK, NC> &B, double otherFact)
+  {
+    this->scale(thisFact);
+    for (int j=0; j<NC; j++)
+      for (int i=0; i<NR; i++) {
+	double sum = 0.0;
+	for (int k=0; k<NK; k++)
+	  sum += A.values[i][k]*B.values[j][k];
+	values[j][i] += sum*otherFact;
+      }
+    return 0;
+  }
+
+  // this = this * thisFact + T' * B * T * otherFact
+  template <int NK>
+  int
+  addMatrixTripleProduct(double thisFact, const MatrixND<NK, NR> &T,
+			 const MatrixND<NK, NK> &B, double otherFact)
+  {
+    static_assert(NR == NC, "MatrixND::addMatrixTripleProduct() needs a square result");
+    MatrixND<NK, NC> BT;
+    BT.addMatrixProduct(0.0, B, T, otherFact);
+    return this->addMatrixTransposeProduct(thisFact, T, BT, 1.0);
+  }
+
+  // add M * fact into the block starting at (initRow, initCol)
+  template <int MR, int MC>
+  int
+  Assemble(const MatrixND<MR, MC> &M, int initRow, int initCol, double fact = 1.0)
+  {
+    for (int j=0; j<MC; j++)
+      for (int i=0; i<MR; i++)
+	values[initCol+j][initRow+i] += M.values[j][i]*fact;
+    return 0;
+  }
+
+  // add M' * fact into the block starting at (initRow, initCol)
+  template <int MR, int MC>
+  int
+  AssembleTranspose(const MatrixND<MR, MC> &M, int initRow, int initCol, double fact = 1.0)
+  {
+    for (int j=0; j<MC; j++)
+      for (int i=0; i<MR; i++)
+	values[initCol+i][initRow+j] += M.values[j][i]*fact;
+    return 0;
+  }
+
+  // overloaded operators
+  double &
+  operator()(int row, int col)
+  {
+    return values[col][row];
+  }
+
+  double
+  operator()(int row, int col) const
+  {
+    return values[col][row];
+  }
+
+  MatrixND<NR, NC> &
+  operator=(const Matrix &other)
+  {
+    for (int j=0; j<NC; j++)
+      for (int i=0; i<NR; i++)
+	values[j][i] = other(i,j);
+    return *this;
+  }
+
+  // a Matrix viewing the entries of this MatrixND
+  operator Matrix()
+  {
+    return Matrix(&values[0][0], NR, NC);
+  }
+
+  operator const Matrix() const
+  {
+    return Matrix(const_cast<double *>(&values[0][0]), NR, NC);
+  }
+
+  MatrixND<NR, NC> &
+  operator+=(const MatrixND<NR, NC> &other)
+  {
+    this->addMatrix(1.0, other, 1.0);
+    return *this;
+  }
+
+  MatrixND<NR, NC> &
+  operator-=(const MatrixND<NR, NC> &other)
+  {
+    this->addMatrix(1.0, other, -1.0);
+    return *this;
+  }
+
+  MatrixND<NR, NC> &
+  operator*=(double fact)
+  {
+    for (int j=0; j<NC; j++)
+      for (int i=0; i<NR; i++)
+	values[j][i] *= fact;
+    return *this;
+  }
+
+  MatrixND<NR, NC> &
+  operator/=(double fact)
+  {
+    for (int j=0; j<NC; j++)
+      for (int i=0; i<NR; i++)
+	values[j][i] /= fact;
+    return *this;
+  }
+
+  VectorND<NR>
+  operator*(const VectorND<NC> &v) const
+  {
+    VectorND<NR> result;
+    result.addMatrixVector(0.0, *this, v, 1.0);
+    return result;
+  }
+
+  template <int NK>
+  MatrixND<NR, NK>
+  operator*(const MatrixND<NC, NK> &M) const
+  {
+    MatrixND<NR, NK> result;
+    result.addMatrixProduct(0.0, *this, M, 1.0);
+    return result;
+  }
+
+  friend OPS_Stream &
+  operator<<(OPS_Stream &s, const MatrixND<NR, NC> &M)
+  {
+    for (int i=0; i<NR; i++) {
+      for (int j=0; j<NC; j++)
+	s << M.values[j][i] << " ";
+      s << endln;
+    }
+    return s;
+  }
+
+ private:
+  void
+  scale(double fact)
+  {
+    if (fact == 0.0)
+      this->Zero();
+    else if (fact != 1.0)
+      *this *= fact;
+  }
+};
+
+} // namespace OpenSees
+
+#endif
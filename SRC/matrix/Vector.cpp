@@ -41,6 +41,32 @@ using std::nothrow;
 
 double Vector::VECTOR_NOT_VALID_ENTRY =0.0;
 
+#ifdef _WIN32
+extern "C" int  DGEMV(char *TRANS, unsigned int sizeT, int *M, int *N,
+			      double *ALPHA, double *A, int *LDA, double *X,
+			      int *INCX, double *BETA, double *Y, int *INCY);
+#else
+extern "C" int dgemv_(char *TRANS, int *M, int *N, double *ALPHA, double *A,
+		      int *LDA, double *X, int *INCX, double *BETA, double *Y,
+		      int *INCY);
+#endif
+
+// y = A * x * alpha + y * beta, with A (m by n, column major) transposed if
+// trans is 'T'. as in the loops below y is not read when beta is 0.
+static void
+blasMatrixVector(char trans, int m, int n, double alpha, const double *A,
+		 const double *x, double beta, double *y)
+{
+  int inc = 1;
+#ifdef _WIN32
+  DGEMV(&trans, 1, &m, &n, &alpha, (double *)A, &m, (double *)x, &inc,
+	&beta, y, &inc);
+#else
+  dgemv_(&trans, &m, &n, &alpha, (double *)A, &m, (double *)x, &inc,
+	 &beta, y, &inc);
+#endif
+}
+
 // Vector():
 //	Standard constructor, sets size = 0;
 
@@ -119,7 +145,7 @@ Vector::Vector(const Vector &other)
 //  Move constructor
 #ifdef USE_CXX11   
 Vector::Vector(Vector &&other)
-: sz(other.sz),theData(other.theData),fromFree(0)
+: sz(other.sz),theData(other.theData),fromFree(other.fromFree)
 {
   //opserr << "move ctor!\n";
   other.theData = 0;
@@ -342,6 +368,12 @@ Vector::addMatrixVector(double thisFact, const Matrix &m, const Vector &v, doubl
   }
 #endif
 
+  if (sz > 0 && v.sz > 0 && Matrix::useBlas(sz * v.sz)) {
+    blasMatrixVector('N', sz, v.sz, otherFact, m.data, v.theData, 
+		     thisFact, theData);
+    return 0;
+  }
+
   if (thisFact == 1.0) {
 
     // want: this += m * v * otherFact
@@ -475,6 +507,12 @@ Vector::addMatrixTransposeVector(double thisFact,
   }
 #endif
 
+  if (sz > 0 && v.sz > 0 && Matrix::useBlas(sz * v.sz)) {
+    blasMatrixVector('T', v.sz, sz, otherFact, m.data, v.theData, 
+		     thisFact, theData);
+    return 0;
+  }
+
   if (thisFact == 1.0) {
 
     // want: this += m^t * v * otherFact
@@ -764,6 +802,11 @@ Vector::operator=(Vector &&V)
 {
   // first check we are not trying v = v
   if (this != &V) {
+    // the data of a Vector viewing storage it does not own is copied,
+    // not taken over
+    if (fromFree != 0 || V.fromFree != 0)
+      return *this = V;
+
     // opserr << "move assign!\n";
     if (this->theData != 0){ 
       delete [] this->theData;
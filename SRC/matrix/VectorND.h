@@ -0,0 +1,271 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// File: ~/matrix/VectorND.h
+//
+// Description: This file contains the definition of VectorND, a vector
+// whose size N is known at compile time. The entries are held in the
+// object itself, so a VectorND is created on the stack without a call
+// to new, and the loops over the entries have a fixed trip count the
+// compiler can unroll and vectorize. It is meant for the 3, 4, 6 and 12
+// component temporaries of the coordinate transformations and sections,
+// where a static Vector would make the method non-reentrant.
+//
+// A VectorND is an aggregate, so it can be initialized with braces, e.g.
+// VectorND<3> x {1.0, 0.0, 0.0}; it is left uninitialized otherwise. The
+// methods follow those of Vector. It converts to a Vector that views its
+// entries, so it can be passed wherever a const Vector & is expected, and
+// it can be assigned from a Vector of the same size.
+
+#ifndef VectorND_h
+#define VectorND_h
+
+#include <math.h>
+#include <Vector.h>
+
+namespace OpenSees {
+
+template <int NR, int NC> struct MatrixND;
+
+template <int N>
+struct VectorND
+{
+  double values[N];
+
+  // utility methods
+  constexpr int
+  Size(void) const
+  {
+    return N;
+  }
+
+  void
+  Zero(void)
+  {
+    for (int i=0; i<N; i++)
+      values[i] = 0.0;
+  }
+
+  double
+  Norm(void) const
+  {
+    return sqrt(this->dot(*this));
+  }
+
+  double
+  dot(const VectorND<N> &other) const
+  {
+    double sum = 0.0;
+    for (int i=0; i<N; i++)
+      sum += values[i]*other.values[i];
+    return sum;
+  }
+
+  // the cross product, defined for N = 3 only
+  VectorND<N>
+  cross(const VectorND<N> &other) const
+  {
+    static_assert(N == 3, "VectorND::cross() needs three components");
+    VectorND<N> result;
+    result.values[0] = values[1]*other.values[2] - values[2]*other.values[1];
+    result.values[1] = values[2]*other.values[0] - values[0]*other.values[2];
+    result.values[2] = values[0]*other.values[1] - values[1]*other.values[0];
+    return result;
+  }
+
+  // this = this * thisFact + other * otherFact
+  int
+  addVector(double thisFact, const VectorND<N> &other, double otherFact)
+  {
+    if (thisFact == 0.0) {
+      for (int i=0; i<N; i++)
+	values[i] = other.values[i]*otherFact;
+    } else {
+      for (int i=0; i<N; i++)
+	values[i] = values[i]*thisFact + other.values[i]*otherFact;
+    }
+    return 0;
+  }
+
+  // this = this * thisFact + m * v * otherFact
+  template <int NC>
+  int
+  addMatrixVector(double thisFact, const MatrixND<N, NC> &m,
+		  const VectorND<NC> &v, double otherFact)
+  {
+    if (thisFact == 0.0)
+      this->Zero();
+    else if (thisFact != 1.0)
+      for (int i=0; i<N; i++)
+	values[i] *= thisFact;
+
+    for (int j=0; j<NC; j++) {
+      double vj = v.values[j]*otherFact;
+      for (int i=0; i<N; i++)
+	values[i] += m.values[j][i]*vj;
+    }
+    return 0;
+  }
+
+  // this = this * thisFact + m' * v * otherFact
+  template <int NR>
+  int
+  addMatrixTransposeVector(double thisFact, const MatrixND<NR, N> &m,
+			   const VectorND<NR> &v, double otherFact)
+  {
+    for (int j=0; j<N; j++) {
+      double sum = 0.0;
+      for (int i=0; i<NR; i++)
+	sum += m.values[j][i]*v.values[i];
+      if (thisFact == 0.0)
+	values[j] = sum*otherFact;
+      else
+	values[j] = values[j]*thisFact + sum*otherFact;
+    }
+    return 0;
+  }
+
+  // overloaded operators
+  double &
+  operator()(int i)
+  {
+    return values[i];
+  }
+
+  double
+  operator()(int i) const
+  {
+    return values[i];
+  }
+
+  double &
+  operator[](int i)
+  {
+    return values[i];
+  }
+
+  double
+  operator[](int i) const
+  {
+    return values[i];
+  }
+
+  VectorND<N> &
+  operator=(const Vector &other)
+  {
+    for (int i=0; i<N; i++)
+      values[i] = other(i);
+    return *this;
+  }
+
+  // a Vector viewing the entries of this VectorND
+  operator Vector()
+  {
+    return Vector(values, N);
+  }
+
+  operator const Vector() const
+  {
+    return Vector(const_cast<double *>(values), N);
+  }
+
+  VectorND<N> &
+  operator+=(const VectorND<N> &other)
+  {
+    for (int i=0; i<N; i++)
+      values[i] += other.values[i];
+    return *this;
+  }
+
+  VectorND<N> &
+  operator-=(const VectorND<N> &other)
+  {
+    for (int i=0; i<N; i++)
+      values[i] -= other.values[i];
+    return *this;
+  }
+
+  VectorND<N> &
+  operator*=(double fact)
+  {
+    for (int i=0; i<N; i++)
+      values[i] *= fact;
+    return *this;
+  }
+
+  VectorND<N> &
+  operator/=(double fact)
+  {
+    for (int i=0; i<N; i++)
+      values[i] /= fact;
+    return *this;
+  }
+
+  VectorND<N>
+  operator+(const VectorND<N> &other) const
+  {
+    VectorND<N> result(*this);
+    result += other;
+    return result;
+  }
+
+  VectorND<N>
+  operator-(const VectorND<N> &other) const
+  {
+    VectorND<N> result(*this);
+    result -= other;
+    return result;
+  }
+
+  VectorND<N>
+  operator*(double fact) const
+  {
+    VectorND<N> result(*this);
+    result *= fact;
+    return result;
+  }
+
+  VectorND<N>
+  operator/(double fact) const
+  {
+    VectorND<N> result(*this);
+    result /= fact;
+    return result;
+  }
+
+  // the dot product, as for Vector
+  double
+  operator^(const VectorND<N> &other) const
+  {
+    return this->dot(other);
+  }
+
+  friend OPS_Stream &
+  operator<<(OPS_Stream &s, const VectorND<N> &v)
+  {
+    for (int i=0; i<N; i++)
+      s << v.values[i] << " ";
+    return s << endln;
+  }
+};
+
+} // namespace OpenSees
+
+#endif
@@ -0,0 +1,198 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// File: ~/matrix/benchmark.cpp
+//
+// Description: micro-benchmark for the dense Matrix and Vector products.
+// Each product is timed over a range of element sizes twice, once with
+// the loops in Matrix.cpp and Vector.cpp and once passed to the BLAS, so
+// that the threshold set by Matrix::setBlasThreshold() (or the variable
+// OPS_BLAS_THRESHOLD) can be chosen for the BLAS the program is linked
+// against. Built with "make benchmark".
+
+#include "Vector.h"
+#include "ID.h"
+#include "Matrix.h"
+#include <OPS_Globals.h>
+#include <StandardStream.h>
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+
+StandardStream sserr;
+OPS_Stream *opserrPtr = &sserr;
+
+static void
+fill(Matrix &M, int seed)
+{
+  for (int j=0; j<M.noCols(); j++)
+    for (int i=0; i<M.noRows(); i++)
+      M(i,j) = sin(seed + 7.1*i + 3.3*j);
+}
+
+static void
+fill(Vector &V, int seed)
+{
+  for (int i=0; i<V.Size(); i++)
+    V(i) = cos(seed + 5.7*i);
+}
+
+static double
+maxDifference(const Matrix &A, const Matrix &B)
+{
+  double diff = 0.0;
+  for (int j=0; j<A.noCols(); j++)
+    for (int i=0; i<A.noRows(); i++)
+      diff = fmax(diff, fabs(A(i,j) - B(i,j)));
+  return diff;
+}
+
+static double
+maxDifference(const Vector &A, const Vector &B)
+{
+  double diff = 0.0;
+  for (int i=0; i<A.Size(); i++)
+    diff = fmax(diff, fabs(A(i) - B(i)));
+  return diff;
+}
+
+// C = C + T' * B * T with two products passed to the BLAS, as the BLAS
+// branch of Matrix::addMatrixTripleProduct() computes it; W holds B * T
+static void
+tripleProductBlas(Matrix &C, const Matrix &T, const Matrix &B, Matrix &W)
+{
+  Matrix::setBlasThreshold(0);
+  W.addMatrixProduct(0.0, B, T, 1.0);
+  C.addMatrixTransposeProduct(1.0, T, W, 1.0);
+}
+
+// true if Matrix::tripleProductFixed() has a kernel for a dimB x dimB
+// matrix transformed by a dimB x n one
+static bool
+hasKernel(int dimB, int n)
+{
+  return (n == 6 && (dimB == 6 || dimB == 3));
+}
+
+// time numReps calls of product under the given threshold, in microseconds
+// per call
+template <class Product>
+static double
+timeProduct(int threshold, int numReps, Product product)
+{
+  Matrix::setBlasThreshold(threshold);
+  product();
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (int i=0; i<numReps; i++)
+    product();
+  std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::micro>(end - start).count() / numReps;
+}
+
+int main(int argc, char **argv)
+{
+  static const int sizes[] = {3, 6, 8, 12, 18, 24, 30, 48, 60, 96, 120, 200};
+  static const int numSizes = sizeof(sizes)/sizeof(int);
+
+  // total multiply-adds per product and size, so the timing does not depend
+  // on the size
+  double work = 2.0e8;
+  if (argc > 1)
+    work = atof(argv[1]);
+
+  int defaultThreshold = Matrix::getBlasThreshold();
+
+  printf("%-12s %5s %12s %12s %10s %12s\n", "product", "n", "loops(us)",
+	 "blas(us)", "speedup", "difference");
+
+  for (int s=0; s<numSizes; s++) {
+    int n = sizes[s];
+    int m = (n >= 6) ? n/2 : n;   // rows of the constitutive matrix in T'BT
+
+    Matrix A(n,n), B(n,n), C(n,n), D(m,m), T(m,n), WA(n,n), WT(m,n);
+    Matrix resLoops(n,n), resBlas(n,n);
+    Vector x(n), yLoops(n), yBlas(n);
+    fill(A,1); fill(B,2); fill(D,3); fill(T,4); fill(x,5);
+
+    int numReps = int(work / (double(n)*n*n)) + 1;
+    int numRepsV = int(work / (double(n)*n)) + 1;
+    double tLoops, tBlas;
+
+    // C = C * 0.5 + A * B
+    C.Zero(); C += 1.0;
+    tLoops = timeProduct(-1, numReps, [&]{ C.addMatrixProduct(0.5, A, B, 1.0); });
+    tBlas  = timeProduct(0, numReps, [&]{ C.addMatrixProduct(0.5, A, B, 1.0); });
+    Matrix::setBlasThreshold(-1); resLoops.addMatrixProduct(0.0, A, B, 2.0);
+    Matrix::setBlasThreshold(0);  resBlas.addMatrixProduct(0.0, A, B, 2.0);
+    printf("%-12s %5d %12.3f %12.3f %10.2f %12.3e\n", "A*B", n, tLoops, tBlas,
+	   tLoops/tBlas, maxDifference(resLoops, resBlas));
+
+    // C = C * 0.5 + A' * B
+    tLoops = timeProduct(-1, numReps, [&]{ C.addMatrixTransposeProduct(0.5, A, B, 1.0); });
+    tBlas  = timeProduct(0, numReps, [&]{ C.addMatrixTransposeProduct(0.5, A, B, 1.0); });
+    Matrix::setBlasThreshold(-1); resLoops.addMatrixTransposeProduct(0.0, A, B, 2.0);
+    Matrix::setBlasThreshold(0);  resBlas.addMatrixTransposeProduct(0.0, A, B, 2.0);
+    printf("%-12s %5d %12.3f %12.3f %10.2f %12.3e\n", "A'*B", n, tLoops, tBlas,
+	   tLoops/tBlas, maxDifference(resLoops, resBlas));
+
+    // C = C + A' * B * A, as a coordinate transformation would. the fixed
+    // size kernels are used ahead of the threshold, so the BLAS column is
+    // timed as the two dgemm calls addMatrixTripleProduct would otherwise
+    // make; rows marked * are sizes with a fixed size kernel
+    tLoops = timeProduct(-1, numReps, [&]{ C.addMatrixTripleProduct(1.0, A, B, 1.0); });
+    tBlas  = timeProduct(0, numReps, [&]{ tripleProductBlas(C, A, B, WA); });
+    Matrix::setBlasThreshold(-1); resLoops.addMatrixTripleProduct(0.0, A, B, 2.0);
+    resBlas.Zero(); tripleProductBlas(resBlas, A, B, WA); resBlas *= 2.0;
+    printf("%-12s %5d %12.3f %12.3f %10.2f %12.3e\n",
+	   hasKernel(n, n) ? "A'*B*A *" : "A'*B*A", n, tLoops, tBlas,
+	   tLoops/tBlas, maxDifference(resLoops, resBlas));
+
+    // C = C + T' * D * T, as a section or material stiffness would
+    tLoops = timeProduct(-1, numReps, [&]{ C.addMatrixTripleProduct(1.0, T, D, 1.0); });
+    tBlas  = timeProduct(0, numReps, [&]{ tripleProductBlas(C, T, D, WT); });
+    Matrix::setBlasThreshold(-1); resLoops.addMatrixTripleProduct(0.0, T, D, 2.0);
+    resBlas.Zero(); tripleProductBlas(resBlas, T, D, WT); resBlas *= 2.0;
+    printf("%-12s %5d %12.3f %12.3f %10.2f %12.3e\n",
+	   hasKernel(m, n) ? "T'*D*T *" : "T'*D*T", n, tLoops, tBlas,
+	   tLoops/tBlas, maxDifference(resLoops, resBlas));
+
+    // y = y * 0.5 + A * x and y = y * 0.5 + A' * x
+    tLoops = timeProduct(-1, numRepsV, [&]{ yLoops.addMatrixVector(0.5, A, x, 1.0); });
+    tBlas  = timeProduct(0, numRepsV, [&]{ yBlas.addMatrixVector(0.5, A, x, 1.0); });
+    Matrix::setBlasThreshold(-1); yLoops.addMatrixVector(0.0, A, x, 2.0);
+    Matrix::setBlasThreshold(0);  yBlas.addMatrixVector(0.0, A, x, 2.0);
+    printf("%-12s %5d %12.3f %12.3f %10.2f %12.3e\n", "A*x", n, tLoops, tBlas,
+	   tLoops/tBlas, maxDifference(yLoops, yBlas));
+
+    tLoops = timeProduct(-1, numRepsV, [&]{ yLoops.addMatrixTransposeVector(0.5, A, x, 1.0); });
+    tBlas  = timeProduct(0, numRepsV, [&]{ yBlas.addMatrixTransposeVector(0.5, A, x, 1.0); });
+    Matrix::setBlasThreshold(-1); yLoops.addMatrixTransposeVector(0.0, A, x, 2.0);
+    Matrix::setBlasThreshold(0);  yBlas.addMatrixTransposeVector(0.0, A, x, 2.0);
+    printf("%-12s %5d %12.3f %12.3f %10.2f %12.3e\n", "A'*x", n, tLoops, tBlas,
+	   tLoops/tBlas, maxDifference(yLoops, yBlas));
+  }
+
+  printf("\ncurrent threshold: %d multiply-adds\n", defaultThreshold);
+  return 0;
+}
@@ -251,6 +251,8 @@ GmshRecorder::restart()
 int
 GmshRecorder::domainChanged()
 {
+    // the mesh is written once, again at the next record if it changed
+    write_mesh_now = true;
     return 0;
 }
 
@@ -4615,7 +4615,7 @@ int MPCORecorder::record(int commitTag, double timeStamp)
 	/*
 	write node results
 	*/
-	retval = recordResultsOnNodes();
+	retval = recordResultsOnNodes(commitTag);
 	if (retval) {
 		opserr << "MPCRecorder Error: cannot record results on nodes\n";
 		return retval;
@@ -6366,7 +6366,7 @@ int MPCORecorder::clearElementRecorders()
 	return 0;
 }
 
-int MPCORecorder::recordResultsOnNodes()
+int MPCORecorder::recordResultsOnNodes(int commitTag)
 {
 #ifdef MPCO_TIMING
 	mpco::Timer timer("recordResultsOnNodes"); timer.start();
@@ -6448,7 +6448,7 @@ int MPCORecorder::recordResultsOnNodes()
 			int curr_reac_type = nodal_recorder->getReactionFlag();
 			if (curr_reac_type != previous_reac_type) {
 				if (curr_reac_type > -1 && curr_reac_type < 3) {
-					m_data->info.domain->calculateNodalReactions(curr_reac_type);
+					Recorder::calculateNodalReactions(*m_data->info.domain, commitTag, m_data->info.current_time_step, curr_reac_type);
 				}
 				previous_reac_type = curr_reac_type;
 			}
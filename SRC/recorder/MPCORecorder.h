@@ -90,7 +90,7 @@ private:
 	int initElementRecorders();
 	int clearElementRecorders();
 
-	int recordResultsOnNodes();
+	int recordResultsOnNodes(int commitTag);
 	int recordResultsOnElements();
 
 protected:
@@ -545,11 +545,11 @@ NodeRecorder::record(int commitTag, double timeStamp)
     //
 
     if (dataFlag == 7)
-      theDomain->calculateNodalReactions(0);
+      this->calculateNodalReactions(*theDomain, commitTag, timeStamp, 0);
     else if (dataFlag == 8)
-      theDomain->calculateNodalReactions(1);
+      this->calculateNodalReactions(*theDomain, commitTag, timeStamp, 1);
     if (dataFlag == 9)
-      theDomain->calculateNodalReactions(2);
+      this->calculateNodalReactions(*theDomain, commitTag, timeStamp, 2);
 
     //
     // add time information if requested
@@ -23,6 +23,7 @@
 // Save all data into paraview format
 
 #include "PVDRecorder.h"
+#include "VTU_SeriesFile.h"
 #include <sstream>
 #include <elementAPI.h>
 #include <OPS_Globals.h>
@@ -61,6 +62,7 @@ void* OPS_PVDRecorder()
     std::vector<PVDRecorder::EleData> eledata;
     double dT = 0.0;
     double rTolDt = 0.00001;
+    bool binary = false;
     while(numdata > 0) {
 	const char* type = OPS_GetString();
 	if(strcmp(type, "disp") == 0) {
@@ -139,35 +141,40 @@ void* OPS_PVDRecorder()
 		return 0;
 	    }
 	    if (rTolDt < 0) rTolDt = 0;
+	} else if(strcmp(type, "-binary") == 0) {
+	    binary = true;
 	}
 	numdata = OPS_GetNumRemainingInputArgs();
     }
 
     // create recorder
-    return new PVDRecorder(name,nodedata,eledata,indent,precision,dT, rTolDt);
+    return new PVDRecorder(name,nodedata,eledata,indent,precision,dT, rTolDt, binary);
 }
 
 PVDRecorder::PVDRecorder(const char *name, const NodeData& ndata,
 			 const std::vector<EleData>& edata, int ind, int pre,
-			 double dt, double rTolDt)
+			 double dt, double rTolDt, bool bin)
     :Recorder(RECORDER_TAGS_PVDRecorder), indentsize(ind), precision(pre),
      indentlevel(0), pathname(), basename(),
      timestep(), timeparts(), theFile(), quota('\"'), parts(),
      nodedata(ndata), eledata(edata), theDomain(0), partnum(),
-     dT(dt), relDeltaTTol(rTolDt), nextTime(0.0)
+     dT(dt), relDeltaTTol(rTolDt), nextTime(0.0),
+     binary(bin), series(), domainStamp(-1), numSeries(0)
 {
     PVDRecorder::setVTKType();
     getfilename(name);
 }
 
 PVDRecorder::PVDRecorder()
-    :Recorder(RECORDER_TAGS_PVDRecorder)
+    :Recorder(RECORDER_TAGS_PVDRecorder),
+     binary(false), series(), domainStamp(-1), numSeries(0)
 {
 }
 
 
 PVDRecorder::~PVDRecorder()
 {
+    this->closeSeries();
 }
 
 // PVD
@@ -190,6 +197,10 @@ PVDRecorder::record(int ctag, double timestamp)
       if(precision==0)
          return 0;
 
+      // binary: append the step to the vtu file of each part
+      if (binary)
+         return this->vtuSeries(timestamp);
+
       // get current time
       timestep.push_back(timestamp);
 
@@ -207,12 +218,15 @@ PVDRecorder::restart()
 {
     timestep.clear();
     timeparts.clear();
+    this->closeSeries();
     return 0;
 }
 
 int
 PVDRecorder::domainChanged()
 {
+    // binary: new files with the new mesh at the next record
+    this->closeSeries();
     return 0;
 }
 
@@ -1263,37 +1277,11 @@ PVDRecorder::savePart(int partno, int ctag, int nodendf)
     // get nodes
     const ID& eletags = parts[ctag];
     ID ndtags(0,eletags.Size()*3);
-    std::vector<Element*> eles(eletags.Size());
+    std::vector<Element*> eles;
     int numelenodes = 0;
     int increlenodes = 1;
-    for(int i=0; i<eletags.Size(); i++) {
-	eles[i] = theDomain->getElement(eletags(i));
-	if (eles[i] == 0) {
-	    opserr<<"WARNING: element "<<eletags(i)<<" is not defined--pvdRecorder\n";
-	    return -1;
-	}
-	const ID& elenodes = eles[i]->getExternalNodes();
-	if(numelenodes == 0) {
-	    numelenodes = elenodes.Size();
-	    if(ctag==ELE_TAG_PFEMElement2D||
-	       ctag==ELE_TAG_PFEMElement2DCompressible||
-	       ctag==ELE_TAG_PFEMElement2DBubble||
-	       ctag==ELE_TAG_PFEMElement2Dmini ||
-	       ctag==ELE_TAG_MINI ||
-	       ctag==ELE_TAG_PFEMElement2DQuasi) {
-		numelenodes = 3;
-		increlenodes = 2;
-	    } else if (ctag==ELE_TAG_TaylorHood2D) {
-		numelenodes = 6;
-		increlenodes = 1;
-	    } else if (ctag==ELE_TAG_PFEMElement3DBubble) {
-		numelenodes = 4;
-		increlenodes = 2;
-	    }
-	}
-	for(int j=0; j<numelenodes; j++) {
-	    ndtags.insert(elenodes(j*increlenodes));
-	}
+    if (this->getPartMesh(ctag,eletags,eles,ndtags,numelenodes,increlenodes) < 0) {
+	return -1;
     }
 
     // Piece
@@ -1783,6 +1771,372 @@ PVDRecorder::savePart(int partno, int ctag, int nodendf)
     return 0;
 }
 
+int
+PVDRecorder::getPartMesh(int ctag, const ID& eletags, std::vector<Element*>& eles,
+			 ID& ndtags, int& numelenodes, int& increlenodes)
+{
+    eles.resize(eletags.Size());
+    for(int i=0; i<eletags.Size(); i++) {
+	eles[i] = theDomain->getElement(eletags(i));
+	if (eles[i] == 0) {
+	    opserr<<"WARNING: element "<<eletags(i)<<" is not defined--pvdRecorder\n";
+	    return -1;
+	}
+	const ID& elenodes = eles[i]->getExternalNodes();
+	if(numelenodes == 0) {
+	    numelenodes = elenodes.Size();
+	    if(ctag==ELE_TAG_PFEMElement2D||
+	       ctag==ELE_TAG_PFEMElement2DCompressible||
+	       ctag==ELE_TAG_PFEMElement2DBubble||
+	       ctag==ELE_TAG_PFEMElement2Dmini ||
+	       ctag==ELE_TAG_MINI ||
+	       ctag==ELE_TAG_PFEMElement2DQuasi) {
+		numelenodes = 3;
+		increlenodes = 2;
+	    } else if (ctag==ELE_TAG_TaylorHood2D) {
+		numelenodes = 6;
+		increlenodes = 1;
+	    } else if (ctag==ELE_TAG_PFEMElement3DBubble) {
+		numelenodes = 4;
+		increlenodes = 2;
+	    }
+	}
+	for(int j=0; j<numelenodes; j++) {
+	    ndtags.insert(elenodes(j*increlenodes));
+	}
+    }
+    return 0;
+}
+
+int
+PVDRecorder::vtuSeries(double timestamp)
+{
+    if (theDomain == 0) {
+	opserr << "WARNING: failed to get domain -- PVDRecorder::vtuSeries\n";
+	return -1;
+    }
+
+    // new files when the domain changes, the mesh is written once per file
+    int stamp = theDomain->hasDomainChanged();
+    if (series.empty() || stamp != domainStamp) {
+	domainStamp = stamp;
+	this->closeSeries();
+	if (this->openSeries() < 0) {
+	    this->closeSeries();
+	    return -1;
+	}
+    }
+
+    // append the step to each part
+    for (int i=0; i<(int)series.size(); i++) {
+	SeriesPart& part = series[i];
+	if (part.file->addStep(timestamp) < 0) return -1;
+	if (this->saveNodeSeries(part) < 0) return -1;
+	if (this->saveEleSeries(part) < 0) return -1;
+    }
+
+    return 0;
+}
+
+int
+PVDRecorder::openSeries()
+{
+    // the particles move through the mesh, they are not in the binary files
+    TaggedObjectIter& meshes = OPS_getAllMesh();
+    Mesh* mesh = 0;
+    while((mesh = dynamic_cast<Mesh*>(meshes())) != 0) {
+	if (dynamic_cast<ParticleGroup*>(mesh) != 0) {
+	    opserr<<"WARNING: particle groups are not saved with -binary -- PVDRecorder\n";
+	    break;
+	}
+    }
+
+    // get parts
+    this->getParts();
+
+    // part 0: all nodes except pressure nodes
+    ID ptags(0,theDomain->getNumPCs());
+    Pressure_ConstraintIter& thePCs = theDomain->getPCs();
+    Pressure_Constraint* thePC = 0;
+    while ((thePC = thePCs()) != 0) {
+	Node* pnode = thePC->getPressureNode();
+	if (pnode != 0) {
+	    ptags.insert(pnode->getTag());
+	}
+    }
+
+    SeriesPart part0;
+    part0.ctag = 0;
+    NodeIter& theNodes = theDomain->getNodes();
+    Node* theNode = 0;
+    while ((theNode = theNodes()) != 0) {
+	if (ptags.getLocationOrdered(theNode->getTag()) < 0) {
+	    part0.nodes.push_back(theNode);
+	}
+    }
+    int numnodes = (int)part0.nodes.size();
+    std::vector<long long> connectivity(numnodes);
+    for (int i=0; i<numnodes; i++) {
+	connectivity[i] = i;
+    }
+    std::vector<long long> offsets(1, numnodes);
+    std::vector<unsigned char> types(1, VTK_POLY_VERTEX);
+    std::vector<long long> eletags(1, 0);
+
+    part0.file = new VTU_SeriesFile();
+    series.push_back(part0);
+    SeriesPart& first = series.back();
+
+    std::stringstream ss;
+    ss << pathname << basename << "/" << basename << "_P0_" << numSeries << ".vtu";
+    if (first.file->open(ss.str().c_str()) < 0) return -1;
+    if (first.file->addPiece(numnodes, 1) < 0) return -1;
+    if (first.file->setCells(0, connectivity, offsets, types) < 0) return -1;
+    if (first.file->addCellArray(0, "ElementTag", eletags) < 0) return -1;
+
+    // parts of each element type
+    for(std::map<int,ID>::iterator it=parts.begin(); it!=parts.end(); it++) {
+	int ctag = it->first;
+	const ID& etags = it->second;
+	ID ndtags(0,etags.Size()*3);
+	int numelenodes = 0;
+	int increlenodes = 1;
+
+	SeriesPart part;
+	part.ctag = ctag;
+	part.file = new VTU_SeriesFile();
+	if (this->getPartMesh(ctag,etags,part.eles,ndtags,numelenodes,increlenodes) < 0) {
+	    delete part.file;
+	    return -1;
+	}
+	series.push_back(part);
+	SeriesPart& thePart = series.back();
+
+	int type = vtktypes[ctag];
+	if (type == 0) {
+	    opserr<<"WARNING: the element type cannot be assigned a VTK type\n";
+	    return -1;
+	}
+
+	// nodes
+	thePart.nodes.resize(ndtags.Size());
+	for(int i=0; i<ndtags.Size(); i++) {
+	    thePart.nodes[i] = theDomain->getNode(ndtags(i));
+	    if(thePart.nodes[i] == 0) {
+		opserr<<"WARNING: Node "<<ndtags(i)<<" is not defined -- pvdRecorder\n";
+		return -1;
+	    }
+	}
+
+	// cells, for 2nd order element the order of mid nodes is different to VTK
+	int numeles = etags.Size();
+	int vtkOrder[] = {0,1,2,5,3,4};
+	connectivity.resize(numeles*numelenodes);
+	offsets.resize(numeles);
+	types.assign(numeles, (unsigned char)type);
+	eletags.resize(numeles);
+	for(int i=0; i<numeles; i++) {
+	    const ID& elenodes = thePart.eles[i]->getExternalNodes();
+	    for(int j=0; j<numelenodes; j++) {
+		int k = (ctag==ELE_TAG_TaylorHood2D) ? vtkOrder[j] : j;
+		connectivity[i*numelenodes+j] = ndtags.getLocationOrdered(elenodes(k*increlenodes));
+	    }
+	    offsets[i] = (long long)(i+1)*numelenodes;
+	    eletags[i] = etags(i);
+	}
+
+	std::stringstream sp;
+	sp << pathname << basename << "/" << basename << "_P" << series.size()-1
+	   << "_" << numSeries << ".vtu";
+	if (thePart.file->open(sp.str().c_str()) < 0) return -1;
+	if (thePart.file->addPiece(ndtags.Size(), numeles) < 0) return -1;
+	if (thePart.file->setCells(0, connectivity, offsets, types) < 0) return -1;
+	if (thePart.file->addCellArray(0, "ElementTag", eletags) < 0) return -1;
+
+	// size of element responses, kept for all the steps of the file
+	thePart.eressize.assign(eledata.size(), 0);
+	for(int i=0; i<(int)eledata.size() && numeles>0; i++) {
+	    int argc = (int)eledata[i].size();
+	    if(argc == 0) continue;
+	    std::vector<const char*> argv(argc);
+	    for(int j=0; j<argc; j++) {
+		argv[j] = eledata[i][j].c_str();
+	    }
+	    const Vector* data = theDomain->getElementResponse(etags(0),&(argv[0]),argc);
+	    if(data != 0) {
+		thePart.eressize[i] = data->Size();
+	    }
+	}
+    }
+
+    // points and node tags of each part
+    for (int i=0; i<(int)series.size(); i++) {
+	SeriesPart& part = series[i];
+	int numnodes = (int)part.nodes.size();
+	std::vector<double> crds(3*numnodes, 0.0);
+	std::vector<long long> ndtags(numnodes);
+	for (int j=0; j<numnodes; j++) {
+	    const Vector& crd = part.nodes[j]->getCrds();
+	    for (int k=0; k<3 && k<crd.Size(); k++) {
+		crds[3*j+k] = crd(k);
+	    }
+	    ndtags[j] = part.nodes[j]->getTag();
+	}
+	if (part.file->setPoints(0, crds) < 0) return -1;
+	if (part.file->addPointArray(0, "NodeTag", ndtags) < 0) return -1;
+    }
+
+    numSeries++;
+    parts.clear();
+
+    return 0;
+}
+
+void
+PVDRecorder::closeSeries()
+{
+    for (int i=0; i<(int)series.size(); i++) {
+	series[i].file->close();
+	delete series[i].file;
+    }
+    series.clear();
+}
+
+int
+PVDRecorder::addNodeArray(SeriesPart& part, const char* name,
+			  const Vector& (Node::*response)(void), int ncomp, bool crdsonly)
+{
+    int numnodes = (int)part.nodes.size();
+    std::vector<double> data(ncomp*numnodes, 0.0);
+    for (int i=0; i<numnodes; i++) {
+	const Vector& vec = (part.nodes[i]->*response)();
+	int num = vec.Size();
+	if (crdsonly && part.nodes[i]->getCrds().Size() < num) {
+	    num = part.nodes[i]->getCrds().Size();
+	}
+	for (int j=0; j<ncomp && j<num; j++) {
+	    data[ncomp*i+j] = vec(j);
+	}
+    }
+    return part.file->addPointArray(0, name, ncomp, data);
+}
+
+int
+PVDRecorder::saveNodeSeries(SeriesPart& part)
+{
+    // as in vtu(), the nodal arrays have 3 components
+    int nodendf = 3;
+    int numnodes = (int)part.nodes.size();
+
+    if (nodedata.vel &&
+	this->addNodeArray(part,"Velocity",&Node::getTrialVel,nodendf) < 0) {
+	return -1;
+    }
+    if (nodedata.disp &&
+	this->addNodeArray(part,"Displacement",&Node::getTrialDisp,3,true) < 0) {
+	return -1;
+    }
+    if (nodedata.incrdisp &&
+	this->addNodeArray(part,"IncrDisplacement",&Node::getIncrDisp,nodendf) < 0) {
+	return -1;
+    }
+    if (nodedata.accel &&
+	this->addNodeArray(part,"Acceleration",&Node::getTrialAccel,nodendf) < 0) {
+	return -1;
+    }
+
+    // node pressure
+    if (nodedata.pressure) {
+	std::vector<double> data(numnodes, 0.0);
+	for (int i=0; i<numnodes; i++) {
+	    Pressure_Constraint* thePC = theDomain->getPressure_Constraint(part.nodes[i]->getTag());
+	    if (thePC != 0) {
+		data[i] = thePC->getPressure();
+	    }
+	}
+	if (part.file->addPointArray(0, "Pressure", 1, data) < 0) return -1;
+    }
+
+    if (nodedata.reaction &&
+	this->addNodeArray(part,"Reaction",&Node::getReaction,nodendf) < 0) {
+	return -1;
+    }
+    if (nodedata.unbalanced &&
+	this->addNodeArray(part,"UnbalancedLoad",&Node::getUnbalancedLoad,nodendf) < 0) {
+	return -1;
+    }
+
+    // node mass
+    if (nodedata.mass) {
+	std::vector<double> data(nodendf*numnodes, 0.0);
+	for (int i=0; i<numnodes; i++) {
+	    const Matrix& mat = part.nodes[i]->getMass();
+	    for (int j=0; j<nodendf && j<mat.noRows(); j++) {
+		data[nodendf*i+j] = mat(j,j);
+	    }
+	}
+	if (part.file->addPointArray(0, "NodeMass", nodendf, data) < 0) return -1;
+    }
+
+    // node eigen vector
+    for (int k=0; k<nodedata.numeigen; k++) {
+	std::vector<double> data(nodendf*numnodes, 0.0);
+	for (int i=0; i<numnodes; i++) {
+	    const Matrix& eigens = part.nodes[i]->getEigenvectors();
+	    if (k >= eigens.noCols()) {
+		opserr<<"WARNING: eigenvector "<<k+1<<" is too large\n";
+		return -1;
+	    }
+	    for (int j=0; j<nodendf && j<eigens.noRows(); j++) {
+		data[nodendf*i+j] = eigens(j,k);
+	    }
+	}
+	std::stringstream ss;
+	ss << "EigenVector" << k+1;
+	if (part.file->addPointArray(0, ss.str().c_str(), nodendf, data) < 0) return -1;
+    }
+
+    return 0;
+}
+
+int
+PVDRecorder::saveEleSeries(SeriesPart& part)
+{
+    int numeles = (int)part.eles.size();
+    if (part.ctag == 0 || numeles == 0) {
+	return 0;
+    }
+
+    for (int i=0; i<(int)eledata.size(); i++) {
+
+	int eressize = part.eressize[i];
+	if (eressize == 0) continue;
+	int argc = (int)eledata[i].size();
+	std::vector<const char*> argv(argc);
+	std::string name = part.eles[0]->getClassType();
+	for (int j=0; j<argc; j++) {
+	    argv[j] = eledata[i][j].c_str();
+	    name += argv[j];
+	}
+
+	std::vector<double> values(eressize*numeles, 0.0);
+	for (int j=0; j<numeles; j++) {
+	    int etag = part.eles[j]->getTag();
+	    const Vector* data = theDomain->getElementResponse(etag,&(argv[0]),argc);
+	    if (data == 0) {
+		opserr<<"WARNING: can't get response for element "<<etag<<"\n";
+		return -1;
+	    }
+	    for (int k=0; k<eressize && k<data->Size(); k++) {
+		values[eressize*j+k] = (*data)(k);
+	    }
+	}
+	if (part.file->addCellArray(0, name.c_str(), eressize, values) < 0) return -1;
+    }
+
+    return 0;
+}
+
 void
 PVDRecorder::indent() {
     for(int i=0; i<indentlevel*indentsize; i++) {
@@ -2043,5 +2397,8 @@ int PVDRecorder::flush(void) {
   if (theFile.is_open() && theFile.good()) {
     theFile.flush();
   }
+  for (int i=0; i<(int)series.size(); i++) {
+    series[i].file->flush();
+  }
   return 0;
 }
@@ -39,6 +39,8 @@
 
 class Node;
 class Element;
+class Vector;
+class VTU_SeriesFile;
 
 class PVDRecorder: public Recorder
 {
@@ -54,7 +56,8 @@ public:
     
 public:
     PVDRecorder(const char *filename, const NodeData& ndata,
-		const std::vector<EleData>& edata, int ind=2, int pre=10, double dt=0, double relDeltaTTol = 0.00001);
+		const std::vector<EleData>& edata, int ind=2, int pre=10, double dt=0, double relDeltaTTol = 0.00001,
+		bool binary = false);
     PVDRecorder();
     ~PVDRecorder();
 
@@ -70,6 +73,7 @@ protected:
 
     virtual int vtu();
     virtual int pvd();
+    virtual int vtuSeries(double timestamp);
     virtual void addEleData(const EleData& edata) {eledata.push_back(edata);}
 
 private:
@@ -80,7 +84,26 @@ private:
     virtual int savePart(int partno, int ctag, int ndf);
     virtual int savePart0(int ndf);
     virtual int savePartParticle(int partno, int gtag, int ndf);
+    int getPartMesh(int ctag, const ID& eletags, std::vector<Element*>& eles,
+		    ID& ndtags, int& numelenodes, int& increlenodes);
     void getfilename(const char* name);
+
+    // -binary: for each part one vtu file holding all the steps, with
+    // the mesh written once and the data of each step appended; a new
+    // set of files is started each time the domain changes
+    struct SeriesPart {
+	VTU_SeriesFile* file;
+	int ctag;			// 0 for the part of all nodes
+	std::vector<Node*> nodes;
+	std::vector<Element*> eles;
+	std::vector<int> eressize;	// size of each eledata response
+    };
+    int openSeries();
+    void closeSeries();
+    int saveNodeSeries(SeriesPart& part);
+    int saveEleSeries(SeriesPart& part);
+    int addNodeArray(SeriesPart& part, const char* name,
+		     const Vector& (Node::*response)(void), int ncomp, bool crdsonly=false);
     
 private:
     int indentsize, precision, indentlevel;
@@ -96,6 +119,9 @@ private:
     std::map<int,int> partnum;
     double dT, nextTime;
     double relDeltaTTol;
+    bool binary;
+    std::vector<SeriesPart> series;
+    int domainStamp, numSeries;
 
 public:
     enum VtkType {
@@ -32,10 +32,16 @@
 // What: "@(#) Recorder.cpp, revA"
 
 #include <Recorder.h>
+#include <Domain.h>
 #include <OPS_Globals.h>
 
 int Recorder::lastRecorderTag(0);
 
+Domain *Recorder::reactionDomain(0);
+int Recorder::reactionCommitTag(-1);
+double Recorder::reactionTime(0.0);
+int Recorder::reactionType(-1);
+
 Recorder::Recorder(int classTag)
   :MovableObject(classTag), TaggedObject(lastRecorderTag)
 {
@@ -91,3 +97,37 @@ Recorder::Print(OPS_Stream &s, int flag)
 {
   return;
 }
+
+// the nodes hold the reactions of one type only, so the reactions are
+// computed again if another type was asked for since; the commit tag and
+// time identify the state the reactions were computed for. a Domain that
+// is wiped or reverted to its start can repeat them, so the commands that
+// do so call clearNodalReactions().
+int
+Recorder::calculateNodalReactions(Domain &theDomain, int commitTag,
+				  double timeStamp, int type)
+{
+  if (reactionDomain == &theDomain && reactionCommitTag == commitTag &&
+      reactionTime == timeStamp && reactionType == type)
+    return 0;
+
+  int result = theDomain.calculateNodalReactions(type);
+  if (result < 0) {
+    clearNodalReactions();
+    return result;
+  }
+
+  reactionDomain = &theDomain;
+  reactionCommitTag = commitTag;
+  reactionTime = timeStamp;
+  reactionType = type;
+  return result;
+}
+
+void
+Recorder::clearNodalReactions(void)
+{
+  reactionDomain = 0;
+  reactionCommitTag = -1;
+  reactionType = -1;
+}
@@ -60,10 +60,24 @@ class Recorder: public MovableObject, public TaggedObject
     virtual void Print(OPS_Stream &s, int flag); 
 	virtual double getRecordedValue(int clmnId, int rowOffset, bool reset) { return 0; } //added by SAJalali
 
+    // forget the reactions computed for the recorders, to be called when
+    // the nodal reactions are computed other than through a Recorder
+    static void clearNodalReactions(void);
+
   protected:
+    // have theDomain compute the nodal reactions of the given type unless
+    // a recorder already had them computed for this commit
+    static int calculateNodalReactions(Domain &theDomain, int commitTag,
+				       double timeStamp, int type);
     
   private:	
     static int lastRecorderTag;
+
+    // what the nodal reactions last computed for a recorder are
+    static Domain *reactionDomain;
+    static int reactionCommitTag;
+    static double reactionTime;
+    static int reactionType;
 };
 
 
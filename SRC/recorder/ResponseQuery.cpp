@@ -0,0 +1,254 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// File: ~/recorder/ResponseQuery.cpp
+//
+// Description: This file contains the implementation of ResponseQuery.
+
+#include <ResponseQuery.h>
+#include <Domain.h>
+#include <Node.h>
+#include <Element.h>
+#include <Response.h>
+#include <Information.h>
+#include <Vector.h>
+
+ResponseQuery::ResponseQuery(Domain &domain)
+  :theDomain(&domain), domainStamp(0), resolved(false)
+{
+
+}
+
+ResponseQuery::~ResponseQuery()
+{
+  this->clearResponses();
+}
+
+int
+ResponseQuery::addElementResponse(const ID &eleTags, const char **argv, int argc)
+{
+  if (argc < 1) {
+    opserr << "ResponseQuery::addElementResponse() - no response given\n";
+    return -1;
+  }
+
+  Query theQuery;
+  theQuery.isElement = true;
+  theQuery.tags = eleTags;
+  for (int i=0; i<argc; i++)
+    theQuery.args.push_back(argv[i]);
+  theQuery.type = NodeData::Empty;
+
+  queries.push_back(theQuery);
+  resolved = false;
+
+  return 0;
+}
+
+int
+ResponseQuery::addNodeResponse(const ID &nodeTags, NodeData type, const ID *dofs)
+{
+  Query theQuery;
+  theQuery.isElement = false;
+  theQuery.tags = nodeTags;
+  theQuery.type = type;
+  if (dofs != 0)
+    theQuery.dofs = *dofs;
+
+  queries.push_back(theQuery);
+  resolved = false;
+
+  return 0;
+}
+
+int
+ResponseQuery::update(void)
+{
+  // look the objects up again if the domain has changed since last time
+  int stamp = theDomain->hasDomainChanged();
+  if (resolved == false || stamp != domainStamp) {
+    domainStamp = stamp;
+    if (this->resolve() != 0)
+      return -1;
+  }
+
+  int result = 0;
+  double *values = data.data();
+  int loc = 0;
+
+  for (Query &theQuery : queries) {
+    int numTags = theQuery.tags.Size();
+
+    for (int i=0; i<numTags; i++) {
+      int size = theQuery.sizes[i];
+      const Vector *theVector = 0;
+
+      if (theQuery.isElement) {
+        Response *theResponse = theQuery.responses[i];
+        if (theResponse != 0) {
+          if (theResponse->getResponse() < 0)
+            result = -1;
+          else
+            theVector = &(theResponse->getInformation().getData());
+        }
+      } else {
+        Node *theNode = theQuery.nodes[i];
+        if (theNode != 0)
+          theVector = this->getNodeResponse(theNode, theQuery.type);
+      }
+
+      // a response that fails gives zeros, so that the values of the
+      // other tags stay in their place
+      if (theVector == 0) {
+        for (int j=0; j<size; j++)
+          values[loc++] = 0.0;
+        continue;
+      }
+
+      const Vector &theData = *theVector;
+      int dataSize = theData.Size();
+      int numDOF = theQuery.dofs.Size();
+      if (numDOF == 0) {
+        for (int j=0; j<size; j++)
+          values[loc++] = (j < dataSize) ? theData(j) : 0.0;
+      } else {
+        for (int j=0; j<numDOF; j++) {
+          int dof = theQuery.dofs(j);
+          values[loc++] = (dof >= 0 && dof < dataSize) ? theData(dof) : 0.0;
+        }
+      }
+    }
+  }
+
+  return result;
+}
+
+const double *
+ResponseQuery::getData(void) const
+{
+  return data.data();
+}
+
+int
+ResponseQuery::getNumValues(void)
+{
+  if (resolved == false) {
+    domainStamp = theDomain->hasDomainChanged();
+    this->resolve();
+  }
+
+  return data.size();
+}
+
+int
+ResponseQuery::resolve(void)
+{
+  this->clearResponses();
+
+  int numValues = 0;
+
+  for (Query &theQuery : queries) {
+    int numTags = theQuery.tags.Size();
+    theQuery.sizes.assign(numTags, 0);
+
+    if (theQuery.isElement) {
+      int argc = theQuery.args.size();
+      std::vector<const char *> argv(argc);
+      for (int j=0; j<argc; j++)
+        argv[j] = theQuery.args[j].c_str();
+
+      theQuery.responses.assign(numTags, 0);
+      for (int i=0; i<numTags; i++) {
+        Element *theEle = theDomain->getElement(theQuery.tags(i));
+        if (theEle == 0)
+          continue;
+        Response *theResponse = theEle->setResponse(argv.data(), argc, theDummyStream);
+        if (theResponse == 0)
+          continue;
+        theQuery.responses[i] = theResponse;
+        theQuery.sizes[i] = theResponse->getInformation().getData().Size();
+      }
+
+    } else {
+      theQuery.nodes.assign(numTags, 0);
+      for (int i=0; i<numTags; i++) {
+        Node *theNode = theDomain->getNode(theQuery.tags(i));
+        if (theNode == 0)
+          continue;
+        theQuery.nodes[i] = theNode;
+        const Vector *theVector = this->getNodeResponse(theNode, theQuery.type);
+        if (theVector != 0)
+          theQuery.sizes[i] = theVector->Size();
+      }
+    }
+
+    // with dofs given each tag gives one value per dof, present or not
+    int numDOF = theQuery.dofs.Size();
+    for (int i=0; i<numTags; i++) {
+      if (numDOF != 0)
+        theQuery.sizes[i] = numDOF;
+      numValues += theQuery.sizes[i];
+    }
+  }
+
+  if ((int)data.size() != numValues)
+    data.assign(numValues, 0.0);
+
+  resolved = true;
+
+  return 0;
+}
+
+const Vector *
+ResponseQuery::getNodeResponse(Node *theNode, NodeData type)
+{
+  // the common responses straight from the node, the others through
+  // the domain, which looks the node up again
+  switch (type) {
+  case NodeData::Disp:
+    return &theNode->getDisp();
+  case NodeData::Vel:
+    return &theNode->getVel();
+  case NodeData::Accel:
+    return &theNode->getAccel();
+  case NodeData::IncrDisp:
+    return &theNode->getIncrDisp();
+  case NodeData::IncrDeltaDisp:
+    return &theNode->getIncrDeltaDisp();
+  case NodeData::Reaction:
+    return &theNode->getReaction();
+  case NodeData::UnbalancedLoad:
+    return &theNode->getUnbalancedLoad();
+  default:
+    return theDomain->getNodeResponse(theNode->getTag(), type);
+  }
+}
+
+void
+ResponseQuery::clearResponses(void)
+{
+  for (Query &theQuery : queries) {
+    for (Response *theResponse : theQuery.responses)
+      if (theResponse != 0)
+        delete theResponse;
+    theQuery.responses.clear();
+    theQuery.nodes.clear();
+  }
+}
@@ -0,0 +1,90 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// File: ~/recorder/ResponseQuery.h
+//
+// Description: This file contains the class definition for ResponseQuery.
+// A ResponseQuery is a handle on a set of element and node responses that
+// a script asks for repeatedly, e.g. after every step of an analysis.
+// The elements, nodes and Response objects are looked up once, when the
+// query is first evaluated and again only when the Domain has changed,
+// instead of on every request as the eleResponse and nodeDisp commands
+// do. Each call to update() then writes the current values of all the
+// responses, in the order they were added, into one array of doubles
+// owned by the query. The array is reallocated only when the number of
+// values changes, i.e. when a response is added or the Domain changes.
+
+#ifndef ResponseQuery_h
+#define ResponseQuery_h
+
+#include <vector>
+#include <string>
+#include <ID.h>
+#include <DummyStream.h>
+#include <NodeData.h>
+
+class Domain;
+class Node;
+class Response;
+class Vector;
+
+class ResponseQuery
+{
+  public:
+    ResponseQuery(Domain &theDomain);
+    ~ResponseQuery();
+
+    // add the response given by argv for each of the elements, or the
+    // response of the given type for each of the nodes; the values of a
+    // node are those of the dofs given (0 based), all of them if none
+    int addElementResponse(const ID &eleTags, const char **argv, int argc);
+    int addNodeResponse(const ID &nodeTags, NodeData type, const ID *dofs = 0);
+
+    int update(void);
+    const double *getData(void) const;
+    int getNumValues(void);
+
+  protected:
+
+  private:
+    struct Query {
+      bool isElement;
+      ID tags;
+      std::vector<std::string> args;     // element response arguments
+      NodeData type;                     // node response type
+      ID dofs;                           // node dofs, all if size 0
+      std::vector<Response *> responses; // formed by resolve()
+      std::vector<Node *> nodes;
+      std::vector<int> sizes;            // number of values of each tag
+    };
+
+    int resolve(void);
+    const Vector *getNodeResponse(Node *theNode, NodeData type);
+    void clearResponses(void);
+
+    Domain *theDomain;
+    std::vector<Query> queries;
+    std::vector<double> data;
+    int domainStamp;
+    bool resolved;
+    DummyStream theDummyStream;
+};
+
+#endif
@@ -116,6 +116,7 @@ void* OPS_VTK_Recorder()
     std::vector<VTK_Recorder::EleData> eledata;
     double dT = 0.0;
     double rTolDt = 0.00001;
+    bool binary = false;
 
     while(numdata > 0) {
 	const char* type = OPS_GetString();
@@ -223,18 +224,21 @@ void* OPS_VTK_Recorder()
 		return 0;
 	    }
 	    if (rTolDt < 0) rTolDt = 0;
+	} else if(strcmp(type, "-binary") == 0) {
+	    binary = true;
 	}
 	numdata = OPS_GetNumRemainingInputArgs();
     }
 
     // create recorder
-    return new VTK_Recorder(name,outputData,eledata,indent,precision,dT, rTolDt);
+    return new VTK_Recorder(name,outputData,eledata,indent,precision,dT, rTolDt, binary);
 }
 
 VTK_Recorder::VTK_Recorder(const char *inputName, 
 			   const OutputData& outData,
 			   const std::vector<EleData>& edata, 
-			   int ind, int pre, double dt, double rTolDt)
+			   int ind, int pre, double dt, double rTolDt,
+			   bool bin)
     :Recorder(RECORDER_TAGS_VTK_Recorder), 
      indentsize(ind), 
      precision(pre),
@@ -246,7 +250,11 @@ VTK_Recorder::VTK_Recorder(const char *inputName,
      relDeltaTTol(rTolDt),
      counter(0),
      initializationDone(false),
-     sendSelfCount(0)
+     sendSelfCount(0),
+     binary(bin),
+     theSeries(),
+     domainStamp(-1),
+     numSeries(0)
 {
   outputData = outData;
 
@@ -272,9 +280,12 @@ VTK_Recorder::VTK_Recorder(const char *inputName,
   initDone = false;
 
   //
-  // open pvd file
+  // open pvd file, the binary output has none
   //
 
+  if (binary == true)
+    return;
+
   char *filename = new char[strlen(name) + 5];
   sprintf(filename, "%s.pvd",name);
   
@@ -310,7 +321,11 @@ VTK_Recorder::VTK_Recorder()
    relDeltaTTol(0.00001),
    counter(0),
    initializationDone(false),
-   sendSelfCount(0)   
+   sendSelfCount(0),
+   binary(false),
+   theSeries(),
+   domainStamp(-1),
+   numSeries(0)
 {
   name = NULL;
 
@@ -330,6 +345,11 @@ VTK_Recorder::~VTK_Recorder()
   // write out last bits and close the vtd file
   //
 
+  if (binary == true) {
+    theSeries.close();
+    return;
+  }
+
   thePVDFile << "</Collection>\n </VTKFile>\n";
   thePVDFile.close();
 }
@@ -337,7 +357,7 @@ VTK_Recorder::~VTK_Recorder()
 int
 VTK_Recorder::record(int ctag, double timeStamp)
 {
-  if (initializationDone == false) {
+  if (binary == false && initializationDone == false) {
     this->initialize();
     initializationDone = true;
   }
@@ -348,6 +368,9 @@ VTK_Recorder::record(int ctag, double timeStamp)
     
     if (deltaT != 0.0) 
       nextTimeStampToRecord = timeStamp + deltaT;
+
+    if (binary == true)
+      return this->vtuSeries(timeStamp);
   
     //
     // add a line to pvd file
@@ -384,6 +407,12 @@ VTK_Recorder::restart()
 int
 VTK_Recorder::domainChanged()
 {
+  // the binary output starts a new file with the new mesh at the next record
+  if (binary == true) {
+    theSeries.close();
+    return 0;
+  }
+
   this->initialize();
   return 0;
 }
@@ -893,6 +922,125 @@ VTK_Recorder::vtu()
     return 0;
 }
 
+int
+VTK_Recorder::vtuSeries(double timeStamp)
+{
+  if (theDomain == 0) {
+    opserr << "WARNING: failed to get domain -- VTK_Recorder::vtuSeries\n";
+    return -1;
+  }
+
+  //
+  // start a new file when the domain changes, the mesh is written once per file
+  //
+
+  int stamp = theDomain->hasDomainChanged();
+  if (theSeries.isOpen() == false || stamp != domainStamp) {
+    domainStamp = stamp;
+    if (this->initialize() < 0 || this->openSeries() < 0)
+      return -1;
+    initializationDone = true;
+  }
+
+  if (theSeries.addStep(timeStamp) < 0)
+    return -1;
+
+  //
+  // point data for the step
+  //
+
+  int res = 0;
+  if (outputData.disp == true)
+    res += this->addNodeArray("Disp", &Node::getDisp, maxNDF);
+  if (outputData.disp2 == true)
+    res += this->addNodeArray("Disp2", &Node::getDisp, 2);
+  if (outputData.disp3 == true)
+    res += this->addNodeArray("Disp3", &Node::getDisp, 3);
+  if (outputData.vel == true)
+    res += this->addNodeArray("Vel", &Node::getVel, maxNDF);
+  if (outputData.accel == true)
+    res += this->addNodeArray("Accel", &Node::getAccel, maxNDF);
+
+  return res < 0 ? -1 : 0;
+}
+
+int
+VTK_Recorder::openSeries()
+{
+  char *filename = new char[2*strlen(name)+26];
+  if (sendSelfCount < 0)
+    sprintf(filename, "%s/%s%d_%d.vtu", name, name, -sendSelfCount, numSeries);
+  else
+    sprintf(filename, "%s/%s%d_%d.vtu", name, name, 0, numSeries);
+  numSeries++;
+
+  int res = theSeries.open(filename);
+  delete [] filename;
+  if (res < 0)
+    return -1;
+
+  int piece = theSeries.addPiece(numNode, numElement);
+  if (piece < 0)
+    return -1;
+
+  //
+  // points - nodal coords
+  //
+
+  std::vector<double> crds;
+  crds.reserve(3*numNode);
+  for (auto i : theNodeTags) {
+    Node *theNode=theDomain->getNode(i);
+    const Vector &crd=theNode->getCrds();
+    int numCrd = crd.Size();
+    for (int j=0; j<3; j++)
+      crds.push_back(j < numCrd ? crd(j) : 0.0);
+  }
+
+  //
+  // cells - element connectivity, offsets and types
+  //
+
+  std::vector<long long> connectivity;
+  connectivity.reserve(theEleVtkOffsets.empty() ? 0 : theEleVtkOffsets.back());
+  for (auto i : theEleTags) {
+    Element *theEle=theDomain->getElement(i);
+    const ID &theNodes=theEle->getExternalNodes();
+    for (int j=0; j<theNodes.Size(); j++)
+      connectivity.push_back(theNodeMapping[theNodes(j)]);
+  }
+  std::vector<long long> offsets(theEleVtkOffsets.begin(), theEleVtkOffsets.end());
+  std::vector<unsigned char> types(theEleVtkTags.begin(), theEleVtkTags.end());
+
+  std::vector<long long> nodeTags(theNodeTags.begin(), theNodeTags.end());
+  std::vector<long long> eleTags(theEleTags.begin(), theEleTags.end());
+  std::vector<long long> eleClassTags(theEleClassTags.begin(), theEleClassTags.end());
+
+  if (theSeries.setPoints(piece, crds) < 0 ||
+      theSeries.setCells(piece, connectivity, offsets, types) < 0 ||
+      theSeries.addPointArray(piece, "Node Tag", nodeTags) < 0 ||
+      theSeries.addCellArray(piece, "Element Tag", eleTags) < 0 ||
+      theSeries.addCellArray(piece, "Element Class", eleClassTags) < 0)
+    return -1;
+
+  return 0;
+}
+
+int
+VTK_Recorder::addNodeArray(const char *arrayName, const Vector &(Node::*response)(void), int numComp)
+{
+  std::vector<double> data;
+  data.reserve(numComp*numNode);
+  for (auto i : theNodeTags) {
+    Node *theNode=theDomain->getNode(i);
+    const Vector &output=(theNode->*response)();
+    int numDOF = output.Size();
+    for (int j=0; j<numComp; j++)
+      data.push_back(j < numDOF ? output(j) : 0.0);
+  }
+  return theSeries.addPointArray(0, arrayName, numComp, data);
+}
+
 void
 VTK_Recorder::indent() {
     for(int i=0; i<indentlevel*indentsize; i++) {
@@ -905,7 +1053,7 @@ VTK_Recorder::sendSelf(int commitTag, Channel &theChannel)
 {
   sendSelfCount++;
 
-  static ID idData(2+14+1);
+  static ID idData(2+14+2);
   int fileNameLength = 0;
   if (name != 0)
     fileNameLength = strlen(name);
@@ -928,6 +1076,7 @@ VTK_Recorder::sendSelf(int commitTag, Channel &theChannel)
   idData(15) = outputData.unbalancedLoad;
 
   idData(16) = precision;
+  idData(17) = binary;
 
   if (theChannel.sendID(0, commitTag, idData) < 0) {
     opserr << "FileStream::sendSelf() - failed to send id data\n";
@@ -948,7 +1097,7 @@ VTK_Recorder::sendSelf(int commitTag, Channel &theChannel)
 int
 VTK_Recorder::recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &theBroker)
 {
-  static ID idData(2+14+1);
+  static ID idData(2+14+2);
   if (theChannel.recvID(0, commitTag, idData) < 0) {
     opserr << "FileStream::recvSelf() - failed to recv id data\n";
     return -1;
@@ -973,6 +1122,7 @@ VTK_Recorder::recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &the
   outputData.unbalancedLoad = idData(15);
 
   precision = idData(16);
+  binary = (idData(17) != 0);
 
   if (fileNameLength != 0) {
     if (name != 0)
@@ -1308,5 +1458,6 @@ int VTK_Recorder::flush(void) {
   if (theVTUFile.is_open() && theVTUFile.good()) {
     theVTUFile.flush();
   }
+  theSeries.flush();
   return 0;
 }
@@ -36,9 +36,11 @@
 #include <map>
 #include <ID.h>
 #include <Recorder.h>
+#include <VTU_SeriesFile.h>
 
 class Node;
 class Element;
+class Vector;
 
 class OutputData {
 
@@ -72,7 +74,8 @@ public:
     
 public:
   VTK_Recorder(const char *filename, const OutputData& ndata,
-	       const std::vector<EleData>& edata, int ind=2, int pre=10, double dt=0, double rTolDt=0.00001);
+	       const std::vector<EleData>& edata, int ind=2, int pre=10, double dt=0, double rTolDt=0.00001,
+	       bool binary=false);
   VTK_Recorder();
   ~VTK_Recorder();
   
@@ -89,6 +92,7 @@ public:
   bool initDone;
   
   virtual int vtu();
+  virtual int vtuSeries(double timeStamp);
   virtual void addEleData(const EleData& edata) {eledata.push_back(edata);}
   std::vector<EleData> eledata;
   
@@ -97,6 +101,8 @@ public:
   virtual void incrLevel() {indentlevel++;}
   virtual void decrLevel() {indentlevel--;}
   void getfilename(const char* name);
+  int openSeries();
+  int addNodeArray(const char *arrayName, const Vector &(Node::*response)(void), int numComp);
   
   
  private:
@@ -147,6 +153,13 @@ public:
 
   bool initializationDone;
   int sendSelfCount;
+
+  // -binary: one vtu file for all the steps, a new one each time the
+  // domain changes, with the mesh written once and the data appended
+  bool binary;
+  VTU_SeriesFile theSeries;
+  int domainStamp;
+  int numSeries;
 };
 
 #endif
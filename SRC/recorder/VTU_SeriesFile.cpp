@@ -0,0 +1,443 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// File: ~/recorder/VTU_SeriesFile.cpp
+//
+// Description: This file contains the implementation of VTU_SeriesFile.
+
+#include <VTU_SeriesFile.h>
+#include <OPS_Globals.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <sstream>
+
+// the appended data start after the room kept for the header and this
+// tag, and are followed by the closing tags
+static const char appendedTag[] = "  <AppendedData encoding=\"raw\">\n   _";
+static const char closingTags[] = "\n  </AppendedData>\n</VTKFile>\n";
+
+// the least room kept for the header, in bytes
+static const unsigned long long minHeaderRoom = 4096;
+
+VTU_SeriesFile::VTU_SeriesFile()
+  :fileName(), theFile(), mesh(), meshWritten(false),
+   headerRoom(0), dataSize(0), headerSteps(0),
+   pieces(), arrays(), times()
+{
+
+}
+
+VTU_SeriesFile::~VTU_SeriesFile()
+{
+  if (this->isOpen())
+    this->close();
+}
+
+int
+VTU_SeriesFile::open(const char *name)
+{
+  if (this->isOpen())
+    this->close();
+
+  fileName = name;
+  theFile.open(fileName.c_str(), std::ios::in | std::ios::out | std::ios::trunc | std::ios::binary);
+  if (theFile.fail()) {
+    opserr << "WARNING VTU_SeriesFile::open() - failed to open file " << fileName.c_str() << endln;
+    return -1;
+  }
+
+  mesh.clear();
+  meshWritten = false;
+  headerRoom = 0;
+  dataSize = 0;
+  headerSteps = 0;
+  pieces.clear();
+  arrays.clear();
+  times.clear();
+
+  return 0;
+}
+
+bool
+VTU_SeriesFile::isOpen(void) const
+{
+  return theFile.is_open();
+}
+
+int
+VTU_SeriesFile::getNumSteps(void) const
+{
+  return times.size();
+}
+
+int
+VTU_SeriesFile::flush(void)
+{
+  if (!this->isOpen())
+    return 0;
+
+  if (!meshWritten && this->writeMesh() < 0)
+    return -1;
+  return this->writeHeader();
+}
+
+int
+VTU_SeriesFile::addPiece(int numPoints, int numCells)
+{
+  if (!this->isOpen() || !times.empty()) {
+    opserr << "WARNING VTU_SeriesFile::addPiece() - the pieces are set after open() and before the first step\n";
+    return -1;
+  }
+
+  Piece thePiece;
+  thePiece.numPoints = numPoints;
+  thePiece.numCells = numCells;
+  pieces.push_back(thePiece);
+
+  return pieces.size()-1;
+}
+
+int
+VTU_SeriesFile::setPoints(int piece, const std::vector<double> &xyz)
+{
+  if (!times.empty()) {
+    opserr << "WARNING VTU_SeriesFile::setPoints() - the points are set before the first step\n";
+    return -1;
+  }
+  return this->addArray(piece, POINTS, "Points", "Float64", 3, xyz.data(),
+			xyz.size()*sizeof(double), xyz.size());
+}
+
+int
+VTU_SeriesFile::setCells(int piece, const std::vector<long long> &connectivity,
+			 const std::vector<long long> &offsets,
+			 const std::vector<unsigned char> &types)
+{
+  if (!times.empty()) {
+    opserr << "WARNING VTU_SeriesFile::setCells() - the cells are set before the first step\n";
+    return -1;
+  }
+  if (piece < 0 || piece >= (int)pieces.size() ||
+      (int)offsets.size() != pieces[piece].numCells ||
+      (int)types.size() != pieces[piece].numCells ||
+      (offsets.size() != 0 && offsets.back() != (long long)connectivity.size())) {
+    opserr << "WARNING VTU_SeriesFile::setCells() - inconsistent cells for piece " << piece << endln;
+    return -1;
+  }
+
+  // the connectivity is checked against the offsets, not the number of cells
+  Array theArray;
+  theArray.name = "connectivity";
+  theArray.type = "Int64";
+  theArray.numComp = 1;
+  theArray.piece = piece;
+  theArray.location = CELLS;
+  if (this->storeArray(theArray, connectivity.data(), connectivity.size()*sizeof(long long)) < 0)
+    return -1;
+
+  if (this->addArray(piece, CELLS, "offsets", "Int64", 1, offsets.data(),
+		     offsets.size()*sizeof(long long), offsets.size()) < 0)
+    return -1;
+  return this->addArray(piece, CELLS, "types", "UInt8", 1, types.data(),
+			types.size(), types.size());
+}
+
+int
+VTU_SeriesFile::addStep(double time)
+{
+  if (!this->isOpen()) {
+    opserr << "WARNING VTU_SeriesFile::addStep() - no file open\n";
+    return -1;
+  }
+  if (!meshWritten && this->writeMesh() < 0)
+    return -1;
+
+  // the steps before this one are complete; writing their header when
+  // their number has grown by a quarter keeps the cost of the headers
+  // linear in the number of steps
+  int numSteps = times.size();
+  if (numSteps - headerSteps >= 1 + headerSteps/4 && this->writeHeader() < 0)
+    return -1;
+
+  times.push_back(time);
+  return 0;
+}
+
+int
+VTU_SeriesFile::addPointArray(int piece, const char *name, int numComp,
+			      const std::vector<double> &data)
+{
+  return this->addArray(piece, POINT_DATA, name, "Float64", numComp, data.data(),
+			data.size()*sizeof(double), data.size());
+}
+
+int
+VTU_SeriesFile::addPointArray(int piece, const char *name,
+			      const std::vector<long long> &data)
+{
+  return this->addArray(piece, POINT_DATA, name, "Int64", 1, data.data(),
+			data.size()*sizeof(long long), data.size());
+}
+
+int
+VTU_SeriesFile::addCellArray(int piece, const char *name, int numComp,
+			     const std::vector<double> &data)
+{
+  return this->addArray(piece, CELL_DATA, name, "Float64", numComp, data.data(),
+			data.size()*sizeof(double), data.size());
+}
+
+int
+VTU_SeriesFile::addCellArray(int piece, const char *name,
+			     const std::vector<long long> &data)
+{
+  return this->addArray(piece, CELL_DATA, name, "Int64", 1, data.data(),
+			data.size()*sizeof(long long), data.size());
+}
+
+int
+VTU_SeriesFile::addArray(int piece, Location location, const char *name,
+			 const char *type, int numComp, const void *data,
+			 unsigned long long numBytes, unsigned long long numValues)
+{
+  if (!this->isOpen()) {
+    opserr << "WARNING VTU_SeriesFile::addArray() - no file open\n";
+    return -1;
+  }
+  if (piece < 0 || piece >= (int)pieces.size()) {
+    opserr << "WARNING VTU_SeriesFile::addArray() - no piece " << piece << endln;
+    return -1;
+  }
+
+  // check the size against the number of points or cells of the piece
+  const Piece &thePiece = pieces[piece];
+  unsigned long long numEntries = (location == POINTS || location == POINT_DATA) ?
+    thePiece.numPoints : thePiece.numCells;
+  if (numComp < 1 || numValues != numEntries*numComp) {
+    opserr << "WARNING VTU_SeriesFile::addArray() - array " << name
+	   << " has " << (int)numValues << " values, expected "
+	   << (int)numEntries << " x " << numComp << endln;
+    return -1;
+  }
+
+  Array theArray;
+  theArray.name = name;
+  theArray.type = type;
+  theArray.numComp = numComp;
+  theArray.piece = piece;
+  theArray.location = location;
+  return this->storeArray(theArray, data, numBytes);
+}
+
+int
+VTU_SeriesFile::storeArray(Array &theArray, const void *data,
+			   unsigned long long numBytes)
+{
+  theArray.step = (int)times.size()-1;
+
+  // the mesh is kept in memory until the room for the header is known,
+  // everything else is written in place after the data before it
+  if (!meshWritten) {
+    theArray.offset = mesh.size();
+    const char *bytes = (const char *)&numBytes;
+    mesh.insert(mesh.end(), bytes, bytes+sizeof(numBytes));
+    bytes = (const char *)data;
+    mesh.insert(mesh.end(), bytes, bytes+numBytes);
+  } else {
+    theArray.offset = dataSize;
+    theFile.seekp(headerRoom + strlen(appendedTag) + dataSize);
+    theFile.write((const char *)&numBytes, sizeof(numBytes));
+    theFile.write((const char *)data, numBytes);
+    if (theFile.fail()) {
+      opserr << "WARNING VTU_SeriesFile::storeArray() - failed to write array "
+	     << theArray.name.c_str() << " to " << fileName.c_str() << endln;
+      return -1;
+    }
+    dataSize += sizeof(numBytes) + numBytes;
+  }
+
+  arrays.push_back(theArray);
+  return 0;
+}
+
+void
+VTU_SeriesFile::writeArrays(std::ostream &out, int piece, Location location,
+			    const char *indent)
+{
+  for (size_t i=0; i<arrays.size(); i++) {
+    const Array &theArray = arrays[i];
+    if (theArray.piece != piece || theArray.location != location)
+      continue;
+
+    out << indent << "<DataArray type=\"" << theArray.type << "\"";
+    out << " Name=\"" << theArray.name << "\"";
+    if (theArray.numComp > 1 || location == POINTS)
+      out << " NumberOfComponents=\"" << theArray.numComp << "\"";
+    out << " format=\"appended\" offset=\"" << theArray.offset << "\"";
+    if (theArray.step >= 0)
+      out << " TimeStep=\"" << theArray.step << "\"";
+    out << "/>\n";
+  }
+}
+
+// writes the room for the header, the appended data tag and the mesh;
+// the room is twice the header of the mesh alone, at least minHeaderRoom
+int
+VTU_SeriesFile::writeMesh(void)
+{
+  std::ostringstream header;
+  header.precision(16);
+  header << "<?xml version=\"1.0\"?>\n";
+  for (int i=0; i<(int)pieces.size(); i++) {
+    header << "    <Piece NumberOfPoints=\"" << pieces[i].numPoints;
+    header << "\" NumberOfCells=\"" << pieces[i].numCells << "\">\n";
+    this->writeArrays(header, i, POINTS, "        ");
+    this->writeArrays(header, i, CELLS, "        ");
+    this->writeArrays(header, i, POINT_DATA, "        ");
+    this->writeArrays(header, i, CELL_DATA, "        ");
+  }
+  headerRoom = 2*header.str().size() + 256;
+  if (headerRoom < minHeaderRoom)
+    headerRoom = minHeaderRoom;
+
+  std::string room(headerRoom, ' ');
+  theFile.seekp(0);
+  theFile.write(room.data(), room.size());
+  theFile.write(appendedTag, strlen(appendedTag));
+  if (!mesh.empty())
+    theFile.write(mesh.data(), mesh.size());
+  if (theFile.fail()) {
+    opserr << "WARNING VTU_SeriesFile::writeMesh() - failed to write file " << fileName.c_str() << endln;
+    return -1;
+  }
+
+  dataSize = mesh.size();
+  std::vector<char>().swap(mesh);
+  meshWritten = true;
+  return 0;
+}
+
+// moves the appended data up so that newRoom bytes are kept for the
+// header, from the end down so the data are not overwritten
+int
+VTU_SeriesFile::growHeader(unsigned long long newRoom)
+{
+  unsigned long long shift = newRoom - headerRoom;
+  unsigned long long end = headerRoom + strlen(appendedTag) + dataSize;
+  std::vector<char> block(1<<20);
+
+  while (end > headerRoom) {
+    unsigned long long numBytes = end - headerRoom;
+    if (numBytes > block.size())
+      numBytes = block.size();
+    unsigned long long start = end - numBytes;
+    theFile.seekg(start);
+    theFile.read(block.data(), numBytes);
+    theFile.seekp(start + shift);
+    theFile.write(block.data(), numBytes);
+    if (theFile.fail()) {
+      opserr << "WARNING VTU_SeriesFile::growHeader() - failed to move the data of "
+	     << fileName.c_str() << endln;
+      return -1;
+    }
+    end = start;
+  }
+
+  headerRoom = newRoom;
+  return 0;
+}
+
+// writes the header for the steps so far, padded to the room kept for it,
+// and the closing tags after the data, so the file can be read as it is
+int
+VTU_SeriesFile::writeHeader(void)
+{
+  // the byte order of this machine
+  int one = 1;
+  const char *byteOrder = (*(char *)&one == 1) ? "LittleEndian" : "BigEndian";
+
+  std::ostringstream header;
+  header.precision(16);
+  header << "<?xml version=\"1.0\"?>\n";
+  header << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\"";
+  header << " byte_order=\"" << byteOrder << "\" header_type=\"UInt64\">\n";
+  header << "  <UnstructuredGrid";
+  if (!times.empty()) {
+    header << " TimeValues=\"";
+    for (size_t i=0; i<times.size(); i++)
+      header << (i == 0 ? "" : " ") << times[i];
+    header << "\"";
+  }
+  header << ">\n";
+
+  for (int i=0; i<(int)pieces.size(); i++) {
+    header << "    <Piece NumberOfPoints=\"" << pieces[i].numPoints;
+    header << "\" NumberOfCells=\"" << pieces[i].numCells << "\">\n";
+    header << "      <PointData>\n";
+    this->writeArrays(header, i, POINT_DATA, "        ");
+    header << "      </PointData>\n";
+    header << "      <CellData>\n";
+    this->writeArrays(header, i, CELL_DATA, "        ");
+    header << "      </CellData>\n";
+    header << "      <Points>\n";
+    this->writeArrays(header, i, POINTS, "        ");
+    header << "      </Points>\n";
+    header << "      <Cells>\n";
+    this->writeArrays(header, i, CELLS, "        ");
+    header << "      </Cells>\n";
+    header << "    </Piece>\n";
+  }
+  header << "  </UnstructuredGrid>\n";
+
+  std::string text = header.str();
+  if (text.size() > headerRoom) {
+    unsigned long long newRoom = 2*headerRoom;
+    while (newRoom < text.size())
+      newRoom *= 2;
+    if (this->growHeader(newRoom) < 0)
+      return -1;
+  }
+  text.append(headerRoom - text.size(), ' ');
+
+  theFile.seekp(0);
+  theFile.write(text.data(), text.size());
+  theFile.seekp(headerRoom + strlen(appendedTag) + dataSize);
+  theFile.write(closingTags, strlen(closingTags));
+  theFile.flush();
+  headerSteps = times.size();
+
+  if (theFile.fail()) {
+    opserr << "WARNING VTU_SeriesFile::writeHeader() - failed to write file " << fileName.c_str() << endln;
+    return -1;
+  }
+  return 0;
+}
+
+int
+VTU_SeriesFile::close(void)
+{
+  if (!this->isOpen())
+    return 0;
+
+  int result = this->flush();
+  theFile.close();
+  return result;
+}
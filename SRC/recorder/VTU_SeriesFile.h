@@ -0,0 +1,137 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// File: ~/recorder/VTU_SeriesFile.h
+//
+// Description: This file contains the class definition for
+// VTU_SeriesFile. A VTU_SeriesFile writes the results of many time steps
+// to a single VTK XML unstructured grid (.vtu) file with the data in raw
+// binary in the appended section. The mesh - the points, the cells and
+// any other array given before the first step - is stored once; the
+// arrays given after addStep() carry a TimeStep attribute and the
+// UnstructuredGrid element lists the TimeValues, which the VTK XML
+// readers (ParaView, VisIt) show as one dataset with a time series.
+//
+// The XML header has to come before the appended data and grows with each
+// step, so the file starts with room for a longer header, padded with
+// spaces, and the data are written in place after it. flush() and close()
+// write the header and the closing tags for the steps so far, as does
+// addStep() once the number of steps has grown by a quarter since the
+// header was last written. The file can so be read while the analysis
+// goes on, and holds the steps up to the last header if the program stops
+// before close(). When the header outgrows its room the room is doubled
+// and the data moved up once, so each byte is moved about once over the
+// run and close() copies nothing. Each array of the appended data is
+// preceded by its length in bytes as a UInt64.
+//
+// Use:
+//   open(filename)
+//   addPiece(numPoints, numCells), then for the piece setPoints(),
+//     setCells() and any addPointArray()/addCellArray() of the mesh
+//   for each step: addStep(time), then addPointArray()/addCellArray()
+//     with the piece number, in the same order at each step
+//   flush() whenever the file should be readable
+//   close()
+
+#ifndef VTU_SeriesFile_h
+#define VTU_SeriesFile_h
+
+#include <string>
+#include <fstream>
+#include <vector>
+
+class VTU_SeriesFile
+{
+  public:
+    VTU_SeriesFile();
+    ~VTU_SeriesFile();
+
+    int open(const char *fileName);
+    int close(void);
+    int flush(void);
+    bool isOpen(void) const;
+    int getNumSteps(void) const;
+
+    // the mesh, before the first step
+    int addPiece(int numPoints, int numCells);
+    int setPoints(int piece, const std::vector<double> &xyz);
+    int setCells(int piece, const std::vector<long long> &connectivity,
+		 const std::vector<long long> &offsets,
+		 const std::vector<unsigned char> &types);
+
+    // a new time step; the arrays given next belong to it
+    int addStep(double time);
+
+    // the point and cell arrays, of the mesh before the first step and
+    // of the last step after it; data holds numComp values per point or
+    // per cell of the piece
+    int addPointArray(int piece, const char *name, int numComp,
+		      const std::vector<double> &data);
+    int addPointArray(int piece, const char *name,
+		      const std::vector<long long> &data);
+    int addCellArray(int piece, const char *name, int numComp,
+		     const std::vector<double> &data);
+    int addCellArray(int piece, const char *name,
+		     const std::vector<long long> &data);
+
+  protected:
+
+  private:
+    enum Location {POINTS, CELLS, POINT_DATA, CELL_DATA};
+
+    struct Array {
+      std::string name;
+      const char *type;
+      int numComp;
+      int piece;
+      Location location;
+      int step;                 // -1 for the mesh
+      unsigned long long offset; // in the appended data
+    };
+
+    struct Piece {
+      int numPoints;
+      int numCells;
+    };
+
+    int addArray(int piece, Location location, const char *name,
+		 const char *type, int numComp, const void *data,
+		 unsigned long long numBytes, unsigned long long numValues);
+    int storeArray(Array &theArray, const void *data, unsigned long long numBytes);
+    int writeMesh(void);
+    int writeHeader(void);
+    int growHeader(unsigned long long newRoom);
+    void writeArrays(std::ostream &out, int piece, Location location,
+		     const char *indent);
+
+    std::string fileName;
+    std::fstream theFile;
+    std::vector<char> mesh;        // the mesh, until it is written
+    bool meshWritten;
+    unsigned long long headerRoom; // bytes kept for the header
+    unsigned long long dataSize;   // bytes of appended data written
+    int headerSteps;               // steps in the header last written
+
+    std::vector<Piece> pieces;
+    std::vector<Array> arrays;
+    std::vector<double> times;
+};
+
+#endif
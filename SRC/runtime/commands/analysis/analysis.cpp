@@ -16,6 +16,7 @@
 
 #include <Matrix.h>
 #include <Domain.h> // for modal damping
+#include <Recorder.h>
 #include <AnalysisModel.h>
 
 #include "BasicAnalysisBuilder.h"
@@ -111,6 +112,21 @@ specifyAnalysis(ClientData clientData, Tcl_Interp *interp, int argc,
     );
     argi++;
   }
+
+  // options following the analysis type
+  for (int i = argi+1; i < argc; i++) {
+    if ((strcmp(argv[i], "-numThreads") == 0) ||
+        (strcmp(argv[i], "-threads") == 0)) {
+      int numThreads;
+      if (i+1 >= argc || Tcl_GetInt(interp, argv[i+1], &numThreads) != TCL_OK) {
+        opserr << G3_ERROR_PROMPT << "analysis -numThreads numThreads?\n";
+        return TCL_ERROR;
+      }
+      builder->setNumThreads(numThreads);
+      i++;
+    }
+  }
+
   if (strcmp(argv[argi], "Static") == 0) {
     builder->setStaticAnalysis();
     return TCL_OK;
@@ -253,6 +269,7 @@ eigenAnalysis(ClientData clientData, Tcl_Interp *interp, int argc,
   int loc = 1;
   double shift = 0.0;
   bool findSmallest = true;
+  bool warmStart = false;
   int numEigen = 0;
 
   // Check type of eigenvalue analysis
@@ -272,6 +289,11 @@ eigenAnalysis(ClientData clientData, Tcl_Interp *interp, int argc,
     else if ((strcmp(argv[loc], "-findLargest") == 0))
       findSmallest = false;
 
+    // start from the modes of the last eigen, for a sequence of nearby
+    // problems, e.g. the periods along a pushover
+    else if ((strcmp(argv[loc], "-warmStart") == 0))
+      warmStart = true;
+
     else if ((strcmp(argv[loc], "genBandArpack") == 0) ||
              (strcmp(argv[loc], "-genBandArpack") == 0) ||
              (strcmp(argv[loc], "genBandArpackEigen") == 0) ||
@@ -315,10 +337,17 @@ eigenAnalysis(ClientData clientData, Tcl_Interp *interp, int argc,
   for (int i = 0; i < requiredDataSize; ++i)
     resDataPtr[i] = '\n';
 
+  // only ARPACK takes a starting vector
+  if (warmStart == true && typeSolver != EigenSOE_TAGS_ArpackSOE) {
+    opserr << G3_WARN_PROMPT << "eigen -warmStart needs the genBandArpack "
+           << "solver; ignoring it\n";
+    warmStart = false;
+  }
+
   //
   // create a transient analysis if no analysis exists
   // 
-  builder->newEigenAnalysis(typeSolver, shift);
+  builder->newEigenAnalysis(typeSolver, shift, warmStart);
 
   int result = builder->eigen(numEigen,generalizedAlgo,findSmallest);
 
@@ -449,6 +478,7 @@ resetModel(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char ** cons
   Domain* domain = builder->getDomain();
   assert(domain != nullptr);
   domain->revertToStart();
+  Recorder::clearNodalReactions();
 
   TransientIntegrator *theTransientIntegrator =  builder->getTransientIntegrator();
   if (theTransientIntegrator != nullptr) {
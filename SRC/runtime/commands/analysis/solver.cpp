@@ -34,6 +34,8 @@
 #include <SProfileSPDLinSolver.h>
 #include <SProfileSPDLinSOE.h>
 #include <ProfileSPDLinDirectThreadSolver.h>
+#include <BandSPDLinThreadSolver.h>
+#include <ThreadPool.h>
 #include <SparseGenColLinSOE.h>
 #include <SparseGenRowLinSOE.h>
 #include <SymSparseLinSOE.h>
@@ -144,21 +146,6 @@ G3Parse_newLinearSOE(ClientData clientData, Tcl_Interp* interp, int argc, G3_Cha
     // TODO: if "umfpack" is in solver.hpp, this wont be reached
     return TclDispatch_newUmfpackLinearSOE(clientData, interp, argc, argv);
   } 
-#if 0
-  else if (strcmp(argv[2],"Thread") == 0) {  
-      int blockSize = 4;
-      int numThreads = 1;
-      if (argc == 5) {
-	if (Tcl_GetInt(interp, argv[3], &blockSize) != TCL_OK)
-	  return nullptr; //TCL_ERROR;
-	if (Tcl_GetInt(interp, argv[4], &numThreads) != TCL_OK)
-	  return nullptr; //TCL_ERROR;
-      }
-      return new ProfileSPDLinSOE(
-          *new ProfileSPDLinDirectThreadSolver(numThreads,blockSize,1.0e-12)
-      );
-  } 
-#endif
 
 #if defined(OPS_PETSC)
   else if (strcmp(argv[1], "petsc")==0 ||
@@ -199,6 +186,7 @@ specify_SparseSPD(G3_Runtime *rt, int argc, G3_Char ** const argv)
 {
 //if ((strcmp(argv[1], "SparseSPD") == 0) ||
 //         (strcmp(argv[1], "SparseSYM") == 0)) {
+//   system SparseSYM <$ordering> <-numThreads $n>
     Tcl_Interp *interp = G3_getInterpreter(rt);
 
     // determine ordering scheme
@@ -207,15 +195,113 @@ specify_SparseSPD(G3_Runtime *rt, int argc, G3_Char ** const argv)
     //   3 -- RCM
 
     int lSparse = 1;
-    if (argc == 3) {
-      if (Tcl_GetInt(interp, argv[2], &lSparse) != TCL_OK)
+    int numThreads = 1;
+    for (int i=2; i<argc; i++) {
+      if ((strcmp(argv[i], "-numThreads") == 0) ||
+          (strcmp(argv[i], "-nt") == 0)) {
+        if (++i >= argc || Tcl_GetInt(interp, argv[i], &numThreads) != TCL_OK
+            || numThreads < 0) {
+          opserr << G3_ERROR_PROMPT << "system " << argv[1] 
+                 << " -numThreads requires a non-negative integer\n";
+          return nullptr;
+        }
+        if (numThreads == 0)
+          numThreads = ThreadPool::getNumProcessors();
+
+      } else if (Tcl_GetInt(interp, argv[i], &lSparse) != TCL_OK) {
+        opserr << G3_ERROR_PROMPT << "system " << argv[1] 
+               << " unknown option " << argv[i] << "\n";
         return nullptr;
+      }
     }
-    SymSparseLinSolver *theSolver = new SymSparseLinSolver();
+
+    SymSparseLinSolver *theSolver = new SymSparseLinSolver(numThreads);
     return new SymSparseLinSOE(*theSolver, lSparse);
 }
 
 
+// Parse the options shared by the banded and skyline SPD systems,
+//   system BandSPD|ProfileSPD <-numThreads $n> <-blockSize $b>
+// where $n = 0 uses all hardware threads and $b is the number of columns
+// factored together between synchronisations of the threads.
+static int
+parseThreadOptions(Tcl_Interp *interp, int argc, G3_Char ** const argv,
+                   int &numThreads, int &blockSize)
+{
+  numThreads = 1;
+  blockSize  = 64;
+
+  for (int i=2; i<argc; i++) {
+    if ((strcmp(argv[i], "-numThreads") == 0) ||
+        (strcmp(argv[i], "-nt") == 0)) {
+      if (++i >= argc || Tcl_GetInt(interp, argv[i], &numThreads) != TCL_OK) {
+        opserr << G3_ERROR_PROMPT << "system " << argv[1] 
+               << " -numThreads requires an integer\n";
+        return TCL_ERROR;
+      }
+      if (numThreads == 0)
+        numThreads = ThreadPool::getNumProcessors();
+
+    } else if (strcmp(argv[i], "-blockSize") == 0) {
+      if (++i >= argc || Tcl_GetInt(interp, argv[i], &blockSize) != TCL_OK
+          || blockSize < 1) {
+        opserr << G3_ERROR_PROMPT << "system " << argv[1] 
+               << " -blockSize requires a positive integer\n";
+        return TCL_ERROR;
+      }
+
+    } else {
+      opserr << G3_ERROR_PROMPT << "system " << argv[1] 
+             << " unknown option " << argv[i] << "\n";
+      return TCL_ERROR;
+    }
+  }
+
+  if (numThreads < 1) {
+    opserr << G3_ERROR_PROMPT << "system " << argv[1] 
+           << " -numThreads must not be negative\n";
+    return TCL_ERROR;
+  }
+  return TCL_OK;
+}
+
+LinearSOE*
+specifyProfileSPD(G3_Runtime *rt, int argc, G3_Char ** const argv)
+{
+  Tcl_Interp *interp = G3_getInterpreter(rt);
+
+  int numThreads, blockSize;
+  if (parseThreadOptions(interp, argc, argv, numThreads, blockSize) != TCL_OK)
+    return nullptr;
+
+  ProfileSPDLinSolver *theSolver;
+  if (numThreads > 1)
+    theSolver = new ProfileSPDLinDirectThreadSolver(numThreads, blockSize, 1.0e-12);
+  else
+    theSolver = new ProfileSPDLinDirectSolver();
+
+  return new ProfileSPDLinSOE(*theSolver);
+}
+
+LinearSOE*
+specifyBandSPD(G3_Runtime *rt, int argc, G3_Char ** const argv)
+{
+  Tcl_Interp *interp = G3_getInterpreter(rt);
+
+  int numThreads, blockSize;
+  if (parseThreadOptions(interp, argc, argv, numThreads, blockSize) != TCL_OK)
+    return nullptr;
+
+  BandSPDLinSolver *theSolver;
+  if (numThreads > 1)
+    theSolver = new BandSPDLinThreadSolver(numThreads, blockSize);
+  else
+    theSolver = new BandSPDLinLapackSolver();
+
+  return new BandSPDLinSOE(*theSolver);
+}
+
+
 #ifdef _THREADS
 #  include "contrib/sys_of_eqn/ThreadedSuperLU/ThreadedSuperLU.h"
 #else
@@ -96,6 +96,8 @@ typedef LinearSOE*(G3_SysOfEqnSpecifier)(G3_Runtime*, int, G3_Char**);
 // Specifiers defined in solver.cpp
 G3_SysOfEqnSpecifier specify_SparseSPD;
 G3_SysOfEqnSpecifier specifySparseGen;
+G3_SysOfEqnSpecifier specifyProfileSPD;
+G3_SysOfEqnSpecifier specifyBandSPD;
 TclDispatch<LinearSOE*> TclDispatch_newMumpsLinearSOE;
 // TclDispatch<LinearSOE*> TclDispatch_newUmfpackLinearSOE;
 LinearSOE* TclDispatch_newUmfpackLinearSOE(ClientData, Tcl_Interp*, int, const char** const);
@@ -114,7 +116,7 @@ struct soefps {fn ss, sp, mp;};
 
 std::unordered_map<std::string, struct soefps> soe_table = {
   {"bandspd", {
-     G3_SOE(BandSPDLinLapackSolver,      BandSPDLinSOE),
+     specifyBandSPD,
      SP_SOE(BandSPDLinLapackSolver,      DistributedBandSPDLinSOE),
      MP_SOE(BandSPDLinLapackSolver,      DistributedBandSPDLinSOE)}},
 
@@ -161,7 +163,7 @@ std::unordered_map<std::string, struct soefps> soe_table = {
      MP_SOE(SProfileSPDLinSolver,        SProfileSPDLinSOE)}},
 
   {"profilespd", {
-     G3_SOE(ProfileSPDLinDirectSolver,   ProfileSPDLinSOE),
+     specifyProfileSPD,
      SP_SOE(ProfileSPDLinDirectSolver,   DistributedProfileSPDLinSOE),
      MP_SOE(ProfileSPDLinDirectSolver,   DistributedProfileSPDLinSOE)}},
 
@@ -116,6 +116,7 @@ G3_AddTclDomainCommands(Tcl_Interp *interp, Domain* the_domain)
   Tcl_CreateCommand(interp, "eleForce",            &eleForce,            domain, nullptr);
   Tcl_CreateCommand(interp, "eleResponse",         &eleResponse,         domain, nullptr);
   Tcl_CreateCommand(interp, "eleDynamicalForce",   &eleDynamicalForce,   domain, nullptr);
+  Tcl_CreateCommand(interp, "responseQuery",       &responseQuery,       domain, nullptr);
 
   Tcl_CreateCommand(interp, "nodeDOFs",            &nodeDOFs,            domain, nullptr);
   Tcl_CreateCommand(interp, "nodeCoord",           &nodeCoord,           domain, nullptr);
@@ -258,6 +259,7 @@ InitialStateAnalysis(ClientData clientData, Tcl_Interp *interp, int argc,
 
     // call revert to start to zero the displacements
     the_domain->revertToStart();
+    Recorder::clearNodalReactions();
 
     // set global variable to false
     // FMK changes for parallel
@@ -68,6 +68,9 @@ Tcl_CmdProc eleDynamicalForce;
 
 Tcl_CmdProc eleResponse;
 
+// domain/query.cpp
+Tcl_CmdProc responseQuery;
+
 Tcl_CmdProc findID;
 
 
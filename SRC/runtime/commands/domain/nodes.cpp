@@ -20,6 +20,7 @@
 #include <Vector.h>
 #include <Matrix.h>
 #include <Domain.h>
+#include <Recorder.h>
 #include <DOF_Group.h>
 #include <Node.h>
 #include <NodeIter.h>
@@ -779,6 +780,7 @@ calculateNodalReactions(ClientData clientData, Tcl_Interp *interp, int argc,
   }
 
   the_domain->calculateNodalReactions(incInertia);
+  Recorder::clearNodalReactions();
 
   return TCL_OK;
 }
@@ -0,0 +1,253 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: This file implements the responseQuery command, which
+// creates handles on element and node responses that are looked up once
+// and then evaluated on each request, for scripts that poll many
+// responses after every step:
+//
+//   set q [responseQuery element {1 2 3} force]
+//   responseQuery add $q node {4 5} -dof {1 2} disp
+//   responseQuery values $q   ;# flat list, elements then nodes
+//   responseQuery size   $q
+//   responseQuery delete $q
+//
+// All commands assume a Domain* is passed as clientData. A query keeps
+// the Domain it was created on, so wipe deletes all the queries of the
+// interpreter.
+//
+#include <assert.h>
+#include <string.h>
+#include <map>
+#include <tcl.h>
+#include <Logging.h>
+#include <ID.h>
+#include <Domain.h>
+#include <NodeData.h>
+#include <ResponseQuery.h>
+
+// the queries of an interpreter, by handle
+struct ResponseQueries {
+  std::map<int, ResponseQuery *> queries;
+  std::vector<Tcl_Obj *> values;
+  int nextTag = 1;
+};
+
+static void
+deleteResponseQueries(ClientData clientData, Tcl_Interp *interp)
+{
+  ResponseQueries *theQueries = (ResponseQueries *)clientData;
+  for (auto &entry : theQueries->queries)
+    delete entry.second;
+  delete theQueries;
+}
+
+static ResponseQueries *
+getResponseQueries(Tcl_Interp *interp)
+{
+  ResponseQueries *theQueries =
+      (ResponseQueries *)Tcl_GetAssocData(interp, "OPS::ResponseQueries", NULL);
+  if (theQueries == nullptr) {
+    theQueries = new ResponseQueries();
+    Tcl_SetAssocData(interp, "OPS::ResponseQueries", &deleteResponseQueries,
+                     (ClientData)theQueries);
+  }
+  return theQueries;
+}
+
+// delete the queries of interp; called by wipe, as the queries point to
+// the Domain being deleted. the handles are not reused, so a handle kept
+// by the script does not name a query created after the wipe.
+void
+G3_ClearResponseQueries(Tcl_Interp *interp)
+{
+  ResponseQueries *theQueries =
+      (ResponseQueries *)Tcl_GetAssocData(interp, "OPS::ResponseQueries", NULL);
+  if (theQueries == nullptr)
+    return;
+
+  for (auto &entry : theQueries->queries)
+    delete entry.second;
+  theQueries->queries.clear();
+}
+
+static ResponseQuery *
+getResponseQuery(Tcl_Interp *interp, ResponseQueries *theQueries, TCL_Char *handle)
+{
+  int tag;
+  if (Tcl_GetInt(interp, handle, &tag) != TCL_OK) {
+    opserr << G3_ERROR_PROMPT << "responseQuery - could not read handle " << handle << "\n";
+    return nullptr;
+  }
+
+  auto it = theQueries->queries.find(tag);
+  if (it == theQueries->queries.end()) {
+    opserr << G3_ERROR_PROMPT << "responseQuery - no query with handle " << tag << "\n";
+    return nullptr;
+  }
+  return it->second;
+}
+
+static int
+getTags(Tcl_Interp *interp, TCL_Char *list, ID &tags)
+{
+  int numTags;
+  TCL_Char **tagStrings;
+  if (Tcl_SplitList(interp, list, &numTags, &tagStrings) != TCL_OK)
+    return TCL_ERROR;
+
+  tags.resize(numTags);
+  for (int i = 0; i < numTags; ++i) {
+    if (Tcl_GetInt(interp, tagStrings[i], &tags(i)) != TCL_OK) {
+      Tcl_Free((char *)tagStrings);
+      return TCL_ERROR;
+    }
+  }
+  Tcl_Free((char *)tagStrings);
+  return TCL_OK;
+}
+
+static int
+getNodeData(TCL_Char *name, NodeData &type)
+{
+  if (strcmp(name, "disp") == 0)
+    type = NodeData::Disp;
+  else if (strcmp(name, "vel") == 0)
+    type = NodeData::Vel;
+  else if (strcmp(name, "accel") == 0)
+    type = NodeData::Accel;
+  else if (strcmp(name, "incrDisp") == 0)
+    type = NodeData::IncrDisp;
+  else if (strcmp(name, "incrDeltaDisp") == 0)
+    type = NodeData::IncrDeltaDisp;
+  else if (strcmp(name, "reaction") == 0)
+    type = NodeData::Reaction;
+  else if (strcmp(name, "unbalance") == 0)
+    type = NodeData::UnbalancedLoad;
+  else
+    return TCL_ERROR;
+  return TCL_OK;
+}
+
+//
+// add the item given by argv[0..argc) to the query, i.e.
+//   element eleTags? args...
+//   node    nodeTags? <-dof dofs?> disp|vel|accel|incrDisp|incrDeltaDisp|reaction|unbalance
+//
+static int
+addResponse(Tcl_Interp *interp, ResponseQuery &theQuery, int argc,
+            TCL_Char ** const argv)
+{
+  if (argc < 3) {
+    opserr << G3_ERROR_PROMPT << "want - responseQuery ... element|node tags? args...\n";
+    return TCL_ERROR;
+  }
+
+  ID tags;
+  if (getTags(interp, argv[1], tags) != TCL_OK) {
+    opserr << G3_ERROR_PROMPT << "responseQuery - could not read tags " << argv[1] << "\n";
+    return TCL_ERROR;
+  }
+
+  if (strcmp(argv[0], "element") == 0) {
+    if (theQuery.addElementResponse(tags, argv + 2, argc - 2) != 0)
+      return TCL_ERROR;
+
+  } else if (strcmp(argv[0], "node") == 0) {
+    int loc = 2;
+    ID dofs;
+    if (strcmp(argv[loc], "-dof") == 0) {
+      if (argc < 5 || getTags(interp, argv[loc + 1], dofs) != TCL_OK) {
+        opserr << G3_ERROR_PROMPT << "responseQuery node - could not read dofs\n";
+        return TCL_ERROR;
+      }
+      for (int i = 0; i < dofs.Size(); ++i)
+        dofs(i)--;
+      loc += 2;
+    }
+
+    NodeData type;
+    if (getNodeData(argv[loc], type) != TCL_OK) {
+      opserr << G3_ERROR_PROMPT << "responseQuery node - unknown response " << argv[loc] << "\n";
+      return TCL_ERROR;
+    }
+    if (theQuery.addNodeResponse(tags, type, &dofs) != 0)
+      return TCL_ERROR;
+
+  } else {
+    opserr << G3_ERROR_PROMPT << "responseQuery - unknown item " << argv[0]
+           << ", want element or node\n";
+    return TCL_ERROR;
+  }
+
+  return TCL_OK;
+}
+
+int
+responseQuery(ClientData clientData, Tcl_Interp *interp, int argc,
+              TCL_Char ** const argv)
+{
+  assert(clientData != nullptr);
+  Domain *the_domain = (Domain*)clientData;
+
+  if (argc < 2) {
+    opserr << G3_ERROR_PROMPT << "want - responseQuery element|node|add|values|size|delete ...\n";
+    return TCL_ERROR;
+  }
+
+  ResponseQueries *theQueries = getResponseQueries(interp);
+
+  if (strcmp(argv[1], "element") == 0 || strcmp(argv[1], "node") == 0) {
+    ResponseQuery *theQuery = new ResponseQuery(*the_domain);
+    if (addResponse(interp, *theQuery, argc - 1, argv + 1) != TCL_OK) {
+      delete theQuery;
+      return TCL_ERROR;
+    }
+    int tag = theQueries->nextTag++;
+    theQueries->queries[tag] = theQuery;
+    Tcl_SetObjResult(interp, Tcl_NewIntObj(tag));
+    return TCL_OK;
+  }
+
+  if (argc < 3) {
+    opserr << G3_ERROR_PROMPT << "want - responseQuery " << argv[1] << " handle?\n";
+    return TCL_ERROR;
+  }
+
+  ResponseQuery *theQuery = getResponseQuery(interp, theQueries, argv[2]);
+  if (theQuery == nullptr)
+    return TCL_ERROR;
+
+  if (strcmp(argv[1], "add") == 0) {
+    return addResponse(interp, *theQuery, argc - 3, argv + 3);
+
+  } else if (strcmp(argv[1], "values") == 0) {
+    if (theQuery->update() < 0)
+      opserr << G3_WARN_PROMPT << "responseQuery values - a response failed\n";
+
+    const int size = theQuery->getNumValues();
+    const double *data = theQuery->getData();
+
+    std::vector<Tcl_Obj *> &values = theQueries->values;
+    values.resize(size);
+    for (int i = 0; i < size; ++i)
+      values[i] = Tcl_NewDoubleObj(data[i]);
+    Tcl_SetObjResult(interp, Tcl_NewListObj(size, values.data()));
+    return TCL_OK;
+
+  } else if (strcmp(argv[1], "size") == 0) {
+    Tcl_SetObjResult(interp, Tcl_NewIntObj(theQuery->getNumValues()));
+    return TCL_OK;
+
+  } else if (strcmp(argv[1], "delete") == 0) {
+    theQueries->queries.erase(atoi(argv[2]));
+    delete theQuery;
+    return TCL_OK;
+  }
+
+  opserr << G3_ERROR_PROMPT << "responseQuery - unknown option " << argv[1] << "\n";
+  return TCL_ERROR;
+}
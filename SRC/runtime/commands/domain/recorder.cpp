@@ -41,6 +41,8 @@
 #include <DataFileStreamAdd.h>
 #include <XmlFileStream.h>
 #include <BinaryFileStream.h>
+#include <ColumnFileStream.h>
+#include <AsyncStream.h>
 #include <DatabaseStream.h>
 #include <DummyStream.h>
 #include <TCP_Stream.h>
@@ -98,6 +100,8 @@ struct OutputOptions {
   int writeBufferSize   = 0;
   bool doScientific     = false;
   bool closeOnWrite     = false;
+  bool compress         = false;
+  bool async            = false;
 
   FE_Datastore *theDatabase = nullptr;
 
@@ -110,8 +114,12 @@ struct OutputOptions {
     DATA_STREAM_CSV,
     TCP_STREAM,
     DATA_STREAM_ADD,
+    COLUMN_STREAM,
     MODE_UNSPECIFIED
   } eMode = STANDARD_STREAM;
+
+  // the format given by -format, which overrides that of the file flag
+  Mode eFormat = MODE_UNSPECIFIED;
 };
 
 
@@ -124,6 +132,17 @@ createOutputStream(OutputOptions &options)
 {
   OPS_Stream *theOutputStream = nullptr;
 
+  if (options.eFormat != OutputOptions::MODE_UNSPECIFIED) {
+    if (options.filename != nullptr) {
+      // text keeps the adding stream of -fileAdd
+      if (options.eFormat != OutputOptions::DATA_STREAM ||
+          options.eMode != OutputOptions::DATA_STREAM_ADD)
+        options.eMode = options.eFormat;
+    } else
+      opserr << G3_WARN_PROMPT << "recorder -format needs a file name, "
+             << "given by -file; ignoring it\n";
+  }
+
   // construct the DataHandler
   if (options.filename != nullptr) {
     if (options.eMode == OutputOptions::DATA_STREAM) {
@@ -155,6 +174,11 @@ createOutputStream(OutputOptions &options)
 
     } else if (options.eMode == OutputOptions::BINARY_STREAM) {
       theOutputStream = new BinaryFileStream(options.filename);
+
+    } else if (options.eMode == OutputOptions::COLUMN_STREAM) {
+      theOutputStream = new ColumnFileStream(options.filename,
+                                             openMode::OVERWRITE,
+                                             options.compress);
     }
 
   } else if (options.eMode == OutputOptions::TCP_STREAM && options.inetAddr != 0) {
@@ -169,6 +193,15 @@ createOutputStream(OutputOptions &options)
 
   theOutputStream->setPrecision(options.precision);
 
+  // write the rows on a thread of their own, the -buffer option giving
+  // the number of rows held before record() waits for the writer
+  if (options.async) {
+    if (options.writeBufferSize > 0)
+      theOutputStream = new AsyncStream(theOutputStream, options.writeBufferSize);
+    else
+      theOutputStream = new AsyncStream(theOutputStream);
+  }
+
   return theOutputStream;
 }
 
@@ -292,6 +325,41 @@ parseOutputOption(OutputOptions *options, Tcl_Interp* interp, int argc, TCL_Char
       loc++;
     }
 
+    else if (strcmp(argv[loc], "-compress") == 0) {
+      options->compress = true;
+      loc++;
+    }
+
+    // -format text|csv|xml|binary|columns selects the format of the file
+    // named by -file, as -file, -csv, -xml, -binary and -columns do
+    else if (strcmp(argv[loc], "-format") == 0) {
+      if (++loc >= argc) {
+        opserr << G3_ERROR_PROMPT << "expected format after flag '-format'\n";
+        return -1;
+      }
+      if (strcmp(argv[loc], "text") == 0 || strcmp(argv[loc], "txt") == 0)
+        options->eFormat = OutputOptions::DATA_STREAM;
+      else if (strcmp(argv[loc], "csv") == 0)
+        options->eFormat = OutputOptions::DATA_STREAM_CSV;
+      else if (strcmp(argv[loc], "xml") == 0)
+        options->eFormat = OutputOptions::XML_STREAM;
+      else if (strcmp(argv[loc], "binary") == 0)
+        options->eFormat = OutputOptions::BINARY_STREAM;
+      else if (strcmp(argv[loc], "columns") == 0)
+        options->eFormat = OutputOptions::COLUMN_STREAM;
+      else {
+        opserr << G3_ERROR_PROMPT << "unknown recorder format '" << argv[loc]
+               << "', want text, csv, xml, binary or columns\n";
+        return -1;
+      }
+      loc++;
+    }
+
+    else if (strcmp(argv[loc], "-async") == 0) {
+      options->async = true;
+      loc++;
+    }
+
     else if (strcmp(argv[loc], "-buffer") == 0 ||
              strcmp(argv[loc], "-bufferSize") == 0) {
       loc++;
@@ -320,6 +388,10 @@ parseOutputOption(OutputOptions *options, Tcl_Interp* interp, int argc, TCL_Char
       else if ((strcmp(argv[loc], "-binary") == 0)) {
         eMode = OutputOptions::BINARY_STREAM;
       }
+      else if ((strcmp(argv[loc], "-columns") == 0) ||
+               (strcmp(argv[loc], "-fileColumns") == 0)) {
+        eMode = OutputOptions::COLUMN_STREAM;
+      }
       else if ((strcmp(argv[loc], "-TCP") == 0) ||
                (strcmp(argv[loc], "-tcp") == 0)) {
         options->inetAddr = argv[loc + 1];
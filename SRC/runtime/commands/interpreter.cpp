@@ -36,6 +36,8 @@ int TclObjCommand_pragma([[maybe_unused]] ClientData clientData,
 Tcl_CmdProc convertBinaryToText;
 Tcl_CmdProc convertTextToBinary;
 Tcl_CmdProc stripOpenSeesXML;
+Tcl_CmdProc convertColumnsToText;
+Tcl_CmdProc readColumns;
 
 //
 // Consider reimplmenting to use Tcl built-ins; see
@@ -294,7 +296,9 @@ static int
 OpenSeesExit(ClientData clientData, Tcl_Interp *interp, int argc,
              TCL_Char ** const argv)
 {
-  //  theDomain.clearAll();
+  // wipe the model, deleting the recorders so that the rows their streams
+  // still hold are written and their files closed
+  Tcl_Eval(interp, "wipe");
 
 #ifdef _PARALLEL_PROCESSING
   // mpi clean up
@@ -391,6 +395,8 @@ OpenSeesAppInit(Tcl_Interp *interp)
   Tcl_CreateCommand(interp, "stripXML",            stripOpenSeesXML,    nullptr, NULL);
   Tcl_CreateCommand(interp, "convertBinaryToText", convertBinaryToText, nullptr, NULL);
   Tcl_CreateCommand(interp, "convertTextToBinary", convertTextToBinary, nullptr, NULL);
+  Tcl_CreateCommand(interp, "convertColumnsToText", convertColumnsToText, nullptr, NULL);
+  Tcl_CreateCommand(interp, "readColumns",         readColumns,         nullptr, NULL);
   Tcl_CreateCommand(interp, "setMaxOpenFiles",     maxOpenFiles,        nullptr, nullptr);
 
   // Some entry points
@@ -17,6 +17,7 @@
 #include <Logging.h>
 #include <runtimeAPI.h>
 #include <Domain.h>
+#include <Recorder.h>
 #include <FE_Datastore.h>
 
 #include "BasicModelBuilder.h"
@@ -33,6 +34,7 @@ FE_Datastore *theDatabase = nullptr;
 
 extern int G3_AddTclAnalysisAPI(Tcl_Interp *, Domain*);
 extern int G3_AddTclDomainCommands(Tcl_Interp *, Domain*);
+extern void G3_ClearResponseQueries(Tcl_Interp *);
 
 int
 TclCommand_specifyModel(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char *argv[])
@@ -241,8 +243,10 @@ TclCommand_wipeModel(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Ch
     delete theDatabase;
 
   if (builder != nullptr) {
+    G3_ClearResponseQueries(interp);
     Domain* theDomain = builder->getDomain();
     theDomain->clearAll();
+    Recorder::clearNodalReactions();
     ops_TheActiveDomain = nullptr;
     delete theDomain;
     delete builder;
@@ -1311,7 +1311,7 @@ TclCommand_addPatch(ClientData clientData,
   else if (strcmp(argv[1], "circ") == 0) {
     int numSubdivRad, numSubdivCirc, matTag;
     double yCenter, zCenter;
-    Vector centerPosition(2);
+    VectorND<2> centerPosition;
     double intRad, extRad;
     double startAng, endAng;
 
@@ -5,13 +5,16 @@
 //===----------------------------------------------------------------------===//
 //
 // Description: This file provides basic file format handling commands,
-// such as naive XML processing and binary conversion.
+// such as naive XML processing, binary conversion and reading the
+// column files of ColumnFileStream.
 //
 #include <tcl.h>
 #include <string>
 #include <iomanip>
 #include <fstream>
+#include <vector>
 #include <OPS_Globals.h>
+#include <ColumnFileReader.h>
 
 extern int binaryToText(const char *inputFile, const char *outputFile);
 extern int textToBinary(const char *inputFile, const char *outputFile);
@@ -122,3 +125,104 @@ stripOpenSeesXML(ClientData clientData, Tcl_Interp *interp, int argc,
 
   return 0;
 }
+
+int
+convertColumnsToText(ClientData clientData, Tcl_Interp *interp, int argc,
+                     TCL_Char ** const argv)
+{
+  if (argc < 3) {
+    opserr << "ERROR incorrect # args - convertColumnsToText inputFile "
+              "outputFile\n";
+    return TCL_ERROR;
+  }
+
+  ColumnFileReader theReader;
+  if (theReader.open(argv[1]) != 0)
+    return TCL_ERROR;
+
+  std::ofstream theOutputFile(argv[2], std::ios::out);
+  if (!theOutputFile.is_open()) {
+    opserr << "convertColumnsToText - error opening output file: " << argv[2]
+           << endln;
+    return TCL_ERROR;
+  }
+  theOutputFile << std::setprecision(16);
+
+  // read a block of rows of every column, then write them out by rows
+  int numColumns = theReader.getNumColumns();
+  unsigned long long numRows = theReader.getNumRows();
+  const unsigned long long blockRows = 4096;
+  std::vector<std::vector<double>> columns(numColumns);
+  for (unsigned long long first = 0; first < numRows; first += blockRows) {
+    int n = 0;
+    for (int j = 0; j < numColumns; j++)
+      if ((n = theReader.readColumn(j, columns[j], first, blockRows)) < 0)
+        return TCL_ERROR;
+
+    for (int i = 0; i < n; i++) {
+      for (int j = 0; j < numColumns; j++)
+        theOutputFile << columns[j][i] << (j+1 < numColumns ? " " : "\n");
+    }
+  }
+
+  theOutputFile.close();
+  return TCL_OK;
+}
+
+//
+// readColumns file            -> the names of the columns
+// readColumns file column ... -> a list of the values of each column,
+//                                the columns given by name or index
+//
+int
+readColumns(ClientData clientData, Tcl_Interp *interp, int argc,
+            TCL_Char ** const argv)
+{
+  if (argc < 2) {
+    opserr << "ERROR incorrect # args - readColumns inputFile <column ...>\n";
+    return TCL_ERROR;
+  }
+
+  ColumnFileReader theReader;
+  if (theReader.open(argv[1]) != 0)
+    return TCL_ERROR;
+
+  Tcl_Obj *result = Tcl_NewListObj(0, nullptr);
+
+  if (argc == 2) {
+    for (int j = 0; j < theReader.getNumColumns(); j++)
+      Tcl_ListObjAppendElement(interp, result,
+                               Tcl_NewStringObj(theReader.getColumnName(j), -1));
+    Tcl_SetObjResult(interp, result);
+    return TCL_OK;
+  }
+
+  std::vector<double> values;
+  for (int i = 2; i < argc; i++) {
+    int col = theReader.getColumn(argv[i]);
+    if (col < 0 && Tcl_GetInt(interp, argv[i], &col) != TCL_OK) {
+      Tcl_ResetResult(interp);
+      opserr << "WARNING readColumns - no column " << argv[i] << endln;
+      Tcl_DecrRefCount(result);
+      return TCL_ERROR;
+    }
+
+    if (theReader.readColumn(col, values) < 0) {
+      Tcl_DecrRefCount(result);
+      return TCL_ERROR;
+    }
+
+    Tcl_Obj *column = Tcl_NewListObj(0, nullptr);
+    for (double value : values)
+      Tcl_ListObjAppendElement(interp, column, Tcl_NewDoubleObj(value));
+
+    if (argc == 3) {
+      Tcl_DecrRefCount(result);
+      result = column;
+    } else
+      Tcl_ListObjAppendElement(interp, result, column);
+  }
+
+  Tcl_SetObjResult(interp, result);
+  return TCL_OK;
+}
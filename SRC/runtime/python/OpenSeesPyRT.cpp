@@ -21,6 +21,7 @@ namespace py = pybind11;
 #include <NodeData.h>
 #include <Element.h>
 #include <SectionForceDeformation.h>
+#include <ResponseQuery.h>
 #include <UniaxialMaterial.h>
 #include <NDMaterial.h>
 #include <HystereticBackbone.h>
@@ -503,6 +504,54 @@ init_obj_module(py::module &m)
     })
     .def ("getTime", &Domain::getCurrentTime)
   ;
+
+  //
+  // ResponseQuery; values() evaluates the query and returns its values in
+  // a new array, values(out) fills the C contiguous float64 array out of
+  // size() values instead, so a loop over the steps need not allocate
+  //
+  py::class_<ResponseQuery>(m, "ResponseQuery")
+    .def (py::init<Domain &>(), py::keep_alive<1, 2>())
+    .def ("addElementResponse", [](ResponseQuery &query, std::vector<int> tags, std::vector<std::string> args) {
+        ID eleTags(tags.data(), (int)tags.size());
+        std::vector<const char *> argv;
+        for (const std::string &arg : args)
+          argv.push_back(arg.c_str());
+        return query.addElementResponse(eleTags, argv.data(), (int)argv.size());
+    }, py::arg("tags"), py::arg("args"))
+    .def ("addNodeResponse", [](ResponseQuery &query, std::vector<int> tags, std::string type, std::vector<int> dofs) {
+        NodeData typ;
+        if (type == "displ")      typ = NodeData::Disp;
+        else if (type == "veloc") typ = NodeData::Vel;
+        else if (type == "accel") typ = NodeData::Accel;
+        else if (type == "react") typ = NodeData::Reaction;
+        else
+          throw std::invalid_argument("unknown node response " + type);
+        ID nodeTags(tags.data(), (int)tags.size());
+        ID nodeDOFs((int)dofs.size());
+        for (int i=0; i<(int)dofs.size(); i++)
+          nodeDOFs(i) = dofs[i] - 1;
+        return query.addNodeResponse(nodeTags, typ, &nodeDOFs);
+    }, py::arg("tags"), py::arg("type"), py::arg("dofs") = std::vector<int>())
+    .def ("update", &ResponseQuery::update)
+    .def ("size",   &ResponseQuery::getNumValues)
+    .def ("values", [](ResponseQuery &query, py::object out) {
+        query.update();
+        py::ssize_t numValues = query.getNumValues();
+        py::array_t<double, py::array::c_style> result;
+        if (out.is_none())
+          result = py::array_t<double, py::array::c_style>(numValues);
+        else {
+          if (!py::isinstance<py::array_t<double, py::array::c_style>>(out))
+            throw std::invalid_argument("out must be a C contiguous float64 array");
+          result = py::reinterpret_borrow<py::array_t<double, py::array::c_style>>(out);
+          if (result.size() != numValues || !result.writeable())
+            throw std::invalid_argument("out must be a writeable array of size() values");
+        }
+        std::copy(query.getData(), query.getData() + numValues, result.mutable_data());
+        return result;
+    }, py::arg("out") = py::none())
+  ;
   
   py::class_<G3_Runtime>(m, "_Runtime")
   ;
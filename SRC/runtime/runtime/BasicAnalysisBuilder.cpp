@@ -133,6 +133,9 @@ BasicAnalysisBuilder::wipe()
 void
 BasicAnalysisBuilder::setLinks(CurrentAnalysis flag)
 {
+  if (theAnalysisModel)
+    theAnalysisModel->setNumThreads(numThreads);
+
   if (theSOE && theAnalysisModel)
     theSOE->setLinks(*theAnalysisModel);
 
@@ -183,6 +186,15 @@ BasicAnalysisBuilder::setLinks(CurrentAnalysis flag)
   }
 }
 
+void
+BasicAnalysisBuilder::setNumThreads(int n)
+{
+  numThreads = n > 1 ? n : 1;
+
+  if (theAnalysisModel != nullptr)
+    theAnalysisModel->setNumThreads(numThreads);
+}
+
 int
 BasicAnalysisBuilder::initialize(void)
 {
@@ -711,7 +723,7 @@ BasicAnalysisBuilder::newTransientAnalysis()
 
 
 void
-BasicAnalysisBuilder::newEigenAnalysis(int typeSolver, double shift)
+BasicAnalysisBuilder::newEigenAnalysis(int typeSolver, double shift, bool warmStart)
 {
   assert(theAnalysisModel != nullptr);
 
@@ -752,6 +764,10 @@ BasicAnalysisBuilder::newEigenAnalysis(int typeSolver, double shift)
     theEigenSOE->setLinks(*theAnalysisModel);
     theEigenSOE->setLinearSOE(*theSOE);
   } // theEigenSOE == 0
+
+  // the solver is kept between calls, so it can start from the last modes
+  if (theEigenSOE->getClassTag() == EigenSOE_TAGS_ArpackSOE)
+    ((ArpackSOE *)theEigenSOE)->setWarmStart(warmStart);
 }
 
 int
@@ -860,6 +876,10 @@ BasicAnalysisBuilder::eigen(int numMode, bool generalized, bool findSmallest)
       return -4;
   }
 
+  if (theEigenSOE->getClassTag() == EigenSOE_TAGS_ArpackSOE)
+    opsdbg << G3_DEBUG_PROMPT << "eigen - ARPACK took "
+           << ((ArpackSOE *)theEigenSOE)->getNumIterations() << " iterations\n";
+
   //
   // Store the eigenvalues and eigenvectors in the model
   //
@@ -63,6 +63,10 @@ public:
 
     LinearSOE* getLinearSOE();
 
+    // number of threads used by the AnalysisModel to set the
+    // trial response of the nodes
+    void setNumThreads(int numThreads);
+
     Domain* getDomain();
     int initialize();
 
@@ -71,7 +75,7 @@ public:
     int  setTransientAnalysis();
 
     //   Eigen
-    void newEigenAnalysis(int typeSolver, double shift);
+    void newEigenAnalysis(int typeSolver, double shift, bool warmStart = false);
     int  eigen(int numMode, bool generalized, bool findSmallest);
     int  getNumEigen() {return numEigen;};
 
@@ -122,6 +126,7 @@ private:
 
     int numSubLevels = 0;
     int numSubSteps  = 0;
+    int numThreads   = 1;
 
     bool freeSOE = true;
     bool freeTI  = true;
@@ -39,12 +39,18 @@
 #include <FEM_ObjectBroker.h>
 #include <AnalysisModel.h>
 #include <LinearSOE.h>
+#include <SparsePattern.h>
+#include <ThreadPool.h>
+
+// number of non-zeros below which M*v is formed on the calling thread
+static const int minThreadedNNZ = 50000;
 
 
 
 ArpackSOE::ArpackSOE(double s)
 :EigenSOE(EigenSOE_TAGS_ArpackSOE),
  M(0), Msize(0), mDiagonal(false), shift(s), theModel(0), theSOE(0),
+ mPattern(0), mAssembled(false), thePool(0),
  processID(-1), numChannels(0), theChannels(0), localCol(0), sizeLocal(0)
 {
   ArpackSolver *theSolvr = new ArpackSolver();
@@ -65,6 +71,8 @@ ArpackSOE::getNumEqn(void) const
 ArpackSOE::~ArpackSOE()
 {
   if (M != 0) delete [] M;
+  if (mPattern != 0) delete mPattern;
+  if (thePool != 0) delete thePool;
 }
 
 int 
@@ -145,6 +153,28 @@ ArpackSOE::setSize(Graph &theGraph)
   }
   */
 
+  //
+  // the pattern M is assembled into; the graph of a subdomain does not
+  // hold all the equations, there M*v is formed element by element
+  //
+
+  mAssembled = false;
+  mValues.clear();
+  rowSplit.clear();
+  if (processID == -1) {
+    if (mPattern == 0)
+      mPattern = new SparsePattern();
+    if (mPattern->form(theGraph) == 0 && mPattern->getNumEqn() == size)
+      mValues.resize(mPattern->getNNZ());
+    else {
+      delete mPattern;
+      mPattern = 0;
+    }
+  } else if (mPattern != 0) {
+    delete mPattern;
+    mPattern = 0;
+  }
+
   if (size != Msize && size > 0) {
 
     if (M != 0) 
@@ -217,10 +247,35 @@ ArpackSOE::addM(const Matrix &m, const ID &id, double fact)
   if (res < 0)
     return res;
 
+  int idSize = id.Size();
+
+  if (mAssembled == true) {
+    double *values = mValues.data();
+    for (int i=0; i<idSize; i++) {
+      int locI = id(i);
+      if (locI < 0)
+	continue;
+      for (int j=0; j<idSize; j++) {
+	int locJ = id(j);
+	if (locJ < 0 || m(i,j) == 0.0)
+	  continue;
+	int loc = mPattern->getLocation(locI, locJ);
+	if (loc < 0) {
+	  // not in the graph, e.g. a mass coupling dofs without a stiffness
+	  // coupling; fall back on forming M*v element by element
+	  mAssembled = false;
+	  break;
+	}
+	values[loc] += m(i,j);
+      }
+      if (mAssembled == false)
+	break;
+    }
+  }
+
   if (mDiagonal == false)
     return  res;
 
-  int idSize = id.Size();
   for (int i=0; i<idSize; i++) {
     int locI = id(i);
     if (locI >= 0 && locI < Msize) {
@@ -255,6 +310,60 @@ ArpackSOE::zeroM(void)
 
   for (int i=0; i<Msize; i++)
     M[i] = 0;
+
+  mAssembled = (mPattern != 0);
+  for (double &value : mValues)
+    value = 0.0;
+}
+
+void
+ArpackSOE::mult(const double *x, double *y)
+{
+  const int *start = mPattern->getStart();
+  const int *index = mPattern->getIndex();
+  const double *values = mValues.data();
+  int numEqn = mPattern->getNumEqn();
+  int nnz = mPattern->getNNZ();
+
+  auto multRows = [&](int begin, int end) {
+    for (int a=begin; a<end; a++) {
+      double sum = 0.0;
+      for (int k=start[a]; k<start[a+1]; k++)
+	sum += values[k]*x[index[k]];
+      y[a] = sum;
+    }
+  };
+
+  int numThreads = (theModel != 0) ? theModel->getNumThreads() : 1;
+  if (numThreads < 2 || nnz < minThreadedNNZ) {
+    multRows(0, numEqn);
+    return;
+  }
+
+  if (thePool == 0 || thePool->getNumThreads() != numThreads) {
+    if (thePool != 0)
+      delete thePool;
+    thePool = new ThreadPool(numThreads);
+    rowSplit.clear();
+  }
+
+  // split the rows so that each thread gets about the same number of
+  // non-zeros; rows are written by one thread only
+  if ((int)rowSplit.size() != numThreads+1) {
+    rowSplit.assign(numThreads+1, numEqn);
+    rowSplit[0] = 0;
+    int a = 0;
+    for (int t=1; t<numThreads; t++) {
+      long target = (long)nnz*t/numThreads;
+      while (a < numEqn && start[a] < target)
+	a++;
+      rowSplit[t] = a;
+    }
+  }
+
+  thePool->run([&](int threadID) {
+    multRows(rowSplit[threadID], rowSplit[threadID+1]);
+  });
 }
 
 
@@ -265,6 +374,25 @@ ArpackSOE::getShift(void)
 }
 
 
+void
+ArpackSOE::setWarmStart(bool warmStart)
+{
+  EigenSolver *theSolvr = this->getSolver();
+  if (theSolvr != 0 && theSolvr->getClassTag() == EigenSOLVER_TAGS_ArpackSolver)
+    ((ArpackSolver *)theSolvr)->setWarmStart(warmStart);
+}
+
+
+int
+ArpackSOE::getNumIterations(void)
+{
+  EigenSolver *theSolvr = this->getSolver();
+  if (theSolvr != 0 && theSolvr->getClassTag() == EigenSOLVER_TAGS_ArpackSolver)
+    return ((ArpackSolver *)theSolvr)->getNumIterations();
+  return 0;
+}
+
+
 int 
 ArpackSOE::sendSelf(int commitTag, Channel &theChannel)
 {
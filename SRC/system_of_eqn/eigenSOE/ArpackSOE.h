@@ -25,7 +25,12 @@
 // Written: fmk
 // Created: 05/09
 //
-// Description: This file contains the class definition for ArpackSOE
+// Description: This file contains the class definition for ArpackSOE.
+// The mass matrix is kept as a diagonal while it is one. Otherwise it is
+// assembled, once in formM(), into the compressed row pattern of the
+// graph given to setSize() so that ArpackSolver forms M*v with a threaded
+// product instead of asking every FE_Element and DOF_Group for its mass
+// on each Lanczos iteration.
 
 
 #ifndef ArpackSOE_h
@@ -33,10 +38,13 @@
 
 #include "eigenSOE/EigenSOE.h"
 #include <Vector.h>
+#include <vector>
 
 class AnalysisModel;
 class ArpackSolver;
 class LinearSOE;
+class SparsePattern;
+class ThreadPool;
 
 class ArpackSOE : public EigenSOE
 {
@@ -58,6 +66,8 @@ class ArpackSOE : public EigenSOE
     void zeroM(void);
 
     double getShift(void);
+    void setWarmStart(bool warmStart);
+    int getNumIterations(void);
     
     int sendSelf(int commitTag, Channel &theChannel);
     int recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &theBroker);
@@ -69,6 +79,9 @@ class ArpackSOE : public EigenSOE
   protected:
     
   private:
+    // y = M*x with the assembled M, on the threads of the AnalysisModel
+    void mult(const double *x, double *y);
+
     double *M;
     int Msize;
     bool mDiagonal;
@@ -76,6 +89,12 @@ class ArpackSOE : public EigenSOE
     AnalysisModel *theModel;
     LinearSOE *theSOE;
 
+    SparsePattern *mPattern;
+    std::vector<double> mValues;  // M in the rows of mPattern
+    bool mAssembled;              // every term of M added is in mValues
+    ThreadPool *thePool;
+    std::vector<int> rowSplit;    // rows of each thread, about equal nnz
+
     int processID;
     int numChannels;
     Channel **theChannels;
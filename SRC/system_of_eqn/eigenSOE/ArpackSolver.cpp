@@ -67,7 +67,8 @@ static int sizeWork = 0;
 
 ArpackSolver::ArpackSolver()
 :EigenSolver(EigenSOLVER_TAGS_ArpackSolver),
- theSOE(0), numModesMax(0), numMode(0), size(0),
+ theSOE(0), numMode(0), size(0), warmStart(false), numIterations(0),
+ workSize(0), workNCV(0), workNEV(0),
  eigenvalues(0), eigenvectors(0), 
  v(0), workl(0), workd(0), resid(0), select(0)
 {
@@ -147,9 +148,6 @@ ArpackSolver::solve(int numModes, bool generalized, bool findSmallest)
     return -1;
   }
   
-  // set up the space for ARPACK functions.
-  // this is done each time method is called!! .. this needs to be cleaned up
-  
   int n = size;
   int nev = numModes;
   int ncv = getNCV(n, nev);
@@ -157,11 +155,12 @@ ArpackSolver::solve(int numModes, bool generalized, bool findSmallest)
   int lworkl = ncv*ncv + 8*ncv;
 
   int processID = theArpackSOE->processID;
+  numIterations = 0;
   
-  // set up the space for ARPACK functions.
-  // this is done each time method is called!! .. this needs to be cleaned up
-  if (numModes > numModesMax) {
-    
+  // set up the space for ARPACK functions; the space is kept between
+  // solves and only allocated again when the problem size changes or more
+  // Lanczos vectors or modes are wanted
+  if (n != workSize) {
     if (v != 0) delete [] v;
     if (workl != 0) delete [] workl;
     if (workd != 0) delete [] workd;
@@ -169,24 +168,60 @@ ArpackSolver::solve(int numModes, bool generalized, bool findSmallest)
     if (eigenvectors != 0) delete [] eigenvectors;
     if (resid != 0) delete [] resid;
     if (select != 0) delete [] select;
-    
-    v = new double[ldv * ncv];
-    workl = new double[lworkl + 1];
+    v = 0; workl = 0; eigenvalues = 0; eigenvectors = 0; select = 0;
+
     workd = new double[3 * n + 1];
-    eigenvalues = new double[nev];
-    eigenvectors = new double[n * nev];
     resid = new double[n];
-    select = new int[ncv];
-
-    for (int i=0; i<lworkl+1; i++)
-	   workl[i] = 0;
     for (int i=0; i<3*n+1; i++)
       workd[i] = 0;
 
+    // the eigenvectors held are not those of this problem
+    numMode = 0;
+    workSize = n;
+    workNCV = 0;
+    workNEV = 0;
+  }
+
+  // with a warm start the starting vector is the sum of the eigenvectors
+  // of the last solve, which ARPACK takes when info is not 0; otherwise
+  // ARPACK starts from a random vector
+  int info = 0;
+  if (warmStart == true && numMode > 0 && eigenvectors != 0) {
+    for (int i=0; i<n; i++)
+      resid[i] = 0.0;
+    for (int j=0; j<numMode; j++) {
+      const double *phi = &eigenvectors[j*n];
+      for (int i=0; i<n; i++)
+	resid[i] += phi[i];
+    }
+    info = 1;
+  }
+
+  if (ncv > workNCV) {
+    if (v != 0) delete [] v;
+    if (workl != 0) delete [] workl;
+    if (select != 0) delete [] select;
+
+    v = new double[ldv * ncv];
+    workl = new double[lworkl + 1];
+    select = new int[ncv];
+
+    for (int i=0; i<lworkl+1; i++)
+      workl[i] = 0;
     for (int i=0; i<ldv*ncv; i++)
       v[i] = 0;
-    
-    numModesMax = numModes;
+
+    workNCV = ncv;
+  }
+
+  if (nev > workNEV) {
+    if (eigenvalues != 0) delete [] eigenvalues;
+    if (eigenvectors != 0) delete [] eigenvectors;
+
+    eigenvalues = new double[nev];
+    eigenvectors = new double[n * nev];
+
+    workNEV = nev;
   }
 
   char which[3];
@@ -202,7 +237,6 @@ ArpackSolver::solve(int numModes, bool generalized, bool findSmallest)
   
   // some more variables
   double tol = 0.0;
-  int info = 0;
   int maxitr = 1000;
   int mode = 3;
   
@@ -349,9 +383,12 @@ ArpackSolver::solve(int numModes, bool generalized, bool findSmallest)
     if (eigenvectors != 0)
       delete [] eigenvectors;
     eigenvectors = 0;
+    workNEV = 0;
+    numMode = 0;
     
     return info;
   } else {
+    numIterations = iparam[2];
     if (info == 1) {
       opserr << "ArpackSolver::Maximum number of iteration reached." << endln;
     } else if (info == 3) {
@@ -429,7 +466,7 @@ ArpackSolver::solve(int numModes, bool generalized, bool findSmallest)
 	  ;
 	}
 	
-	
+	numMode = 0;
 	return info;
 	
       }
@@ -516,6 +553,10 @@ ArpackSolver::myMv(int n, double *v, double *result)
       return;
     }
 
+  } else if (theArpackSOE->mAssembled == true) {
+
+    theArpackSOE->mult(v, result);
+
   } else {
 
     y.Zero();
@@ -571,6 +612,20 @@ ArpackSolver::myCopy(int n, double *v, double *result)
 }
 
 
+void
+ArpackSolver::setWarmStart(bool warm)
+{
+  warmStart = warm;
+}
+
+
+int
+ArpackSolver::getNumIterations(void)
+{
+  return numIterations;
+}
+
+
 int
 ArpackSolver::setEigenSOE(ArpackSOE &theArpSOE)
 {
@@ -620,6 +675,10 @@ ArpackSolver::setSize()
 {
   size = theArpackSOE->Msize;
 
+  // the equations may have been numbered again, even with the same size,
+  // so the modes held no longer give a starting vector
+  numMode = 0;
+
   if (sizeWork < size)
     if (workArea != 0)
       delete [] workArea;
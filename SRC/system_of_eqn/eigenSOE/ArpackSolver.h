@@ -60,6 +60,14 @@ class ArpackSolver : public EigenSolver
     int solve(int numMode, bool generalized, bool findSmallest = true);
     int setSize(void);
     int setEigenSOE(ArpackSOE &theSOE);
+
+    // with warm start each solve starts from the eigenvectors of the
+    // previous solve, unless setSize() has been called in between
+    void setWarmStart(bool warmStart);
+
+    // the number of Arnoldi update iterations of the last solve,
+    // iparam[2] on return from ARPACK
+    int getNumIterations(void);
     
     const Vector &getEigenvector(int mode);
     double getEigenvalue(int mode);
@@ -73,9 +81,15 @@ class ArpackSolver : public EigenSolver
   private:
     LinearSOE *theSOE;
     ArpackSOE *theArpackSOE;
-    int numModesMax;
     int numMode;
     int size;
+    bool warmStart;
+    int numIterations;
+
+    // sizes of the workspaces, kept from one solve to the next
+    int workSize;
+    int workNCV;
+    int workNEV;
     double *eigenvalues;
     double *eigenvectors;
     Vector theVector;
@@ -0,0 +1,208 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// File: ~/system_of_eqn/linearSOE/SparsePattern.cpp
+//
+// Description: This file contains the implementation of SparsePattern.
+
+#include <SparsePattern.h>
+#include <Graph.h>
+#include <Vertex.h>
+#include <ID.h>
+#include <OPS_Globals.h>
+
+SparsePattern::SparsePattern()
+  :numEqn(0), nnz(0)
+{
+
+}
+
+SparsePattern::~SparsePattern()
+{
+
+}
+
+int
+SparsePattern::form(Graph &theGraph)
+{
+  numEqn = 0;
+  nnz = 0;
+
+  int size = theGraph.getNumVertex();
+  if (size < 0)
+    return -1;
+
+  // if the graph holds its adjacency in compressed form the rows are
+  // already in order and only the diag entry has to be merged in
+  const int *edgeStart = theGraph.getEdgeStart();
+  const int *edgeAdjacency = theGraph.getEdgeAdjacency();
+  if (edgeStart != 0) {
+    start.resize(size+1);
+    index.resize(edgeStart[size] + size);
+    int numEntries = 0;
+    for (int a=0; a<size; a++) {
+      start[a] = numEntries;
+      int k = edgeStart[a];
+      int end = edgeStart[a+1];
+      while (k < end && edgeAdjacency[k] < a)
+	index[numEntries++] = edgeAdjacency[k++];
+      index[numEntries++] = a;
+      while (k < end)
+	index[numEntries++] = edgeAdjacency[k++];
+    }
+    start[size] = numEntries;
+
+    numEqn = size;
+    nnz = numEntries;
+    return 0;
+  }
+
+  // count the entries of each equation and of each equation of the
+  // transposed pattern, the +1 is for the diag entry
+  start.assign(size+1, 0);
+  workStart.assign(size+1, 0);
+  std::vector<const ID *> adjacency(size);
+  for (int a=0; a<size; a++) {
+    Vertex *theVertex = theGraph.getVertexPtr(a);
+    if (theVertex == 0) {
+      opserr << "WARNING:SparsePattern::form :";
+      opserr << " vertex " << a << " not in graph!\n";
+      return -1;
+    }
+
+    const ID &theAdjacency = theVertex->getAdjacency();
+    int idSize = theAdjacency.Size();
+    adjacency[a] = &theAdjacency;
+    for (int i=0; i<idSize; i++) {
+      int b = theAdjacency(i);
+      if (b < 0 || b >= size) {
+	opserr << "WARNING:SparsePattern::form :";
+	opserr << " vertex " << a << " adjacent to " << b << " outside graph!\n";
+	return -1;
+      }
+      workStart[b+1]++;
+    }
+    start[a+1] = idSize + 1;
+    workStart[a+1]++;
+  }
+
+  for (int a=0; a<size; a++) {
+    start[a+1] += start[a];
+    workStart[a+1] += workStart[a];
+  }
+
+  int numEntries = start[size];
+  index.resize(numEntries);
+  work.resize(numEntries);
+
+  // first pass: bucket each vertex a into the lines of its neighbours,
+  // giving the transposed pattern in work with every line in order
+  std::vector<int> next(workStart.begin(), workStart.end()-1);
+  for (int a=0; a<size; a++) {
+    const ID &theAdjacency = *adjacency[a];
+    int idSize = theAdjacency.Size();
+    work[next[a]++] = a;
+    for (int i=0; i<idSize; i++)
+      work[next[theAdjacency(i)]++] = a;
+  }
+
+  // second pass: transpose back, leaving each line of index in order
+  next.assign(start.begin(), start.end()-1);
+  for (int b=0; b<size; b++) {
+    int end = workStart[b+1];
+    for (int k=workStart[b]; k<end; k++)
+      index[next[work[k]]++] = b;
+  }
+
+  numEqn = size;
+  nnz = numEntries;
+  return 0;
+}
+
+int
+SparsePattern::getNumEqn(void) const
+{
+  return numEqn;
+}
+
+int
+SparsePattern::getNNZ(void) const
+{
+  return nnz;
+}
+
+const int *
+SparsePattern::getStart(void) const
+{
+  return start.data();
+}
+
+const int *
+SparsePattern::getIndex(void) const
+{
+  return index.data();
+}
+
+int
+SparsePattern::getLocation(int a, int b) const
+{
+  if (a < 0 || a >= numEqn)
+    return -1;
+
+  // entries of a line are in increasing order
+  int left = start[a];
+  int right = start[a+1] - 1;
+  while (left <= right) {
+    int middle = (left + right)/2;
+    int value = index[middle];
+    if (value == b)
+      return middle;
+    else if (value < b)
+      left = middle + 1;
+    else
+      right = middle - 1;
+  }
+  return -1;
+}
+
+unsigned long long
+SparsePattern::getFingerprint(int numEqn, const int *start, const int *index)
+{
+  const unsigned long long prime = 0x9E3779B97F4A7C15ULL;
+
+  unsigned long long hash = (unsigned long long)numEqn * prime;
+  if (numEqn <= 0 || start == 0)
+    return hash;
+
+  for (int a=0; a<=numEqn; a++) {
+    hash = (hash ^ (unsigned int)start[a]) * prime;
+    hash ^= hash >> 29;
+  }
+
+  int numEntries = start[numEqn];
+  if (index != 0) {
+    for (int k=0; k<numEntries; k++) {
+      hash = (hash ^ (unsigned int)index[k]) * prime;
+      hash ^= hash >> 29;
+    }
+  }
+
+  return hash;
+}
@@ -0,0 +1,75 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef SparsePattern_h
+#define SparsePattern_h
+
+// File: ~/system_of_eqn/linearSOE/SparsePattern.h
+//
+// Description: This file contains the class definition for SparsePattern.
+// A SparsePattern holds the compressed (start, index) structure of the
+// matrix whose graph is given, i.e. for each equation a the diagonal and
+// the adjacency of vertex a, in increasing order. The graph of the
+// equations is symmetric, so the same structure serves as the column
+// pattern of a compressed column matrix (SparseGenColLinSOE, SuperLU,
+// UmfpackGenLinSOE) and the row pattern of a compressed row matrix
+// (SparseGenRowLinSOE). The pattern is formed with two bucket passes, so
+// the time is linear in the number of non-zeros whatever the order of the
+// vertex adjacencies.
+
+#include <vector>
+
+class Graph;
+
+class SparsePattern
+{
+  public:
+    SparsePattern();
+    ~SparsePattern();
+
+    int form(Graph &theGraph);
+
+    int getNumEqn(void) const;
+    int getNNZ(void) const;
+
+    // start[a] to start[a+1]-1 are the locations in index of the entries
+    // of equation a
+    const int *getStart(void) const;
+    const int *getIndex(void) const;
+
+    // location of entry b of equation a, or -1 if it is not in the pattern
+    int getLocation(int a, int b) const;
+
+    // a 64 bit hash of a compressed (start, index) structure with numEqn
+    // lines, used by the solvers to tell whether the pattern they are
+    // given in setSize() is the one they analysed last time
+    static unsigned long long getFingerprint(int numEqn, const int *start,
+					     const int *index);
+
+  private:
+    int numEqn;
+    int nnz;
+    std::vector<int> start;
+    std::vector<int> index;
+    std::vector<int> work;        // the transposed pattern while forming
+    std::vector<int> workStart;
+};
+
+#endif
@@ -29,82 +29,112 @@
 // Created: Mar, 1998
 // Revision: A
 //
-// Description: This file contains the class definition for 
-// BandSPDLinThreadSolver. It solves the BandSPDLinSOE object by calling
-// Thread routines.
+// Description: This file contains the implementation of 
+// BandSPDLinThreadSolver. The factorization is that of LAPACK dpbtrf for
+// UPLO = 'U': for each block of blockSize columns the diagonal block is
+// factored with dpotrf, the rows of the block are solved for with dtrsm
+// and the rest of the band is updated with dsyrk and dgemm. The columns
+// of the dtrsm and of the update are split over the threads, which wait
+// for each other twice per block.
 //
 // What: "@(#) BandSPDLinThreadSolver.h, revA"
 
+
 #include <BandSPDLinThreadSolver.h>
 #include <BandSPDLinSOE.h>
-#include <f2c.h>
+#include <ThreadPool.h>
 #include <math.h>
-#include <thread.h>
-
-// global data that will be needed by the threads
-struct thread_control_block {
-  mutex_t start_mutex;
-  mutex_t end_mutex;
-  mutex_t startBlock_mutex;
-  mutex_t endBlock_mutex;
-
-  cond_t start_cond;
-  cond_t end_cond;
-  cond_t startBlock_cond;
-  cond_t endBlock_cond;
-
-  double *A,*X,*B;
-  int n, kd;
-  int blockSize, currentBlock;
-  int workToDo;
-  int info;
-  int threadID;
-  int numThreads;
-  int threadsDone;
-  int threadsDoneBlock;
-} TCB_BandSPDLinThreadSolver;
 
+#ifdef _WIN32
+extern "C" int  DPBTRF(const char *UPLO, int *N, int *KD, double *A, int *LDA,
+			       int *INFO);
 
-BandSPDLinThreadSolver::BandSPDLinThreadSolver()
-:BandSPDLinSolver(SOLVER_TAGS_BandSPDLinThreadSolver), NP(1), 
- running(false), blockSize(1)
-{
-  
-}
+extern "C" int  DPBTRS(const char *UPLO, int *N, int *KD, int *NRHS, 
+			       double *A, int *LDA, double *B, int *LDB, 
+			       int *INFO);
 
-BandSPDLinThreadSolver::BandSPDLinThreadSolver(int numProcessors, int blckSize)
-:BandSPDLinSolver(SOLVER_TAGS_BandSPDLinThreadSolver), NP(numProcessors),
- running(false), blockSize(blckSize)
-{
+extern "C" int  DPOTRF(const char *UPLO, int *N, double *A, int *LDA,
+			       int *INFO);
 
-}
+extern "C" int  DTRSM(const char *SIDE, const char *UPLO,
+			      const char *TRANSA, const char *DIAG,
+			      int *M, int *N, double *ALPHA, double *A, int *LDA,
+			      double *B, int *LDB);
 
-BandSPDLinThreadSolver::~BandSPDLinThreadSolver()
-{
-    
-}
+extern "C" int  DSYRK(const char *UPLO, const char *TRANS, int *N, int *K,
+			      double *ALPHA, double *A, int *LDA,
+			      double *BETA, double *C, int *LDC);
 
+extern "C" int  DGEMM(const char *TRANSA, const char *TRANSB,
+			      int *M, int *N, int *K,
+			      double *ALPHA, double *A, int *LDA, double *B, int *LDB,
+			      double *BETA, double *C, int *LDC);
 
-extern "C" int dpbsv_(char *UPLO, int *N, int *KD, int *NRHS, 
-		      double *A, int *LDA, double *B, int *LDB, 
-		      int *INFO);
+#define dpbtrf_ DPBTRF
+#define dpbtrs_ DPBTRS
+#define dpotrf_ DPOTRF
+#define dtrsm_  DTRSM
+#define dsyrk_  DSYRK
+#define dgemm_  DGEMM
+#else
 
-extern "C" int dpbtrf_(char *UPLO, int *N, int *KD, double *A, 
-		       int *LDA, int *INFO);
+extern "C" int dpbtrf_(const char *UPLO, int *N, int *KD, double *A, int *LDA,
+		       int *INFO);
 
-extern "C" int dpbtrs_(char *UPLO, int *N, int *KD, int *NRHS, 
+extern "C" int dpbtrs_(const char *UPLO, int *N, int *KD, int *NRHS, 
 		       double *A, int *LDA, double *B, int *LDB, 
 		       int *INFO);
-		       
 
-void *BandSPDLinThreadSolver_Worker(void *arg);
+extern "C" int dpotrf_(const char *UPLO, int *N, double *A, int *LDA,
+		       int *INFO);
+
+extern "C" int dtrsm_(const char *SIDE, const char *UPLO,
+		      const char *TRANSA, const char *DIAG,
+		      int *M, int *N, double *ALPHA, double *A, int *LDA,
+		      double *B, int *LDB);
+
+extern "C" int dsyrk_(const char *UPLO, const char *TRANS, int *N, int *K,
+		      double *ALPHA, double *A, int *LDA,
+		      double *BETA, double *C, int *LDC);
+
+extern "C" int dgemm_(const char *TRANSA, const char *TRANSB,
+		      int *M, int *N, int *K,
+		      double *ALPHA, double *A, int *LDA, double *B, int *LDB,
+		      double *BETA, double *C, int *LDC);
+
+#endif
+
+BandSPDLinThreadSolver::BandSPDLinThreadSolver()
+:BandSPDLinSolver(SOLVER_TAGS_BandSPDLinThreadSolver), NP(2), 
+ thePool(0), blockSize(64), work(0)
+{
+    thePool = new ThreadPool(NP);
+}
+
+BandSPDLinThreadSolver::BandSPDLinThreadSolver(int numThreads, int blckSize)
+:BandSPDLinSolver(SOLVER_TAGS_BandSPDLinThreadSolver), NP(numThreads),
+ thePool(0), blockSize(blckSize), work(0)
+{
+    if (NP < 1)
+	NP = 1;
+    if (blockSize < 1)
+	blockSize = 1;
+    if (NP > 1)
+	thePool = new ThreadPool(NP);
+}
+
+BandSPDLinThreadSolver::~BandSPDLinThreadSolver()
+{
+    if (work != 0) delete [] work;
+    if (thePool != 0) delete thePool;
+}
 
 
 int
 BandSPDLinThreadSolver::solve(void)
 {
     if (theSOE == 0) {
-	opserr << "BandSPDLinThreadSolver::solve(void)- ";
+	opserr << "WARNING BandSPDLinThreadSolver::solve(void)- ";
 	opserr << " No LinearSOE object has been set\n";
 	return -1;
     }
@@ -119,6 +149,9 @@ BandSPDLinThreadSolver::solve(void)
     double *Xptr = theSOE->X;
     double *Bptr = theSOE->B;
 
+    if (n == 0)
+	return 0;
+
     // first copy B into X
     for (int i=0; i<n; i++)
 	*(Xptr++) = *(Bptr++);
@@ -126,197 +159,186 @@ BandSPDLinThreadSolver::solve(void)
 
     // now solve AX = Y
     if (theSOE->factored == false) {
-
-      // start threads running
-      if (running == false) {
-	mutex_init(&TCB_BandSPDLinThreadSolver.start_mutex, USYNC_THREAD, 0);
-	mutex_init(&TCB_BandSPDLinThreadSolver.end_mutex, USYNC_THREAD, 0);
-	mutex_init(&TCB_BandSPDLinThreadSolver.startBlock_mutex, USYNC_THREAD, 0);
-	mutex_init(&TCB_BandSPDLinThreadSolver.endBlock_mutex, USYNC_THREAD, 0);
-	cond_init(&TCB_BandSPDLinThreadSolver.start_cond, USYNC_THREAD, 0);
-	cond_init(&TCB_BandSPDLinThreadSolver.end_cond, USYNC_THREAD, 0);
-	cond_init(&TCB_BandSPDLinThreadSolver.startBlock_cond, USYNC_THREAD, 0);
-	cond_init(&TCB_BandSPDLinThreadSolver.endBlock_cond, USYNC_THREAD, 0);
-	TCB_BandSPDLinThreadSolver.workToDo = 0;
-        
-	// Create the threads - Bound daemon threads
-	for (int j = 0; j < NP; j++) 
-	  thr_create(NULL,0, BandSPDLinThreadSolver_Worker, NULL, 
-		     THR_BOUND|THR_DAEMON, NULL);
-
-        running = true;
-      }
-      
-  
-      mutex_lock(&TCB_BandSPDLinThreadSolver.start_mutex); 
-        // assign the global variables the threads will need
-        TCB_BandSPDLinThreadSolver.A = Aptr;
-	TCB_BandSPDLinThreadSolver.X = Xptr;
-	TCB_BandSPDLinThreadSolver.B = Bptr;
-	TCB_BandSPDLinThreadSolver.n = n;
-	TCB_BandSPDLinThreadSolver.kd = kd;
-	TCB_BandSPDLinThreadSolver.info = 0;
-        TCB_BandSPDLinThreadSolver.workToDo = NP;
-        TCB_BandSPDLinThreadSolver.blockSize = blockSize;
-        TCB_BandSPDLinThreadSolver.currentBlock = -1;
-	TCB_BandSPDLinThreadSolver.threadID = 0;
-	TCB_BandSPDLinThreadSolver.numThreads = NP;
-        TCB_BandSPDLinThreadSolver.threadsDone = 0;
-        TCB_BandSPDLinThreadSolver.threadsDoneBlock = NP;
-
-        // wake up the threads
-        cond_broadcast(&TCB_BandSPDLinThreadSolver.start_cond);
-      mutex_unlock(&TCB_BandSPDLinThreadSolver.start_mutex); 
-
-      // yield the LWP
-      thr_yield();
- 
-      // wait for all the threads to finish
-      mutex_lock(&TCB_BandSPDLinThreadSolver.end_mutex);
-
-         while (TCB_BandSPDLinThreadSolver.threadsDone < NP) 
-           cond_wait(&TCB_BandSPDLinThreadSolver.end_cond, &TCB_BandSPDLinThreadSolver.end_mutex);
-
-      mutex_unlock(&TCB_BandSPDLinThreadSolver.end_mutex);
+	info = this->factor(n, kd, Aptr);
+	if (info != 0) {
+	    opserr << "WARNING BandSPDLinThreadSolver::solve() -";
+	    opserr << "factorization failed, matrix singular U(i,i) = 0, i= " << info-1 << endln;
+	    return -info+1;
+	}
+	theSOE->factored = true;
     }
 
-    // solve using factored matrix
     dpbtrs_("U",&n,&kd,&nrhs,Aptr,&ldA,Xptr,&ldB,&info);
-    
-
-    // check if successful
-    if (info != 0)
+    if (info != 0) {
+	opserr << "WARNING BandSPDLinThreadSolver::solve() - OpenSees code error\n";
 	return info;
+    }
 
-    theSOE->factored = true;
     return 0;
 }
-    
 
 
+// int factor(int n, int kd, double *A);
+//	Method to factor the band A, stored as for dpbtrf with UPLO = 'U',
+//	into U'U. With ld = kd the band is viewed as a full matrix, so the
+//	blocks inside the band are passed to the BLAS as they lie; the
+//	triangle of each block row that falls outside the band, below its
+//	last columns, is copied to work. Returns dpbtrf's info.
+
 int
-BandSPDLinThreadSolver::setSize()
+BandSPDLinThreadSolver::factor(int n, int kd, double *A)
 {
-    // nothing to do    
+    int ldA = kd + 1;
+    int info = 0;
+
+    // dpbtrf factors a narrow band unblocked
+    if (kd <= blockSize || work == 0) {
+	dpbtrf_("U", &n, &kd, A, &ldA, &info);
+	return info;
+    }
+
+    int nb = blockSize;
+    int ld = kd;
+    double one = 1.0;
+    double minusOne = -1.0;
+
+    for (int i=0; i<n; i+=nb) {
+	int ib = (nb < n-i) ? nb : n-i;
+
+	// factor the diagonal block
+	double *U11 = A + kd + i*ldA;
+	dpotrf_("U", &ib, U11, &ld, &info);
+	if (info != 0)
+	    return i + info;
+
+	if (i+ib >= n)
+	    break;
+
+	// i2 columns of the block row lie in the band, i3 more reach past it
+	int i2 = (kd-ib < n-i-ib) ? kd-ib : n-i-ib;
+	int i3 = (ib < n-i-kd) ? ib : n-i-kd;
+	if (i3 < 0)
+	    i3 = 0;
+	int m = i2 + i3;
+
+	double *A12 = A + kd - ib + (i+ib)*ldA;   // ib x i2 in the band
+	double *T = A + kd + (i+ib)*ldA;          // m x m trailing triangle
+
+	// copy the triangle of A13 that is inside the band
+	for (int jj=0; jj<i3; jj++) {
+	    double *col = A + (i+kd+jj)*ldA - jj;
+	    for (int ii=jj; ii<ib; ii++)
+		work[ii + jj*nb] = col[ii];
+	}
+
+	// solve U11' X = [A12 A13] for the columns [c0,c1)
+	auto solveRows = [&](int c0, int c1) {
+	    int c2 = (c1 < i2) ? c1 : i2;
+	    if (c0 < c2) {
+		int nc = c2 - c0;
+		dtrsm_("L", "U", "T", "N", &ib, &nc, &one, U11, &ld,
+		       A12 + c0*ld, &ld);
+	    }
+	    int w0 = (c0 > i2) ? c0-i2 : 0;
+	    int w1 = c1 - i2;
+	    if (w0 < w1) {
+		int nc = w1 - w0;
+		dtrsm_("L", "U", "T", "N", &ib, &nc, &one, U11, &ld,
+		       work + w0*nb, &nb);
+	    }
+	};
+
+	// subtract [A12 A13]'[A12 A13] from the columns [c0,c1) of the upper
+	// triangle of [A22 A23; 0 A33]
+	auto update = [&](int c0, int c1) {
+	    int c2 = (c1 < i2) ? c1 : i2;
+	    if (c0 < c2) {
+		int nc = c2 - c0;
+		if (c0 > 0)
+		    dgemm_("T", "N", &c0, &nc, &ib, &minusOne, A12, &ld,
+			   A12 + c0*ld, &ld, &one, T + c0*ld, &ld);
+		dsyrk_("U", "T", &nc, &ib, &minusOne, A12 + c0*ld, &ld,
+		       &one, T + c0 + c0*ld, &ld);
+	    }
+	    int w0 = (c0 > i2) ? c0-i2 : 0;
+	    int w1 = c1 - i2;
+	    if (w0 < w1) {
+		int nc = w1 - w0;
+		double *W = work + w0*nb;
+		double *Tw = T + (i2+w0)*ld;
+		if (i2 > 0)
+		    dgemm_("T", "N", &i2, &nc, &ib, &minusOne, A12, &ld,
+			   W, &nb, &one, Tw, &ld);
+		if (w0 > 0)
+		    dgemm_("T", "N", &w0, &nc, &ib, &minusOne, work, &nb,
+			   W, &nb, &one, Tw + i2, &ld);
+		dsyrk_("U", "T", &nc, &ib, &minusOne, W, &nb,
+		       &one, Tw + i2 + w0, &ld);
+	    }
+	};
+
+	if (thePool == 0) {
+	    solveRows(0, m);
+	    update(0, m);
+	} else {
+	    thePool->parallelFor(m, [&](int c0, int c1, int) {
+		solveRows(c0, c1);
+	    });
+
+	    // column c of the triangle holds c+1 entries, so the threads
+	    // are given columns of equal area
+	    int numThreads = thePool->getNumThreads();
+	    thePool->run([&](int id) {
+		int c0 = (int)(m*sqrt((double)id/numThreads) + 0.5);
+		int c1 = (int)(m*sqrt((double)(id+1)/numThreads) + 0.5);
+		if (c0 < c1)
+		    update(c0, c1);
+	    });
+	}
+
+	// and copy the solved triangle of A13 back
+	for (int jj=0; jj<i3; jj++) {
+	    double *col = A + (i+kd+jj)*ldA - jj;
+	    for (int ii=jj; ii<ib; ii++)
+		col[ii] = work[ii + jj*nb];
+	}
+    }
+
     return 0;
 }
 
 
 int
-BandSPDLinThreadSolver::sendSelf(Channel &theChannel, 
-				 FEM_ObjectBroker &theBroker)
+BandSPDLinThreadSolver::setSize()
 {
-    // nothing to do
+    if (theSOE == 0) {
+	opserr << "BandSPDLinThreadSolver::setSize()";
+	opserr << " No system has been set\n";
+	return -1;
+    }
+
+    // the part of A13 above its diagonal is outside the band and stays 0
+    if (work == 0) {
+	int size = blockSize*blockSize;
+	work = new double[size];
+	for (int i=0; i<size; i++)
+	    work[i] = 0.0;
+    }
+
     return 0;
 }
 
 int
-BandSPDLinThreadSolver::recvSelf(Channel &theChannel, 
-				 FEM_ObjectBroker &theBroker)
+BandSPDLinThreadSolver::sendSelf(int commitTag, Channel &theChannel)
 {
     // nothing to do
     return 0;
 }
 
-
-
-
-// Thread routine called from thr_create() as a Bound Daemon Thread
-void *BandSPDLinThreadSolver_Worker(void *arg)
+int
+BandSPDLinThreadSolver::recvSelf(int commitTag, Channel &theChannel, 
+				 FEM_ObjectBroker &theBroker)
 {
-  // Do this loop forever - or until all the Non-Daemon threads have exited
-  while(true)
-    {
-
-      // Wait for some work to do
-      mutex_lock(&TCB_BandSPDLinThreadSolver.start_mutex);
-
-        while (TCB_BandSPDLinThreadSolver.workToDo == 0)
-          cond_wait(&TCB_BandSPDLinThreadSolver.start_cond, &TCB_BandSPDLinThreadSolver.start_mutex);
-
-        TCB_BandSPDLinThreadSolver.workToDo--;
-
-        // get an id;
-	int myID = TCB_BandSPDLinThreadSolver.threadID++;
-
-      mutex_unlock(&TCB_BandSPDLinThreadSolver.start_mutex);
-
-      // do some initialisation for the factorization
-      int currentBlock =0;
-      int n = TCB_BandSPDLinThreadSolver.n;
-      int kd = TCB_BandSPDLinThreadSolver.kd;
-      int blckSize = TCB_BandSPDLinThreadSolver.blockSize;
-      double *Aptr = TCB_BandSPDLinThreadSolver.A;
-      double *Bptr = TCB_BandSPDLinThreadSolver.B;
-      double *Xptr = TCB_BandSPDLinThreadSolver.X;
-      int numThreads = TCB_BandSPDLinThreadSolver.numThreads;
-    
-      int nBlocks = n/blckSize;
-
-      for (int i=0; i<nBlocks; i++) {
-        int currentDiagThread = i%numThreads;
-        if (myID == currentDiagThread) {
-
-	  // wait till last block row is done
-          mutex_lock(&TCB_BandSPDLinThreadSolver.endBlock_mutex);
-            while(TCB_BandSPDLinThreadSolver.threadsDoneBlock < numThreads)
-	      cond_wait(&TCB_BandSPDLinThreadSolver.endBlock_cond, &TCB_BandSPDLinThreadSolver.endBlock_mutex);
-
-	    TCB_BandSPDLinThreadSolver.threadsDoneBlock = 0;
-          mutex_unlock(&TCB_BandSPDLinThreadSolver.endBlock_mutex);        
-
-          // FACTOR DIAG BLOCK
-       
-          // allow other threads to now proceed
-          mutex_lock(&TCB_BandSPDLinThreadSolver.startBlock_mutex);
-	    TCB_BandSPDLinThreadSolver.currentBlock = i;
-
-            cond_broadcast(&TCB_BandSPDLinThreadSolver.startBlock_cond);
-          mutex_unlock(&TCB_BandSPDLinThreadSolver.startBlock_mutex);        
-
-          
-          // FACTOR REST OF BLOCK ROW BELONGING TO THREAD
-
-          // mark that the thread has finished with row
-          mutex_lock(&TCB_BandSPDLinThreadSolver.endBlock_mutex);
-	    TCB_BandSPDLinThreadSolver.threadsDoneBlock++;
-
-            cond_signal(&TCB_BandSPDLinThreadSolver.endBlock_cond);
-          mutex_unlock(&TCB_BandSPDLinThreadSolver.endBlock_mutex);                   
-	}
-        else {
-
-          // wait till diag i is done 
-          mutex_lock(&TCB_BandSPDLinThreadSolver.startBlock_mutex);
-             while (TCB_BandSPDLinThreadSolver.currentBlock < i)
-                cond_wait(&TCB_BandSPDLinThreadSolver.startBlock_cond, 
-			  &TCB_BandSPDLinThreadSolver.startBlock_mutex); 
-          mutex_unlock(&TCB_BandSPDLinThreadSolver.startBlock_mutex);
-
-          // FACTOR REST OF BLOCK ROW BELONGING TO THREAD
-
-          // mark that the thread has finished with row
-          mutex_lock(&TCB_BandSPDLinThreadSolver.endBlock_mutex);
-	    TCB_BandSPDLinThreadSolver.threadsDoneBlock++;
-
-            cond_signal(&TCB_BandSPDLinThreadSolver.endBlock_cond);
-          mutex_unlock(&TCB_BandSPDLinThreadSolver.endBlock_mutex);                             
-	}
-      }
-
-      // signal the main thread that this thread is done with the work
-      mutex_lock(&TCB_BandSPDLinThreadSolver.end_mutex);
-         TCB_BandSPDLinThreadSolver.threadsDone++;
-
-         cond_signal(&TCB_BandSPDLinThreadSolver.end_cond);
-      mutex_unlock(&TCB_BandSPDLinThreadSolver.end_mutex);
-    } 
-  return NULL;
+    // nothing to do
+    return 0;
 }
-
-
-
-
-
-
-
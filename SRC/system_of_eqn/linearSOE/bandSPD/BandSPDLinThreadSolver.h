@@ -30,8 +30,10 @@
 // Revision: A
 //
 // Description: This file contains the class definition for 
-// BandSPDLinThreadSolver. It solves the BandSPDLinSOE in parallel
-// using solaris threads.
+// BandSPDLinThreadSolver. It solves the BandSPDLinSOE with the blocked
+// band Cholesky factorization of LAPACK dpbtrf, the update of the band
+// following each block of blockSize columns being split over numThreads
+// threads, and LAPACK dpbtrs for the forward and back substitution.
 //
 // What: "@(#) BandSPDLinThreadSolver.h, revA"
 
@@ -39,28 +41,31 @@
 #define BandSPDLinThreadSolver_h
 
 #include <BandSPDLinSolver.h>
+class ThreadPool;
 
 class BandSPDLinThreadSolver : public BandSPDLinSolver
 {
   public:
     BandSPDLinThreadSolver();    
-    BandSPDLinThreadSolver(int numProcessors, int blockSize);        
+    BandSPDLinThreadSolver(int numThreads, int blockSize);
     ~BandSPDLinThreadSolver();
 
     int solve(void);
     int setSize(void);
     
-    int sendSelf(Channel &theChannel, FEM_ObjectBroker &theBroker);
-    int recvSelf(Channel &theChannel, FEM_ObjectBroker &theBroker);    
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel, 
+		 FEM_ObjectBroker &theBroker);
     
   protected:
 
   private:
+    int factor(int n, int kd, double *A);
+
     int NP;
-    int running;
+    ThreadPool *thePool;
     int blockSize;
+    double *work;     // blockSize*blockSize, the triangle below the band
 };
 
 #endif
-
-
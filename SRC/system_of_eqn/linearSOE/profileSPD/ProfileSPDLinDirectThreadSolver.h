@@ -32,7 +32,10 @@
 // Description: This file contains the class definition for 
 // ProfileSPDLinDirectThreadSolver. ProfileSPDLinDirectThreadSolver is a subclass 
 // of LinearSOESOlver. It solves a ProfileSPDLinSOE object using
-// the LDL^t factorization.
+// the LDL^t factorization, with the columns of each block of blockSize
+// columns reduced by the rows above the block on numThreads threads. The
+// factorization works on any matrix held column by column in skyline
+// form, and is also used by BandSPDLinThreadSolver.
 
 // What: "@(#) ProfileSPDLinDirectThreadSolver.h, revA"
 
@@ -41,16 +44,18 @@
 
 #include <ProfileSPDLinSolver.h>
 class ProfileSPDLinSOE;
+class ThreadPool;
 
 class ProfileSPDLinDirectThreadSolver : public ProfileSPDLinSolver
 {
   public:
     ProfileSPDLinDirectThreadSolver();      
-    ProfileSPDLinDirectThreadSolver(int numProcessors, int blockSize, double tol);    
+    ProfileSPDLinDirectThreadSolver(int numThreads, int blockSize, double tol);    
     virtual ~ProfileSPDLinDirectThreadSolver();
 
     virtual int solve(void);        
     virtual int setSize(void);    
+    double getDeterminant(void);
 
     virtual int setProfileSOE(ProfileSPDLinSOE &theSOE);
 
@@ -58,13 +63,23 @@ class ProfileSPDLinDirectThreadSolver : public ProfileSPDLinSolver
     int recvSelf(int commitTag, Channel &theChannel, 
 		 FEM_ObjectBroker &theBroker);
 
+    // factor the skyline matrix, whose column i holds rows rowTop[i] to i
+    // starting at topRowPtr[i], into U^t D U in place storing D^-1 in invD;
+    // thePool may be 0 to factor on the calling thread only
+    static int factorLDL(int size, const int *rowTop, double **topRowPtr,
+			 double *invD, double minDiagTol, int blockSize, 
+			 ThreadPool *thePool);
+
+    // overwrite X with the solution of U^t D U X = X
+    static void solveLDL(int size, const int *rowTop, double **topRowPtr,
+			 const double *invD, double *X);
+
   protected:
     int NP;
-    int running;
+    ThreadPool *thePool;
     
     double minDiagTol;
     int blockSize;
-    int maxColHeight;
     int size;
     int *RowTop;
     double **topRowPtr, *invD;
@@ -75,4 +90,3 @@ class ProfileSPDLinDirectThreadSolver : public ProfileSPDLinSolver
 
 
 #endif
-
@@ -0,0 +1,219 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// File: ~/system_of_eqn/linearSOE/profileSPD/benchmark.cpp
+//
+// Description: benchmark for the threaded skyline and band solvers. A
+// banded skyline matrix of random column heights is solved first with the
+// serial ProfileSPDLinDirectSolver, then factored with the blocked LDL^t
+// factorization of ProfileSPDLinDirectThreadSolver on 1, 2, 4, .. up to
+// the number of threads asked for. The same matrix held in a band is then
+// solved with the serial BandSPDLinLapackSolver and with
+// BandSPDLinThreadSolver on 1, 2, 4, .. threads. The speedups are over the
+// serial solvers; the time, speedup and the residual of the solution are
+// printed for each. Built with "make benchmark", run as
+// "profile_benchmark numEqn maxHeight maxThreads blockSize".
+
+#include <ProfileSPDLinDirectThreadSolver.h>
+#include <ProfileSPDLinDirectSolver.h>
+#include <ProfileSPDLinSOE.h>
+#include <BandSPDLinLapackSolver.h>
+#include <BandSPDLinThreadSolver.h>
+#include <BandSPDLinSOE.h>
+#include <ThreadPool.h>
+#include <Vector.h>
+#include <OPS_Globals.h>
+#include <StandardStream.h>
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <vector>
+
+StandardStream sserr;
+OPS_Stream *opserrPtr = &sserr;
+
+// a skyline: column j holds rows rowTop[j] to j, diagonal last, starting
+// at values[start[j]]
+struct Skyline {
+  std::vector<int> rowTop;
+  std::vector<int> start;
+  std::vector<double> values;
+};
+
+// largest entry of A x - b, A is stored as its upper triangle
+static double
+residual(const Skyline &A, const std::vector<double> &x,
+	 const std::vector<double> &b)
+{
+  int numEqn = b.size();
+  std::vector<double> y(numEqn, 0.0);
+  for (int j=0; j<numEqn; j++) {
+    const double *colj = &A.values[A.start[j]] - A.rowTop[j];
+    for (int i=A.rowTop[j]; i<j; i++) {
+      y[i] += colj[i]*x[j];
+      y[j] += colj[i]*x[i];
+    }
+    y[j] += colj[j]*x[j];
+  }
+  double res = 0.0;
+  for (int i=0; i<numEqn; i++)
+    res = fmax(res, fabs(y[i] - b[i]));
+  return res;
+}
+
+// add the columns of A to theSOE, one column at a time
+template <class SOE>
+static void
+fillSOE(SOE &theSOE, const Skyline &A, const std::vector<double> &b)
+{
+  int numEqn = b.size();
+  Vector col(numEqn);
+  for (int j=0; j<numEqn; j++) {
+    const double *colj = &A.values[A.start[j]] - A.rowTop[j];
+    for (int i=A.rowTop[j]; i<=j; i++)
+      col(i) = colj[i];
+    theSOE.addColA(col, j);
+    for (int i=A.rowTop[j]; i<=j; i++)
+      col(i) = 0.0;
+  }
+  Vector theB(numEqn);
+  for (int i=0; i<numEqn; i++)
+    theB(i) = b[i];
+  theSOE.setB(theB);
+}
+
+// time the solve of theSOE, the factorization included, returning the
+// time in milliseconds; the speedup is over baseTime if it is not 0
+template <class SOE>
+static double
+timeSolve(const char *name, SOE &theSOE, const Skyline &A,
+	  const std::vector<double> &b, double baseTime)
+{
+  fillSOE(theSOE, A, b);
+
+  std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+  int result = theSOE.solve();
+  std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+
+  if (result < 0) {
+    printf("%s failed\n", name);
+    return 0.0;
+  }
+
+  const Vector &theX = theSOE.getX();
+  std::vector<double> x(b.size());
+  for (int i=0; i<int(b.size()); i++)
+    x[i] = theX(i);
+
+  double time = std::chrono::duration<double, std::milli>(t1 - t0).count();
+  printf("%-28s %14.3f %10.2f %12.3e\n", name, time,
+	 (baseTime != 0.0) ? baseTime/time : 1.0, residual(A, x, b));
+  return time;
+}
+
+int main(int argc, char **argv)
+{
+  int numEqn = 20000;
+  int maxHeight = 400;
+  int maxThreads = ThreadPool::getNumProcessors();
+  int blockSize = 64;
+
+  if (argc > 1) numEqn = atoi(argv[1]);
+  if (argc > 2) maxHeight = atoi(argv[2]);
+  if (argc > 3) maxThreads = atoi(argv[3]);
+  if (argc > 4) blockSize = atoi(argv[4]);
+
+  // the skyline, diagonally dominant so it is positive definite
+  Skyline sky;
+  sky.rowTop.resize(numEqn);
+  sky.start.resize(numEqn+1, 0);
+  srand(1);
+  for (int j=0; j<numEqn; j++) {
+    int height = 1 + rand() % maxHeight;
+    sky.rowTop[j] = (j-height+1 < 0) ? 0 : j-height+1;
+    sky.start[j+1] = sky.start[j] + j - sky.rowTop[j] + 1;
+  }
+  sky.values.resize(sky.start[numEqn]);
+  for (int j=0; j<numEqn; j++) {
+    for (int i=sky.rowTop[j]; i<j; i++)
+      sky.values[sky.start[j]+i-sky.rowTop[j]] = (rand() % 1000)/1000.0 - 0.5;
+    sky.values[sky.start[j+1]-1] = maxHeight + 1.0;
+  }
+
+  // the same matrix in a band of maxHeight-1 superdiagonals, each band
+  // column seen as a full height skyline column
+  Skyline band;
+  band.rowTop.resize(numEqn);
+  band.start.resize(numEqn+1, 0);
+  for (int j=0; j<numEqn; j++) {
+    band.rowTop[j] = (j-maxHeight+1 < 0) ? 0 : j-maxHeight+1;
+    band.start[j+1] = band.start[j] + j - band.rowTop[j] + 1;
+  }
+  band.values.resize(band.start[numEqn], 0.0);
+  for (int j=0; j<numEqn; j++)
+    for (int i=sky.rowTop[j]; i<=j; i++)
+      band.values[band.start[j]+i-band.rowTop[j]] =
+	sky.values[sky.start[j]+i-sky.rowTop[j]];
+
+  std::vector<double> b(numEqn);
+  for (int i=0; i<numEqn; i++)
+    b[i] = sin(1.0*i);
+
+  printf("%d equations, %d skyline entries, block size %d\n", numEqn,
+	 sky.start[numEqn], blockSize);
+  printf("%-28s %14s %10s %12s\n", "skyline", "time(ms)", "speedup", "residual");
+
+  std::vector<int> iDiagLoc(numEqn);
+  for (int j=0; j<numEqn; j++)
+    iDiagLoc[j] = sky.start[j+1];     // FORTRAN array indexing
+  // the SOE deletes its solver
+  ProfileSPDLinDirectSolver *theProfileSolver = new ProfileSPDLinDirectSolver();
+  ProfileSPDLinSOE theProfileSOE(numEqn, &iDiagLoc[0], *theProfileSolver);
+  double profileTime = timeSolve("ProfileSPDLinDirectSolver", theProfileSOE,
+				 sky, b, 0.0);
+  for (int numThreads=1; numThreads<=maxThreads; numThreads*=2) {
+    ProfileSPDLinDirectThreadSolver *theSolver =
+      new ProfileSPDLinDirectThreadSolver(numThreads, blockSize, 1.0e-12);
+    ProfileSPDLinSOE theSOE(numEqn, &iDiagLoc[0], *theSolver);
+    char name[40];
+    snprintf(name, 40, "ProfileSPDThread, %d threads", numThreads);
+    timeSolve(name, theSOE, sky, b, profileTime);
+  }
+
+  printf("\n%-28s %14s %10s %12s\n", "band", "time(ms)", "speedup", "residual");
+
+  BandSPDLinLapackSolver *theBandSolver = new BandSPDLinLapackSolver();
+  BandSPDLinSOE theBandSOE(numEqn, maxHeight-1, *theBandSolver);
+  double bandTime = timeSolve("BandSPDLinLapackSolver", theBandSOE, band, b,
+			      0.0);
+
+  for (int numThreads=1; numThreads<=maxThreads; numThreads*=2) {
+    BandSPDLinThreadSolver *theSolver =
+      new BandSPDLinThreadSolver(numThreads, blockSize);
+    BandSPDLinSOE theSOE(numEqn, maxHeight-1, *theSolver);
+    char name[40];
+    snprintf(name, 40, "BandSPDLinThread, %d threads", numThreads);
+    timeSolve(name, theSOE, band, b, bandTime);
+  }
+
+  return 0;
+}
@@ -36,6 +36,7 @@
 #include <SparseGenColLinSolver.h>
 #include <Matrix.h>
 #include <Graph.h>
+#include <SparsePattern.h>
 #include <Vertex.h>
 #include <VertexIter.h>
 #include <math.h>
@@ -168,14 +169,15 @@ SparseGenColLinSOE::setSize(Graph &theGraph)
     int oldSize = size;
     size = theGraph.getNumVertex();
 
-    // fist itearte through the vertices of the graph to get nnz
-    Vertex *theVertex;
-    int newNNZ = 0;
-    VertexIter &theVertices = theGraph.getVertices();
-    while ((theVertex = theVertices()) != 0) {
-	const ID &theAdjacency = theVertex->getAdjacency();
-	newNNZ += theAdjacency.Size() +1; // the +1 is for the diag entry
+    // form the pattern of A from the graph to get nnz
+    SparsePattern thePattern;
+    if (thePattern.form(theGraph) < 0) {
+	opserr << "WARNING:SparseGenColLinSOE::setSize :";
+	opserr << " failed to form the pattern of A - size set to 0\n";
+	size = 0;
+	return -1;
     }
+    int newNNZ = thePattern.getNNZ();
     nnz = newNNZ;
 
     if (newNNZ > Asize) { // we have to get more space for A and rowA
@@ -203,6 +205,9 @@ SparseGenColLinSOE::setSize(Graph &theGraph)
 	A[i] = 0;
 	
     factored = false;
+
+    // the locations of the element terms in A are for the old graph
+    theLocations.clear();
     
     if (size > Bsize) { // we have to get space for the vectors
 	
@@ -247,51 +252,14 @@ SparseGenColLinSOE::setSize(Graph &theGraph)
 
     // fill in colStartA and rowA
     if (size != 0) {
-      colStartA[0] = 0;
-      int startLoc = 0;
-      int lastLoc = 0;
-      for (int a=0; a<size; a++) {
-
-	theVertex = theGraph.getVertexPtr(a);
-	if (theVertex == 0) {
-	  opserr << "WARNING:SparseGenColLinSOE::setSize :";
-	  opserr << " vertex " << a << " not in graph! - size set to 0\n";
-	  size = 0;
-	  return -1;
-	}
-
-	rowA[lastLoc++] = theVertex->getTag(); // place diag in first
-	const ID &theAdjacency = theVertex->getAdjacency();
-	int idSize = theAdjacency.Size();
-	
-	// now we have to place the entries in the ID into order in rowA
-	for (int i=0; i<idSize; i++) {
-
-	  int row = theAdjacency(i);
-	  bool foundPlace = false;
-	  // find a place in rowA for current col
-	  for (int j=startLoc; j<lastLoc; j++)
-	    if (rowA[j] > row) { 
-	      // move the entries already there one further on
-	      // and place col in current location
-	      for (int k=lastLoc; k>j; k--)
-		
-		rowA[k] = rowA[k-1];
-	      rowA[j] = row;
-	      foundPlace = true;
-	      j = lastLoc;
-	    }
-	  if (foundPlace == false) // put in at the end
-	    rowA[lastLoc] = row;
-
-	  lastLoc++;
-	}
-	colStartA[a+1] = lastLoc;;	    
-	startLoc = lastLoc;
-      }
+      const int *start = thePattern.getStart();
+      const int *index = thePattern.getIndex();
+      for (int a=0; a<=size; a++)
+	colStartA[a] = start[a];
+      for (int k=0; k<newNNZ; k++)
+	rowA[k] = index[k];
     }
 
-    
     // invoke setSize() on the Solver    
     LinearSOESolver *the_Solver = this->getSolver();
     int solverOK = the_Solver->setSize();
@@ -320,46 +288,70 @@ SparseGenColLinSOE::addA(const Matrix &m, const ID &id, double fact)
 	return -1;
     }
     
+    const int *locA = this->getLocations(id);
+
     if (fact == 1.0) { // do not need to multiply 
       for (int i=0; i<idSize; i++) {
-	int col = id(i);
-	if (col < size && col >= 0) {
-	  int startColLoc = colStartA[col];
-	  int endColLoc = colStartA[col+1];
-	  for (int j=0; j<idSize; j++) {
-	    int row = id(j);
-	    if (row <size && row >= 0) {
-	      // find place in A using rowA
-	      for (int k=startColLoc; k<endColLoc; k++)
-		if (rowA[k] == row) {
-		  A[k] += m(j,i);
-		  k = endColLoc;
-		}
-	    }
-	  }  // for j		
-	} 
-      }  // for i
+	for (int j=0; j<idSize; j++) {
+	  int k = *locA++;
+	  if (k >= 0)
+	    A[k] += m(j,i);
+	}
+      }
     } else {
       for (int i=0; i<idSize; i++) {
-	int col = id(i);
-	if (col < size && col >= 0) {
-	  int startColLoc = colStartA[col];
+	for (int j=0; j<idSize; j++) {
+	  int k = *locA++;
+	  if (k >= 0)
+	    A[k] += fact * m(j,i);
+	}
+      }
+    }
+    return 0;
+}
+
+
+const int *
+SparseGenColLinSOE::getLocations(const ID &id)
+{
+    int idSize = id.Size();
+    Locations &theEntry = theLocations[&id];
+
+    // the ID may have been renumbered, or a new one created at the address
+    // of an old one, since the locations were formed
+    bool formed = ((int)theEntry.dofs.size() == idSize);
+    for (int i=0; formed == true && i<idSize; i++)
+      if (theEntry.dofs[i] != id(i))
+	formed = false;
+
+    if (formed == true)
+      return theEntry.locations.data();
+
+    theEntry.dofs.resize(idSize);
+    theEntry.locations.resize(idSize*idSize);
+    for (int i=0; i<idSize; i++)
+      theEntry.dofs[i] = id(i);
+
+    int *locA = theEntry.locations.data();
+    for (int i=0; i<idSize; i++) {
+      int col = id(i);
+      for (int j=0; j<idSize; j++) {
+	int row = id(j);
+	int loc = -1;
+	if (col < size && col >= 0 && row < size && row >= 0) {
+	  // find place in A using rowA
 	  int endColLoc = colStartA[col+1];
-	  for (int j=0; j<idSize; j++) {
-	    int row = id(j);
-	    if (row <size && row >= 0) {
-	      // find place in A using rowA
-	      for (int k=startColLoc; k<endColLoc; k++)
-		if (rowA[k] == row) {
-		  A[k] += fact * m(j,i);
-		  k = endColLoc;
-		}
+	  for (int k=colStartA[col]; k<endColLoc; k++)
+	    if (rowA[k] == row) {
+	      loc = k;
+	      break;
 	    }
-	  }  // for j		
-	} 
-      }  // for i
+	}
+	*locA++ = loc;
+      }
     }
-    return 0;
+
+    return theEntry.locations.data();
 }
 
     
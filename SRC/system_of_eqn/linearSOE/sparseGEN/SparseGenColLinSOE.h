@@ -38,6 +38,9 @@
 
 #include <LinearSOE.h>
 #include <Vector.h>
+#include <ID.h>
+#include <unordered_map>
+#include <vector>
 
 class SparseGenColLinSolver;
 
@@ -98,7 +101,17 @@ class SparseGenColLinSOE : public LinearSOE
     bool factored;
     
   private:
+    const int *getLocations(const ID &id);
 
+    // the locations in A of the terms of the matrices passed to addA() with
+    // a given ID object (usually the ID of an FE_Element), column by column
+    // and -1 for terms not stored. formed the first time the ID is seen
+    // after setSize(), so that later calls need no searching of rowA.
+    struct Locations {
+      std::vector<int> dofs;        // the equation numbers they are for
+      std::vector<int> locations;   
+    };
+    std::unordered_map<const ID *, Locations> theLocations;
 };
 
 
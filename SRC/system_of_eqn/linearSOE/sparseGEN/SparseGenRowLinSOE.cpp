@@ -31,6 +31,7 @@
 #include <SparseGenRowLinSolver.h>
 #include <Matrix.h>
 #include <Graph.h>
+#include <SparsePattern.h>
 #include <Vertex.h>
 #include <VertexIter.h>
 #include <math.h>
@@ -132,14 +133,15 @@ SparseGenRowLinSOE::setSize(Graph &theGraph)
     int oldSize = size;
     size = theGraph.getNumVertex();
 
-    // fist itearte through the vertices of the graph to get nnz
-    Vertex *theVertex;
-    int newNNZ = 0;
-    VertexIter &theVertices = theGraph.getVertices();
-    while ((theVertex = theVertices()) != 0) {
-	const ID &theAdjacency = theVertex->getAdjacency();
-	newNNZ += theAdjacency.Size() +1; // the +1 is for the diag entry
+    // form the pattern of A from the graph to get nnz
+    SparsePattern thePattern;
+    if (thePattern.form(theGraph) < 0) {
+	opserr << "WARNING:SparseGenRowLinSOE::setSize :";
+	opserr << " failed to form the pattern of A - size set to 0\n";
+	size = 0;
+	return -1;
     }
+    int newNNZ = thePattern.getNNZ();
     nnz = newNNZ;
 
     if (newNNZ > Asize) { // we have to get more space for A and colA
@@ -211,48 +213,12 @@ SparseGenRowLinSOE::setSize(Graph &theGraph)
 
     // fill in rowStartA and colA
     if (size != 0) {
-      rowStartA[0] = 0;
-      int startLoc = 0;
-      int lastLoc = 0;
-      for (int a=0; a<size; a++) {
-
-	theVertex = theGraph.getVertexPtr(a);
-	if (theVertex == 0) {
-	  opserr << "WARNING:SparseGenRowLinSOE::setSize :";
-	  opserr << " vertex " << a << " not in graph! - size set to 0\n";
-	  size = 0;
-	  return -1;
-	}
-
-	colA[lastLoc++] = theVertex->getTag(); // place diag in first
-	const ID &theAdjacency = theVertex->getAdjacency();
-	int idSize = theAdjacency.Size();
-	
-	// now we have to place the entries in the ID into order in colA
-	for (int i=0; i<idSize; i++) {
-
-	  int row = theAdjacency(i);
-	  bool foundPlace = false;
-	  // find a place in colA for current col
-	  for (int j=startLoc; j<lastLoc; j++)
-	    if (colA[j] > row) { 
-	      // move the entries already there one further on
-	      // and place col in current location
-	      for (int k=lastLoc; k>j; k--)
-		
-		colA[k] = colA[k-1];
-	      colA[j] = row;
-	      foundPlace = true;
-	      j = lastLoc;
-	    }
-	  if (foundPlace == false) // put in at the end
-	    colA[lastLoc] = row;
-
-	  lastLoc++;
-	}
-	rowStartA[a+1] = lastLoc;;	    
-	startLoc = lastLoc;
-      }
+      const int *start = thePattern.getStart();
+      const int *index = thePattern.getIndex();
+      for (int a=0; a<=size; a++)
+	rowStartA[a] = start[a];
+      for (int k=0; k<newNNZ; k++)
+	colA[k] = index[k];
     }
 
     // invoke setSize() on the Solver   
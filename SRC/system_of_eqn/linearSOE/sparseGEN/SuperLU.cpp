@@ -34,6 +34,7 @@
 
 #include <SuperLU.h>
 #include <SparseGenColLinSOE.h>
+#include <SparsePattern.h>
 #include <math.h>
 #include <Channel.h>
 #include <FEM_ObjectBroker.h>
@@ -97,7 +98,8 @@ SuperLU::SuperLU(int perm,
 :SparseGenColLinSolver(SOLVER_TAGS_SuperLU),
  perm_r(0),perm_c(0), etree(0), sizePerm(0),
  relax(relx), permSpec(perm), panelSize(panel), 
- drop_tol(drop_tolerance), symmetric(symm)
+ drop_tol(drop_tolerance), symmetric(symm),
+ patternSize(0), patternNNZ(0), patternFingerprint(0)
 {
   // set_default_options(&options);
   options.Fact = DOFACT;
@@ -137,18 +139,8 @@ SuperLU::~SuperLU()
     Destroy_SuperNode_Matrix(&L);
   if (U.ncol != 0)
     Destroy_CompCol_Matrix(&U);
-  if (AC.ncol != 0) {
-    NCPformat *ACstore = (NCPformat *)AC.Store;
-    SUPERLU_FREE(ACstore->colbeg);
-    SUPERLU_FREE(ACstore->colend);
-    SUPERLU_FREE(ACstore);
-  }
-  if (A.ncol != 0) {
-    SUPERLU_FREE(A.Store);
-  }
-  if (B.ncol != 0) {
-    SUPERLU_FREE(B.Store);
-  }
+
+  this->destroyMatrices();
 }
 
 /*
@@ -283,6 +275,25 @@ SuperLU::setSize()
     int n = theSOE->size;
     if (n > 0) {
 
+      // if the pattern is the one the column permutation and elimination
+      // tree were formed for keep them, and the factorization mode; A, AC
+      // and B only need to be formed again if the SOE moved its arrays
+      unsigned long long fingerprint =
+	SparsePattern::getFingerprint(n, theSOE->colStartA, theSOE->rowA);
+
+      if (A.ncol == n && n == patternSize && theSOE->nnz == patternNNZ
+	  && fingerprint == patternFingerprint) {
+
+	NCformat *Astore = (NCformat *)A.Store;
+	DNformat *Bstore = (DNformat *)B.Store;
+	if (Astore->nzval != theSOE->A || Astore->rowind != theSOE->rowA
+	    || Astore->colptr != theSOE->colStartA || Bstore->nzval != theSOE->X) {
+	  this->destroyMatrices();
+	  this->createMatrices(false);
+	}
+	return 0;
+      }
+
       // create space for the permutation vectors 
       // and the elimination tree
       if (sizePerm < n) {
@@ -311,19 +322,6 @@ SuperLU::setSize()
       // initialisation
       StatInit(&stat);
 
-      // create the SuperMatrix A	
-      dCreate_CompCol_Matrix(&A, n, n, theSOE->nnz, theSOE->A, 
-			     theSOE->rowA, theSOE->colStartA, 
-			     SLU_NC, SLU_D, SLU_GE);
-
-      // obtain and apply column permutation to give SuperMatrix AC
-      get_perm_c(permSpec, &A, perm_c);
-
-      sp_preorder(&options, &A, perm_c, etree, &AC);
-
-      // create the rhs SuperMatrix B 
-      dCreate_Dense_Matrix(&B, n, 1, theSOE->X, n, SLU_DN, SLU_D, SLU_GE);
-	
       // set the refact variable to 'N' after first factorization with new size 
       // can set to 'Y'.
       options.Fact = DOFACT;
@@ -331,6 +329,14 @@ SuperLU::setSize()
       if (symmetric == 'Y')
 	options.SymmetricMode=YES;
 
+      // create the SuperMatrices A, AC and B with a new column permutation
+      this->destroyMatrices();
+      this->createMatrices(true);
+
+      patternSize = n;
+      patternNNZ = theSOE->nnz;
+      patternFingerprint = fingerprint;
+
     } else if (n == 0)
 	return 0;
     else {
@@ -342,6 +348,47 @@ SuperLU::setSize()
     return 0;
 }
 
+void
+SuperLU::createMatrices(bool newOrdering)
+{
+    int n = theSOE->size;
+
+    // create the SuperMatrix A	
+    dCreate_CompCol_Matrix(&A, n, n, theSOE->nnz, theSOE->A, 
+			   theSOE->rowA, theSOE->colStartA, 
+			   SLU_NC, SLU_D, SLU_GE);
+
+    // obtain the column permutation if the pattern is new, and apply it
+    // to give SuperMatrix AC
+    if (newOrdering == true)
+      get_perm_c(permSpec, &A, perm_c);
+
+    sp_preorder(&options, &A, perm_c, etree, &AC);
+
+    // create the rhs SuperMatrix B 
+    dCreate_Dense_Matrix(&B, n, 1, theSOE->X, n, SLU_DN, SLU_D, SLU_GE);
+}
+
+void
+SuperLU::destroyMatrices(void)
+{
+    if (AC.ncol != 0) {
+      NCPformat *ACstore = (NCPformat *)AC.Store;
+      SUPERLU_FREE(ACstore->colbeg);
+      SUPERLU_FREE(ACstore->colend);
+      SUPERLU_FREE(ACstore);
+      AC.ncol = 0;
+    }
+    if (A.ncol != 0) {
+      SUPERLU_FREE(A.Store);
+      A.ncol = 0;
+    }
+    if (B.ncol != 0) {
+      SUPERLU_FREE(B.Store);
+      B.ncol = 0;
+    }
+}
+
 int
 SuperLU::sendSelf(int cTag, Channel &theChannel)
 {
@@ -41,6 +41,10 @@
 // pivoting (GEPP). The columns of A may be preordered before
 // factorization; the preordering for sparsity is completely separate
 // from the factorization and a number of ordering schemes are provided. 
+// The column permutation and elimination tree are kept for as long as
+// setSize() is given the same pattern, so that a change of the domain
+// that leaves the pattern of A as it was costs only the numeric
+// factorizations.
 //
 // What: "@(#) SuperLU.h, revA"
 
@@ -67,6 +71,9 @@ class SuperLU : public SparseGenColLinSolver
   protected:
 
   private:
+    void destroyMatrices(void);
+    void createMatrices(bool newOrdering);
+
     SuperMatrix A,L,U,B,AC;
     int *perm_r;
     int *perm_c;
@@ -77,6 +84,8 @@ class SuperLU : public SparseGenColLinSolver
     char symmetric;
     superlu_options_t options;
     SuperLUStat_t stat;
+    int patternSize, patternNNZ;           // pattern of perm_c and etree
+    unsigned long long patternFingerprint;
 };
 
 #endif
@@ -146,6 +146,9 @@ int SymSparseLinSOE::setSize(Graph &theGraph)
     } 
 	
     factored = false;
+
+    // the locations of the element terms are for the old factorization
+    theLocations.clear();
     
     if (size > Bsize) { // we have to get space for the vectors
 	
@@ -236,11 +239,22 @@ int SymSparseLinSOE::setSize(Graph &theGraph)
     nblks = symFactorization(rowStartA, colA, size, this->LSPARSE,
 			     &xblk, &invp, &rowblks, &begblk, &first, &penv, &diag);
 
+    // invoke setSize() on the Solver
+    LinearSOESolver *the_Solver = this->getSolver();
+    int solverOK = the_Solver->setSize();
+    if (solverOK < 0) {
+	opserr << "WARNING SymSparseLinSOE::setSize :";
+	opserr << " solver failed setSize()\n";
+	return solverOK;
+    }
+
     return result;
 }
 
 
 /* Perform the element stiffness assembly here.
+ * The address of each term is looked up once for each ID by getLocations,
+ * only the upper triangle of the symmetric element matrix is assembled.
  */
 int SymSparseLinSOE::addA(const Matrix &in_m, const ID &in_id, double fact)
 {
@@ -258,143 +272,118 @@ int SymSparseLinSOE::addA(const Matrix &in_m, const ID &in_id, double fact)
        return -1;
    }
 
-   // construct m and id based on non-negative id values.
-   int newPt = 0;
-   int *id = new (nothrow) int[idSize];
-   
-   for (int jj = 0; jj < idSize; jj++) {
-       if (in_id(jj) >= 0 && in_id(jj) < size) {
-	   id[newPt] = in_id(jj);
-	   newPt++;
-       }
-   }
+   double *const *loc = this->getLocations(in_id);
 
-   idSize = newPt;
-   if (idSize == 0)  return 0;
-   double *m = new (nothrow) double[idSize*idSize];
-
-   int newII = 0;
-   for (int ii = 0; ii < in_id.Size(); ii++) {
-       if (in_id(ii) >= 0 && in_id(ii) < size) {
-
-	   int newJJ = 0;
-	   for (int jj = 0; jj < in_id.Size(); jj++) {
-	       if (in_id(jj) >= 0 && in_id(jj) < size) {
-		   m[newII*idSize + newJJ] = in_m(ii, jj);
-		   newJJ++;
-	       }
+   if (fact == 1.0) {
+       for (int i=0; i<idSize; i++) {
+	   for (int j=i; j<idSize; j++) {
+	       double *fpt = *loc++;
+	       if (fpt != 0)
+		   *fpt += in_m(i,j);
+	   }
+       }
+   } else {
+       for (int i=0; i<idSize; i++) {
+	   for (int j=i; j<idSize; j++) {
+	       double *fpt = *loc++;
+	       if (fpt != 0)
+		   *fpt += in_m(i,j) * fact;
 	   }
-	   newII++;
        }
    }
 
-   // forming the new id based on invp.
+   return 0;
+}
 
-   int *newID = new (nothrow) int[idSize];
-   int *isort = new (nothrow) int[idSize];
-   if (newID == 0 || isort ==0) {
-       opserr << "WARNING SymSparseLinSOE::SymSparseLinSOE :";
-       opserr << " ran out of memory for vectors (newID, isort)";
-       return -1;
-   }
 
-   for (int kk=0; kk<idSize; kk++) {
-       newID[kk] = id[kk];
-       if (newID[kk] >= 0)
-	   newID[kk] = invp[newID[kk]];
+/* Find the address in diag, penv or the row segments of each term
+ * (i,j), j >= i, of a matrix assembled with the given ID.
+ */
+double *const *
+SymSparseLinSOE::getLocations(const ID &in_id)
+{
+   int idSize = in_id.Size();
+   Locations &theEntry = theLocations[&in_id];
+
+   // the ID may have been renumbered, or a new one created at the address
+   // of an old one, since the locations were formed
+   bool formed = ((int)theEntry.dofs.size() == idSize);
+   for (int i=0; formed == true && i<idSize; i++)
+       if (theEntry.dofs[i] != in_id(i))
+	   formed = false;
+
+   if (formed == true)
+       return theEntry.locations.data();
+
+   theEntry.dofs.resize(idSize);
+   for (int i=0; i<idSize; i++)
+       theEntry.dofs[i] = in_id(i);
+
+   // the locations of term (i,j), j >= i, is at the position tri(i,j)
+   std::vector<double *> &locations = theEntry.locations;
+   locations.assign(idSize*(idSize+1)/2, (double *)0);
+#define tri(i,j) ((i)*idSize - (i)*((i)-1)/2 + (j)-(i))
+
+   // the positions of the equations in the ID and their number after
+   // the reordering, sorted by the reordered number
+   std::vector<int> newID(idSize, -1);
+   std::vector<int> isort;
+   isort.reserve(idSize);
+   for (int i=0; i<idSize; i++) {
+       int eqn = in_id(i);
+       if (eqn >= 0 && eqn < size) {
+	   newID[i] = invp[eqn];
+	   isort.push_back(i);
+       }
    }
-   
-   long int  i_eq, j_eq;
-   int  i, j, nee, lnee;
-   int  k, ipos, jpos;
-   int  it, jt;
-   int  iblk;
-   OFFDBLK  *ptr;
-   OFFDBLK  *saveblk;
-   double  *fpt, *iloc, *loc;
-
-   nee = idSize;
-   lnee = nee;
-   
-   /* initialize isort */
-   for( i = 0, k = 0; i < lnee ; i++ )
-   {
-       if( newID[i] >= 0 ) {
-	   isort[k] = i;
-	   k++;
+
+   int lnee = isort.size();
+   if (lnee == 0)
+       return locations.data();
+
+   for (int i=1; i<lnee; i++) {
+       int ipos = isort[i];
+       int j = i-1;
+       while (j >= 0 && newID[isort[j]] > newID[ipos]) {
+	   isort[j+1] = isort[j];
+	   j--;
        }
+       isort[j+1] = ipos;
    }
-      
-   lnee = k;
-
-   /* perform the sorting of isort here */
-   i = k - 1;
-   do
-   {
-       k = 0 ;
-       for (j = 0 ; j < i ; j++)
-       {  
-	   if ( newID[isort[j]] > newID[isort[j+1]]) {  
-	       isort[j] ^= isort[j+1] ;
-	       isort[j+1] ^= isort[j] ;
-	       isort[j] ^= isort[j+1] ;
-	       k = j ;
+
+   int k = rowblks[newID[isort[0]]];
+   OFFDBLK *saveblk = begblk[k];
+
+   /* iterate through the element stiffness matrix, locate each entry */
+   for (int i=0; i<lnee; i++) {
+       int ipos = isort[i];
+       int i_eq = newID[ipos];
+       int iblk = rowblks[i_eq];
+       double *iloc = penv[i_eq +1] - i_eq;
+       if (k < iblk)
+	   while (saveblk->row != i_eq) saveblk = saveblk->bnext;
+
+       OFFDBLK *ptr = saveblk;
+       for (int j=0; j<i; j++) {
+	   int jpos = isort[j];
+	   int j_eq = newID[jpos];
+
+	   int it = (ipos < jpos) ? ipos : jpos;
+	   int jt = (ipos < jpos) ? jpos : ipos;
+
+	   if (j_eq >= xblk[iblk]) /* diagonal block (profile) */
+	       locations[tri(it,jt)] = iloc + j_eq;
+	   else { /* row segment */
+	       while ((j_eq >= (ptr->next)->beg) && ((ptr->next)->row == i_eq))
+		   ptr = ptr->next;
+	       locations[tri(it,jt)] = ptr->nz + (j_eq - ptr->beg);
 	   }
-      }
-      i = k ;
-   }  while ( k > 0) ;
-
-      i = 0 ;
-      ipos = isort[i] ;
-      k = rowblks[newID[ipos]] ;
-      saveblk  = begblk[k] ;
-
-      /* iterate through the element stiffness matrix, assemble each entry */
-      for (i=0; i<lnee; i++)
-      { 
-	 ipos = isort[i] ;
-         i_eq = newID[ipos] ;
-	 iblk = rowblks[i_eq] ;
-	 iloc = penv[i_eq +1] - i_eq ;
-	 if (k < iblk)
-	    while (saveblk->row != i_eq) saveblk = saveblk->bnext ;
-	 
-	 ptr = saveblk ;
-	 for (j=0; j< i ; j++)
-	 {   
-	    jpos = isort[j] ;
-	    j_eq = newID[jpos] ;
-
-	    if (ipos > jpos) {
-	        jt = ipos;
-		it = jpos;
-	    } else {
-	        it = ipos;
-		jt = jpos;
-	    }
-
-	    if (j_eq >= xblk[iblk]) /* diagonal block (profile) */
-	    {  
-	        loc = iloc + j_eq ;
-		*loc += m[it*idSize + jt] * fact;
-            } 
-	    else /* row segment */
-	    { 
-	        while((j_eq >= (ptr->next)->beg) && ((ptr->next)->row == i_eq))
-		    ptr = ptr->next ;
-		fpt = ptr->nz ;
-		fpt[j_eq - ptr->beg] += m[it*idSize + jt] * fact;
-            }
-         }
-	 diag[i_eq] += m[ipos*idSize + ipos] * fact; /* diagonal element */
-      }
-  	  
-    delete [] newID;
-    delete [] isort;
-    delete [] m;
-    delete [] id;
+       }
+       locations[tri(ipos,ipos)] = &diag[i_eq]; /* diagonal element */
+   }
+#undef tri
 
-    return 0;
+   return locations.data();
 }
 
     
@@ -413,61 +402,14 @@ int SymSparseLinSOE::addB(const Vector &in_v, const ID &in_id, double fact)
 	return -1;
     } 
 
-   // construct v and id based on non-negative id values.
-   int newPt = 0;
-   int *id = new (nothrow) int[idSize];
-   double *v = new (nothrow) double[idSize];
-
-   for (int ii = 0; ii < idSize; ii++) {
-       if (in_id(ii) >= 0 && in_id(ii) < size) {
-	   id[newPt] = in_id(ii);
-	   v[newPt] = in_v(ii);
-	   newPt++;
-       }
-   }
-
-   idSize = newPt;
-   if (idSize == 0)  {
-       delete [] id;
-       delete [] v;
-       return 0;
-   }
-    int *newID = new (nothrow) int[idSize];
-    if (newID == 0) {
-       opserr << "WARNING SymSparseLinSOE::SymSparseLinSOE :";
-       opserr << " ran out of memory for vectors (newID)";
-        return -1;
-    }
-
     for (int i=0; i<idSize; i++) {
-       newID[i] = id[i];
-	if (newID[i] >= 0)
-	    newID[i] = invp[newID[i]];
-    }
-
-    if (fact == 1.0) { // do not need to multiply if fact == 1.0
-	for (int i=0; i<idSize; i++) {
-	    int pos = newID[i];
+	int eqn = in_id(i);
+	if (eqn >= 0 && eqn < size) {
+	    int pos = invp[eqn];
 	    if (pos <size && pos >= 0)
-		B[pos] += v[i];
+		B[pos] += in_v(i) * fact;  // assemble
 	}
-    } else if (fact == -1.0) { // do not need to multiply if fact == -1.0
-	for (int i=0; i<idSize; i++) {
-	    int pos = newID[i];
-	    if (pos <size && pos >= 0)
-		B[pos] -= v[i];
-	}
-    } else {
-	for (int i=0; i<idSize; i++) {
-	    int pos = newID[i];
-	    if (pos <size && pos >= 0)
-		B[pos] += v[i] * fact;  // assemble
-	}
-    }	
-
-    delete [] newID;
-    delete [] v;
-    delete [] id;
+    }
 
     return 0;
 }
@@ -21,6 +21,9 @@
 
 #include <LinearSOE.h>
 #include <Vector.h>
+#include <ID.h>
+#include <unordered_map>
+#include <vector>
 
 extern "C" {
    #include <FeStructs.h>
@@ -81,6 +84,18 @@ class SymSparseLinSOE : public LinearSOE
     OFFDBLK  **begblk;
     OFFDBLK  *first;
 
+    double *const *getLocations(const ID &id);
+
+    // the address in diag, penv or the row segments of each term of the
+    // upper triangle of the matrix passed with a given ID (usually the ID
+    // of an FE_Element), row by row, and 0 for terms not stored; formed
+    // the first time the ID is seen after setSize(), so that later calls
+    // need no sorting and no walking of the row segments.
+    struct Locations {
+      std::vector<int> dofs;           // the equation numbers they are for
+      std::vector<double *> locations;
+    };
+    std::unordered_map<const ID *, Locations> theLocations;
 };
 
 #endif
@@ -17,9 +17,13 @@
 #include "SymSparseLinSOE.h"
 #include "SymSparseLinSolver.h"
 #include <math.h>
+#include <Matrix.h>
 #include <Channel.h>
 #include <FEM_ObjectBroker.h>
+#include <ThreadPool.h>
 #include <elementAPI.h>
+#include <mutex>
+#include <condition_variable>
 
 extern "C" {
 #include "FeStructs.h"
@@ -44,23 +48,30 @@ void* OPS_SymSparseLinSolver()
     return new SymSparseLinSOE(*theSolver, lSparse);  
 }
 
-SymSparseLinSolver::SymSparseLinSolver()
+SymSparseLinSolver::SymSparseLinSolver(int numThreads)
 :LinearSOESolver(SOLVER_TAGS_SymSparseLinSolver),
- theSOE(0)
+ theSOE(0), NP(numThreads), thePool(0)
 {
-    // nothing to do.
+    if (NP < 1)
+	NP = 1;
+    if (NP > 1)
+	thePool = new ThreadPool(NP);
 }
 
 
 SymSparseLinSolver::~SymSparseLinSolver()
 { 
-    // nothing to do.
+    if (thePool != 0)
+	delete thePool;
 }
 
 
 extern "C" int pfsfct(int neqns, double *diag, double **penv, int nblks, int *xblk,
 		      OFFDBLK **begblk, OFFDBLK *first, int *rowblks);
 
+extern "C" int pfbfct(int blk, double *diag, double **penv, int *xblk,
+		      OFFDBLK **begblk, OFFDBLK **pjs, int *rowblks);
+
 extern "C" void pfsslv(int neqns, double *diag, double **penv, int nblks,
 		       int *xblk, double *rhs, OFFDBLK **begblk);
 
@@ -79,9 +90,7 @@ SymSparseLinSolver::solve(void)
     int      *invp = theSOE->invp;
     double   *diag = theSOE->diag;
     double   **penv = theSOE->penv;
-    int      *rowblks = theSOE->rowblks;
     OFFDBLK  **begblk = theSOE->begblk;
-    OFFDBLK  *first = theSOE->first;
 
     int neq = theSOE->size;
 
@@ -101,7 +110,7 @@ SymSparseLinSolver::solve(void)
         //factor the matrix
         //call the "C" function to do the numerical factorization.
         int factor;
-	factor = pfsfct(neq, diag, penv, nblks, xblk, begblk, first, rowblks);
+	factor = this->factor();
 	if (factor > 0) {
 	    opserr << "In SymSparseLinSolver: error in factorization.\n";
 	    return -1;
@@ -117,34 +126,298 @@ SymSparseLinSolver::solve(void)
     // Since the X we get by solving AX=B is P*X, we need to reordering
     // the Xptr to ge the wanted X.
 
-    double *tempX = new double[neq];
-    if (tempX == 0) {
-        opserr << "WARNING SymSparseLinSover::SymSparseLinSolver :";
-	opserr << " ran out of memory for vectors (tempX) ";
-	return -1;
-    } 
-
+    work.resize(neq);
     for (int m=0; m<neq; m++) {
-        tempX[m] = Xptr[invp[m]];
+        work[m] = Xptr[invp[m]];
     }
 	
     for (int k=0; k<neq; k++) {
-        Xptr[k] = tempX[k];
+        Xptr[k] = work[k];
     }
 	
-    delete [] tempX;
     return 0;
 }
 
 
 int
-SymSparseLinSolver::setSize()
+SymSparseLinSolver::solve(Matrix &theB)
 {
-    // nothing to do
+    if (theSOE == 0) {
+	opserr << "WARNING SymSparseLinSolver::solve(Matrix)- ";
+	opserr << " No LinearSOE object has been set\n";
+	return -1;
+    }
+
+    int neq = theSOE->size;
+    int numRHS = theB.noCols();
+    if (theB.noRows() != neq) {
+	opserr << "WARNING SymSparseLinSolver::solve(Matrix)- ";
+	opserr << " the matrix of right hand sides has " << theB.noRows();
+	opserr << " rows, not " << neq << "\n";
+	return -1;
+    }
+
+    // check for quick return
+    if (neq == 0 || numRHS == 0)
+	return 0;
+
+    if (theSOE->factored == false) {
+	if (this->factor() > 0) {
+	    opserr << "In SymSparseLinSolver: error in factorization.\n";
+	    return -1;
+	}
+	theSOE->factored = true;
+    }
+
+    int      nblks = theSOE->nblks;
+    int      *xblk = theSOE->xblk;
+    int      *invp = theSOE->invp;
+    double   *diag = theSOE->diag;
+    double   **penv = theSOE->penv;
+    OFFDBLK  **begblk = theSOE->begblk;
+
+    // each column is permuted into work, solved and permuted back; the
+    // factor is only read, so the columns are independent of each other
+    work.resize((size_t)neq*numRHS);
+    double *rhs = work.data();
+    auto solveColumns = [&](int begin, int end, int) {
+	for (int j=begin; j<end; j++) {
+	    double *x = rhs + (size_t)j*neq;
+	    for (int i=0; i<neq; i++)
+		x[invp[i]] = theB(i,j);
+	    pfsslv(neq, diag, penv, nblks, xblk, x, begblk);
+	    for (int i=0; i<neq; i++)
+		theB(i,j) = x[invp[i]];
+	}
+    };
+
+    if (thePool != 0)
+	thePool->parallelFor(numRHS, solveColumns);
+    else
+	solveColumns(0, numRHS, 0);
+
     return 0;
 }
 
 
+// factor the matrix, returning a positive value if a zero diagonal is
+// found as pfsfct() does
+int
+SymSparseLinSolver::factor(void)
+{
+    int      neq = theSOE->size;
+    int      nblks = theSOE->nblks;
+    int      *xblk = theSOE->xblk;
+    double   *diag = theSOE->diag;
+    double   **penv = theSOE->penv;
+    int      *rowblks = theSOE->rowblks;
+    OFFDBLK  **begblk = theSOE->begblk;
+    OFFDBLK  *first = theSOE->first;
+
+    int numTasks = (int)taskStart.size() - 1;
+    if (thePool == 0 || numTasks < 2 || (int)blockSegment.size() != nblks)
+	return pfsfct(neq, diag, penv, nblks, xblk, begblk, first, rowblks);
+
+    // the tasks whose blocks depend on no other task are ready at once,
+    // the others become ready when the last task they wait for is done
+    std::vector<int> numWaiting(numDepends);
+    std::vector<int> ready;
+    ready.reserve(numTasks);
+    for (int t=0; t<numTasks; t++)
+	if (numWaiting[t] == 0)
+	    ready.push_back(t);
+
+    std::mutex theMutex;
+    std::condition_variable readyCondition;
+    int numDone = 0;
+    int result = 0;
+
+    thePool->run([&](int) {
+	std::unique_lock<std::mutex> lock(theMutex);
+	while (true) {
+	    readyCondition.wait(lock, [&] {
+		return !ready.empty() || numDone == numTasks || result != 0;
+	    });
+	    if (result != 0 || ready.empty())
+		return;
+
+	    int t = ready.back();
+	    ready.pop_back();
+	    lock.unlock();
+
+	    int error = 0;
+	    for (int k=taskStart[t]; k<taskStart[t+1] && error == 0; k++) {
+		int blk = taskBlocks[k];
+		OFFDBLK *js = blockSegment[blk];
+		error = pfbfct(blk, diag, penv, xblk, begblk, &js, rowblks);
+		if (error == 2)
+		    error = blk + 1;
+	    }
+
+	    lock.lock();
+	    if (error != 0) {
+		result = error;
+		readyCondition.notify_all();
+		return;
+	    }
+
+	    numDone++;
+	    for (int k=dependentStart[t]; k<dependentStart[t+1]; k++)
+		if (--numWaiting[taskDependents[k]] == 0)
+		    ready.push_back(taskDependents[k]);
+	    readyCondition.notify_all();
+	}
+    });
+
+    return result;
+}
+
+
+// Cut the block elimination tree into the tasks of the threaded
+// factorization. Block J is a child of the block holding the first row
+// segment under J, and a block depends on every block it has a row segment
+// under. The largest subtrees with no more than 1/(4 NP) of the work are
+// each a task, every block above them is a task of its own.
+int
+SymSparseLinSolver::formSchedule(void)
+{
+    blockSegment.clear();
+    taskStart.clear();
+    taskBlocks.clear();
+    dependentStart.clear();
+    taskDependents.clear();
+    numDepends.clear();
+
+    if (theSOE == 0 || thePool == 0)
+	return 0;
+
+    int      neq = theSOE->size;
+    int      nblks = theSOE->nblks;
+    int      *xblk = theSOE->xblk;
+    double   **penv = theSOE->penv;
+    int      *rowblks = theSOE->rowblks;
+    OFFDBLK  **begblk = theSOE->begblk;
+    OFFDBLK  *first = theSOE->first;
+
+    if (neq == 0 || nblks < 2)
+	return 0;
+
+    // the first row segment with a row in each block; the last segment
+    // is the one with row neq, pointing to itself
+    blockSegment.resize(nblks);
+    OFFDBLK *js = first;
+    for (int blk=0; blk<nblks; blk++) {
+	while (js->row < xblk[blk])
+	    js = js->next;
+	blockSegment[blk] = js;
+    }
+
+    // number of row segments under each block
+    std::vector<int> numSegments(nblks, 0);
+    for (int blk=0; blk<nblks; blk++)
+	for (OFFDBLK *ks = begblk[blk]; ks->row < neq; ks = ks->bnext)
+	    numSegments[blk]++;
+
+    // an estimate of the work to factor each block and the subtree of
+    // blocks below it
+    std::vector<int> parent(nblks);
+    std::vector<double> subtreeWork(nblks, 0.0);
+    double totalWork = 0.0;
+    for (int blk=0; blk<nblks; blk++) {
+	int blkend = xblk[blk+1];
+	double blkWork = 0.0;
+	for (int i=xblk[blk]; i<blkend; i++) {
+	    double envlen = penv[i+1] - penv[i];
+	    blkWork += envlen*envlen;
+	}
+	for (js = blockSegment[blk]; js->row < blkend; js = js->next) {
+	    int jblk = rowblks[js->beg];
+	    blkWork += double(xblk[jblk+1] - js->beg)*numSegments[jblk];
+	}
+	for (OFFDBLK *ks = begblk[blk]; ks->beg < blkend; ks = ks->bnext) {
+	    double iband = blkend - ks->beg;
+	    blkWork += iband*iband;
+	}
+
+	OFFDBLK *ks = begblk[blk];
+	parent[blk] = (ks->row < neq) ? rowblks[ks->row] : -1;
+
+	subtreeWork[blk] += blkWork + 1.0;
+	totalWork += blkWork + 1.0;
+	if (parent[blk] >= 0)
+	    subtreeWork[parent[blk]] += subtreeWork[blk];
+    }
+
+    // assign the blocks to tasks from the roots down, a parent always
+    // follows its children
+    double taskWork = totalWork/(4.0*NP);
+    std::vector<int> task(nblks);
+    std::vector<char> inSubtree(nblks);
+    int numTasks = 0;
+    for (int blk=nblks-1; blk>=0; blk--) {
+	int p = parent[blk];
+	if (p >= 0 && inSubtree[p]) {
+	    task[blk] = task[p];
+	    inSubtree[blk] = 1;
+	} else {
+	    task[blk] = numTasks++;
+	    inSubtree[blk] = (subtreeWork[blk] <= taskWork);
+	}
+    }
+
+    // the blocks of each task, in increasing order
+    taskStart.assign(numTasks+1, 0);
+    for (int blk=0; blk<nblks; blk++)
+	taskStart[task[blk]+1]++;
+    for (int t=0; t<numTasks; t++)
+	taskStart[t+1] += taskStart[t];
+    taskBlocks.resize(nblks);
+    std::vector<int> next(taskStart.begin(), taskStart.end()-1);
+    for (int blk=0; blk<nblks; blk++)
+	taskBlocks[next[task[blk]]++] = blk;
+
+    // the tasks each task waits for, from the row segments of its blocks
+    std::vector<int> depends;     // pairs (task waited for, task)
+    std::vector<int> lastTask(numTasks, -1);
+    for (int blk=0; blk<nblks; blk++) {
+	int t = task[blk];
+	int blkend = xblk[blk+1];
+	for (js = blockSegment[blk]; js->row < blkend; js = js->next) {
+	    int s = task[rowblks[js->beg]];
+	    if (s != t && lastTask[s] != t) {
+		lastTask[s] = t;
+		depends.push_back(s);
+		depends.push_back(t);
+	    }
+	}
+    }
+
+    numDepends.assign(numTasks, 0);
+    dependentStart.assign(numTasks+1, 0);
+    int numEdges = depends.size()/2;
+    for (int e=0; e<numEdges; e++) {
+	dependentStart[depends[2*e]+1]++;
+	numDepends[depends[2*e+1]]++;
+    }
+    for (int t=0; t<numTasks; t++)
+	dependentStart[t+1] += dependentStart[t];
+    taskDependents.resize(numEdges);
+    next.assign(dependentStart.begin(), dependentStart.end()-1);
+    for (int e=0; e<numEdges; e++)
+	taskDependents[next[depends[2*e]]++] = depends[2*e+1];
+
+    return 0;
+}
+
+
+int
+SymSparseLinSolver::setSize()
+{
+    // the tasks of the threaded factorization follow the block structure
+    return this->formSchedule();
+}
+
+
 int
 SymSparseLinSolver::setLinearSOE(SymSparseLinSOE &theLinearSOE)
 {
@@ -11,6 +11,11 @@
 // some "C" functions. The solver used here is generalized sparse
 // solver. The user can choose three different ordering schema.
 //
+// With numThreads > 1 the blocks of the factor are factored on a
+// ThreadPool: the block elimination tree is cut into subtrees of about
+// equal work, which are factored at the same time, and the blocks above
+// them are factored as soon as the blocks they depend on are done.
+//
 // What: "@(#) SymSparseLinSolver.h, revA"
 
 
@@ -18,19 +23,29 @@
 #define SymSparseLinSolver_h
 
 #include <LinearSOESolver.h>
+#include <vector>
 
+extern "C" {
+   #include <FeStructs.h>
+}
 
 class SymSparseLinSOE;
+class ThreadPool;
+class Matrix;
 
 class SymSparseLinSolver : public LinearSOESolver
 {
   public:
-    SymSparseLinSolver();     
+    SymSparseLinSolver(int numThreads = 1);
     ~SymSparseLinSolver();
 
     int solve(void);
     int setSize(void);
 
+    // solve A X = B for each column of B, which holds the solutions on
+    // return; A is factored first if it has changed
+    int solve(Matrix &B);
+
     int setLinearSOE(SymSparseLinSOE &theSOE); 
 	
     int sendSelf(int cTag, Channel &theChannel);
@@ -40,9 +55,26 @@ class SymSparseLinSolver : public LinearSOESolver
   protected:
 
   private:
+    int factor(void);
+    int formSchedule(void);
 
     SymSparseLinSOE *theSOE;
-    
+
+    int NP;
+    ThreadPool *thePool;
+
+    // the schedule of the threaded factorization, formed by setSize():
+    // the blocks of task t are taskBlocks[taskStart[t]] up to
+    // taskStart[t+1] in increasing order, task t must wait for numDepends[t]
+    // other tasks, and when it is done the tasks in taskDependents from
+    // dependentStart[t] to dependentStart[t+1] can be started
+    std::vector<OFFDBLK *> blockSegment;  // first row segment in each block
+    std::vector<int> taskStart, taskBlocks;
+    std::vector<int> dependentStart, taskDependents;
+    std::vector<int> numDepends;
+
+    std::vector<double> work;   // the permuted right hand sides
+
 };
 
 #endif
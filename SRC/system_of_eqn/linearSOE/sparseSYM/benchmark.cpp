@@ -0,0 +1,180 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// File: ~/system_of_eqn/linearSOE/sparseSYM/benchmark.cpp
+//
+// Description: scaling benchmark for the threaded factorization of
+// SymSparseLinSolver. The stiffness of a block of n x n x n eight node
+// bricks with three dofs a node is assembled into a SymSparseLinSOE and
+// factored on one thread and then on 2, 4, .. up to the number of threads
+// asked for, printing the time of the factorization, of a solve for
+// numRHS right hand sides at once, the residual and the largest difference
+// from the solution on one thread. Built with "make benchmark", run as
+// "sparse_benchmark n maxThreads ordering numRHS".
+
+#include <SymSparseLinSOE.h>
+#include <SymSparseLinSolver.h>
+#include <Graph.h>
+#include <GraphBuilder.h>
+#include <Vertex.h>
+#include <ArrayOfTaggedObjects.h>
+#include <ThreadPool.h>
+#include <Matrix.h>
+#include <Vector.h>
+#include <ID.h>
+#include <OPS_Globals.h>
+#include <StandardStream.h>
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <vector>
+
+StandardStream sserr;
+OPS_Stream *opserrPtr = &sserr;
+
+int main(int argc, char **argv)
+{
+  int n = 16;
+  int maxThreads = ThreadPool::getNumProcessors();
+  int ordering = 1;
+  int numRHS = 8;
+
+  if (argc > 1) n = atoi(argv[1]);
+  if (argc > 2) maxThreads = atoi(argv[2]);
+  if (argc > 3) ordering = atoi(argv[3]);
+  if (argc > 4) numRHS = atoi(argv[4]);
+
+  // the dofs of each brick, the nodes numbered along x, then y, then z
+  int numNode1 = n+1;
+  int numEqn = 3*numNode1*numNode1*numNode1;
+  std::vector<ID> elementIDs;
+  for (int k=0; k<n; k++)
+    for (int j=0; j<n; j++)
+      for (int i=0; i<n; i++) {
+	ID id(24);
+	int loc = 0;
+	for (int c=0; c<8; c++) {
+	  int node = (i + (c&1)) + numNode1*((j + ((c>>1)&1)) + numNode1*(k + (c>>2)));
+	  for (int d=0; d<3; d++)
+	    id(loc++) = 3*node + d;
+	}
+	elementIDs.push_back(id);
+      }
+  int numElement = elementIDs.size();
+
+  // one symmetric positive definite matrix for all the bricks
+  Matrix R(24,24), ke(24,24);
+  for (int i=0; i<24; i++)
+    for (int j=0; j<24; j++)
+      R(i,j) = sin(7.0*i + 3.0*j + 1.0);
+  ke.addMatrixTransposeProduct(0.0, R, R, 1.0);
+  for (int i=0; i<24; i++)
+    ke(i,i) += 1.0;
+
+  Vector fe(24);
+  for (int i=0; i<24; i++)
+    fe(i) = cos(1.0*i);
+
+  // the right hand sides, all a multiple of the assembled fe
+  Matrix B0(numEqn, numRHS);
+  std::vector<double> f(numEqn, 0.0);
+  for (int e=0; e<numElement; e++)
+    for (int i=0; i<24; i++)
+      f[elementIDs[e](i)] += fe(i);
+  for (int j=0; j<numRHS; j++)
+    for (int i=0; i<numEqn; i++)
+      B0(i,j) = (j+1)*f[i];
+
+  printf("%d equations, %d elements, ordering %d, %d right hand sides\n",
+	 numEqn, numElement, ordering, numRHS);
+  printf("%8s %14s %10s %14s %12s %12s\n", "threads", "factor(ms)", "speedup",
+	 "solve(ms)", "residual", "difference");
+
+  Vector x0(numEqn), y(numEqn);
+  double serialTime = 0.0;
+  for (int numThreads=1; numThreads<=maxThreads; numThreads*=2) {
+
+    Graph theGraph(*new ArrayOfTaggedObjects(numEqn));
+    for (int i=0; i<numEqn; i++)
+      theGraph.addVertex(new Vertex(i, i), false);
+    GraphBuilder theBuilder(numEqn);
+    for (int e=0; e<numElement; e++)
+      theBuilder.addClique(elementIDs[e]);
+    theBuilder.build(theGraph);
+
+    SymSparseLinSolver *theSolver = new SymSparseLinSolver(numThreads);
+    SymSparseLinSOE theSOE(*theSolver, ordering);
+    theSOE.setSize(theGraph);
+
+    theSOE.zeroA();
+    theSOE.zeroB();
+    for (int e=0; e<numElement; e++) {
+      theSOE.addA(ke, elementIDs[e]);
+      theSOE.addB(fe, elementIDs[e]);
+    }
+
+    // the first solve() factors the matrix
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    int result = theSolver->solve();
+    std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+    if (result < 0) {
+      printf("factorization failed with %d threads\n", numThreads);
+      return -1;
+    }
+    const Vector &x = theSOE.getX();
+
+    Matrix X(B0);
+    std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+    theSolver->solve(X);
+    std::chrono::steady_clock::time_point t3 = std::chrono::steady_clock::now();
+
+    // residual of K x = f, and of the last column of X
+    y.Zero();
+    for (int e=0; e<numElement; e++) {
+      const ID &id = elementIDs[e];
+      for (int i=0; i<24; i++)
+	for (int j=0; j<24; j++)
+	  y(id(i)) += ke(i,j)*x(id(j));
+    }
+    double residual = 0.0;
+    for (int i=0; i<numEqn; i++)
+      residual = fmax(residual, fabs(y(i) - f[i]));
+    for (int i=0; i<numEqn; i++)
+      residual = fmax(residual, fabs(X(i,numRHS-1) - numRHS*x(i)));
+
+    if (numThreads == 1)
+      x0 = x;
+    double difference = 0.0;
+    for (int i=0; i<numEqn; i++)
+      difference = fmax(difference, fabs(x(i) - x0(i)));
+
+    double factorTime = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    double solveTime = std::chrono::duration<double, std::milli>(t3 - t2).count();
+    if (numThreads == 1)
+      serialTime = factorTime;
+
+    printf("%8d %14.3f %10.2f %14.3f %12.3e %12.3e\n", numThreads, factorTime,
+	   serialTime/factorTime, solveTime, residual, difference);
+  }
+
+  return 0;
+}
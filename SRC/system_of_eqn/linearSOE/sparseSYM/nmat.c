@@ -55,7 +55,7 @@
         temp   - temporary vector to accumulate row modifications.
 
    program subroutines 
-        pfefct, pflslv 
+        pfbfct 
  
  ***************************************************************/
 int pfsfct(int neqns, double *diag, double **penv, int nblks, 
@@ -63,104 +63,146 @@ int pfsfct(int neqns, double *diag, double **penv, int nblks,
 /*************************************************************** 
  ***************************************************************/
 {  
-   int blk, nextblk, jbeg, iflag ;
-   int iband, blkbeg, blkend, blksze ;
-   int jrow, krow ;
-   int jblk, jb, kb, pos ;
-   OFFDBLK *marker, *ks, *js, *ls ;
-   double *work;
-   int ii;
+   int blk, iflag ;
+   OFFDBLK *js ;
    
    if  ( neqns <= 0 )  return(0) ;
-   marker = begblk[0];
 
-   marker = first;
-   js = marker;
+   js = first;
 /* ----------------------------------------------------------
    for each block blk, do ...
    ----------------------------------------------------------*/
    for (blk = 0; blk < nblks; blk++)
    {  
-      nextblk = blk + 1 ;
-      blkbeg = xblk[blk] ;
-      blkend = xblk[nextblk]  ;
-      blksze = blkend - blkbeg ;
-/*    --------------------------------------------------------
-      update rows from row segments
-      The function Dotrows();
-      -------------------------------------------------------*/
-      while( js->row < blkend)
-      {
-	 jrow = js->row;
-	 jbeg = js->beg;
+      iflag = pfbfct(blk, diag, penv, xblk, begblk, &js, rowblks) ;
+      if (iflag == 1) return(1) ;
+      if (iflag) return(blk + 1) ;
+   }
+
+   return(0) ;
+}
+
+/***************************************************************
+ ******    pfbfct ..... factor one block of the envelope  ******
+ ***************************************************************
+ 
+   purpose - this routine performs the work of pfsfct for the
+        single block blk: the rows of the block are updated
+        from the row segments in the columns of the blocks
+        before it, the diagonal envelope block is factored and
+        the row segments under the block are backsolved. only
+        the values in the rows and under the columns of block
+        blk are written, the blocks the row segments of blk
+        refer to must have been factored, so that blocks in
+        independent subtrees of the block elimination tree may
+        be factored at the same time.
+ 
+   input parameters -
+        blk   - the block to factor.
+        pjs   - the first row segment with a row in block blk,
+                on return the first with a row after the block.
+   return -
+        0 on success, 1 if a zero diagonal occurs in the
+        update from the row segments and 2 if it occurs in
+        the envelope factorization.
+
+   program subroutines 
+        pfefct, pflslv, dot_real 
+
+ ***************************************************************/
+int pfbfct(int blk, double *diag, double **penv, int *xblk,
+	   OFFDBLK **begblk, OFFDBLK **pjs, int *rowblks)
+{  
+   int jbeg ;
+   int iband, blkbeg, blkend, blksze ;
+   int jrow, krow ;
+   int jblk, jb, kb, pos ;
+   OFFDBLK *ks, *js, *ls ;
+   double *nz, w, s ;
+   int ii;
+
+   js = *pjs ;
+   blkbeg = xblk[blk] ;
+   blkend = xblk[blk + 1]  ;
+   blksze = blkend - blkbeg ;
+/* --------------------------------------------------------
+   update rows from row segments
+   The function Dotrows();
+   -------------------------------------------------------*/
+   while( js->row < blkend)
+   {
+      jrow = js->row;
+      jbeg = js->beg;
  
-	 jblk = rowblks[jbeg];
-         ls = begblk[blk] ;
-         ks = js->bnext ;
+      jblk = rowblks[jbeg];
+      ls = begblk[blk] ;
+      ks = js->bnext ;
 /*    -------------------------------------------------------
-      update the diagonals from the off diagonal row segments
+      update the diagonals from the off diagonal row segments,
+      scaling the segment by the diagonal as it is summed
       ------------------------------------------------------*/
 	 
-	 iband = xblk[jblk+1] - jbeg;
-	 work = (double*) calloc(iband, sizeof(double)); 
-	 for (ii = 0; ii < iband; ii++) {
-	     work[ii] = js->nz[ii];
-	     js->nz[ii] /= diag[ii + jbeg]; 	    
-	 }
-	 diag[jrow] -= dot_real(js->nz, work, iband);
-	 if (diag[jrow] == 0) {
-	     fprintf(stderr,"!!!pfsfct(): The diagonal entry %d is zero !!!\n", jrow);
-	     return (1);
-	 }
-	 free (work);
+      iband = xblk[jblk+1] - jbeg;
+      nz = js->nz ;
+      s = 0.0 ;
+      for (ii = 0; ii < iband; ii++) {
+	  w = nz[ii];
+	  nz[ii] /= diag[ii + jbeg]; 	    
+	  s += nz[ii] * w ;
+      }
+      diag[jrow] -= s;
+      if (diag[jrow] == 0) {
+	  fprintf(stderr,"!!!pfsfct(): The diagonal entry %d is zero !!!\n", jrow);
+	  *pjs = js ;
+	  return (1);
+      }
 	 
-	 if (ks->row < blkend )
-	 {  /* part of envelop block*/
-	    for ( ; ks->row < blkend ; ks = ks->bnext)
-	    {
-	       krow = ks->row ;
-	       pos = MAX(jbeg, ks->beg) ;
-	       iband = xblk[jblk+1] - pos;
-	       jb = pos - jbeg ;
-	       kb = pos - ks->beg ;
-	       pos = jrow - krow + (penv[krow + 1] - penv[krow]) ;
-	       *(penv[krow] + pos) -= 
-		   dot_real(js->nz+jb, ks->nz+kb, iband);
-            }
-         }
-	 for ( ; ks->beg < blkend ; ks = ks->bnext)
+      if (ks->row < blkend )
+      {  /* part of envelop block*/
+	 for ( ; ks->row < blkend ; ks = ks->bnext)
 	 {
 	    krow = ks->row ;
-	    pos = MAX(jbeg, ks->beg);
+	    pos = MAX(jbeg, ks->beg) ;
 	    iband = xblk[jblk+1] - pos;
 	    jb = pos - jbeg ;
 	    kb = pos - ks->beg ;
-	    /* part of another row segment */
-	    while ( ls->row != krow) ls = ls->bnext ;
-	    pos = jrow - ls->beg ;
-	    ls->nz[pos] -= 
-	        dot_real(js->nz+jb, ks->nz+kb, iband) ;
-         }
-
-	 js = js->next ;
+	    pos = jrow - krow + (penv[krow + 1] - penv[krow]) ;
+	    *(penv[krow] + pos) -= 
+		dot_real(js->nz+jb, ks->nz+kb, iband);
+	 }
       }
-/*    -------------------------------------------------------
-      perform envelope fct on diag block blk.
-      -------------------------------------------------------
+      for ( ; ks->beg < blkend ; ks = ks->bnext)
+      {
+	 krow = ks->row ;
+	 pos = MAX(jbeg, ks->beg);
+	 iband = xblk[jblk+1] - pos;
+	 jb = pos - jbeg ;
+	 kb = pos - ks->beg ;
+	 /* part of another row segment */
+	 while ( ls->row != krow) ls = ls->bnext ;
+	 pos = jrow - ls->beg ;
+	 ls->nz[pos] -= 
+	     dot_real(js->nz+jb, ks->nz+kb, iband) ;
+      }
+
+      js = js->next ;
+   }
+   *pjs = js ;
+/* -------------------------------------------------------
+   perform envelope fct on diag block blk.
+   -------------------------------------------------------
 */
-      iflag = pfefct(blksze, penv+blkbeg, diag+ blkbeg) ;
-      if (iflag) return(nextblk);
+   if (pfefct(blksze, penv+blkbeg, diag+ blkbeg)) return(2) ;
 
-/*    -------------------------------------------------------
-      for each row "node" in this block, do
-         update row segments under block blk with a backsolve
-      -------------------------------------------------------
+/* -------------------------------------------------------
+   for each row "node" in this block, do
+      update row segments under block blk with a backsolve
+   -------------------------------------------------------
 */
-      for (ks = begblk[blk]; ks->beg < blkend ; ks = ks->bnext )
-      {  jbeg = ks->beg ;
-         iband = blkend - jbeg ;
-         pflslv(iband, (penv + jbeg), (diag + jbeg), ks->nz);
-      }
+   for (ks = begblk[blk]; ks->beg < blkend ; ks = ks->bnext )
+   {  jbeg = ks->beg ;
+      iband = blkend - jbeg ;
+      pflslv(iband, (penv + jbeg), (diag + jbeg), ks->nz);
    }
 
    return(0) ;
@@ -193,7 +235,7 @@ int pfefct(int neqns, double **penv, double *diag)
 {  
    double *ptenv ; 
    int iband, i, jj, ifirst ;
-   double *work;
+   double w, sum ;
    
 /*    -------------------------------------------------
       for each row i, ...
@@ -203,7 +245,6 @@ int pfefct(int neqns, double **penv, double *diag)
    {  
       ptenv = penv[i] ;
       iband = penv[i+1] - ptenv ;
-      work = (double *)calloc(iband, sizeof(double));
 
       if ( iband > 0 )
       {  
@@ -213,15 +254,15 @@ int pfefct(int neqns, double **penv, double *diag)
          --------------------------------------- */
 
          pflslv( iband, penv+ifirst, diag+ifirst, ptenv );
+	 sum = 0.0 ;
 	 for (jj = 0; jj < iband; jj++) {
-	     work[jj] = ptenv[jj];
+	     w = ptenv[jj];
 	     ptenv[jj] = ptenv[jj] / diag[i+jj-iband]; 
+	     sum += ptenv[jj] * w ;
 	 }
 	 
-         diag[i] -= dot_real(ptenv, work, iband ) ;
+         diag[i] -= sum ;
       }
-      
-      free (work);
 
       if ( fabs(diag[i]) < 1.0e-60)  {
 	  fprintf(stderr,"!!! pfefct(): diagonal %d is zero !!!\n", i); 
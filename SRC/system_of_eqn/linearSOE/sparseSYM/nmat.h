@@ -19,6 +19,9 @@
 int pfsfct(int neqns, double *diag, double **penv, int nblks, 
 	   int *xblk, OFFDBLK **begblk, OFFDBLK *first, int *rowblks);
 
+int pfbfct(int blk, double *diag, double **penv, int *xblk,
+	   OFFDBLK **begblk, OFFDBLK **pjs, int *rowblks);
+
 int pfefct(int neqns, double **penv, double *diag);
 
 void pfsslv(int neqns, double *diag, double **penv, int nblks, 
@@ -37,6 +37,7 @@
 #include <UmfpackGenLinSolver.h>
 #include <Matrix.h>
 #include <Graph.h>
+#include <SparsePattern.h>
 #include <Vertex.h>
 #include <VertexIter.h>
 #include <math.h>
@@ -80,58 +81,26 @@ UmfpackGenLinSOE::setSize(Graph &theGraph)
 	return -1;
     }
 
-    // fist itearte through the vertices of the graph to get nnz
-    Vertex *theVertex;
-    int nnz = 0;
-    VertexIter &theVertices = theGraph.getVertices();
-    while ((theVertex = theVertices()) != 0) {
-	const ID &theAdjacency = theVertex->getAdjacency();
-	nnz += theAdjacency.Size() +1; // the +1 is for the diag entry
+    // form the pattern of A from the graph
+    SparsePattern thePattern;
+    if (thePattern.form(theGraph) < 0) {
+	opserr << "WARNING:UmfpackGenLinSOE::setSize :";
+	opserr << " failed to form the pattern of A\n";
+	return -1;
     }
+    int nnz = thePattern.getNNZ();
 
     // resize A, B, X
-    Ap.reserve(size+1);
-    Ai.reserve(nnz);
-    Ax.resize(nnz,0.0);
+    const int *start = thePattern.getStart();
+    const int *index = thePattern.getIndex();
+    Ap.assign(start, start+size+1);
+    Ai.assign(index, index+nnz);
+    Ax.assign(nnz,0.0);
     B.resize(size);
     B.Zero();
     X.resize(size);
     X.Zero();
 
-    // fill in Ai and Ap
-    Ap.push_back(0);
-    for (int a=0; a<size; a++) {
-
-	theVertex = theGraph.getVertexPtr(a);
-	if (theVertex == 0) {
-	    opserr << "WARNING:UmfpackGenLinSOE::setSize :";
-	    opserr << " vertex " << a << " not in graph! - size set to 0\n";
-	    size = 0;
-	    return -1;
-	}
-
-	const ID &theAdjacency = theVertex->getAdjacency();
-	int idSize = theAdjacency.Size();
-	ID col(0,idSize+1);
-
-	// diagonal
-	col.insert(theVertex->getTag());
-
-	// now we have to place the entries in the ID into order in Ai
-	for (int i=0; i<idSize; i++) {
-	    int row = theAdjacency(i);
-	    col.insert(row);
-	}
-
-	// copy to Ai
-	for (int i=0; i<col.Size(); i++) {
-	    Ai.push_back(col(i));
-	}
-
-	// set Ap
-	Ap.push_back(Ap[a]+col.Size());
-    }
-
     // invoke setSize() on the Solver
     LinearSOESolver *the_Solver = this->getSolver();
     int solverOK = the_Solver->setSize();
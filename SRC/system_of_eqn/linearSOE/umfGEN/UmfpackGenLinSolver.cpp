@@ -34,6 +34,7 @@
 
 #include <UmfpackGenLinSOE.h>
 #include <UmfpackGenLinSolver.h>
+#include <SparsePattern.h>
 #include <math.h>
 #include <Channel.h>
 #include <FEM_ObjectBroker.h>
@@ -46,7 +47,8 @@ void* OPS_UmfpackGenLinSolver()
 
 UmfpackGenLinSolver::
 UmfpackGenLinSolver()
-    :LinearSOESolver(SOLVER_TAGS_UmfpackGenLinSolver), Symbolic(0), theSOE(0)
+    :LinearSOESolver(SOLVER_TAGS_UmfpackGenLinSolver), Symbolic(0),
+     patternSize(0), patternNNZ(0), patternFingerprint(0), theSOE(0)
 {
 }
 
@@ -71,10 +73,10 @@ UmfpackGenLinSolver::solve(void)
     double* X = &(theSOE->X(0));
     double* B = &(theSOE->B(0));
 
-    // check if symbolic is done
+    // do the symbolic analysis if the pattern is new
     if (Symbolic == 0) {
-	opserr<<"WARNING: setSize has not been called -- Umfpackgenlinsolver::solve\n";
-	return -1;
+	if (this->symbolic() < 0)
+	    return -1;
     }
     
     // numerical analysis
@@ -119,17 +121,40 @@ UmfpackGenLinSolver::setSize()
     
     int* Ap = &(theSOE->Ap[0]);
     int* Ai = &(theSOE->Ai[0]);
-    double* Ax = &(theSOE->Ax[0]);
 
-    // symbolic analysis
+    // keep the symbolic analysis if the pattern is the one it was done for
+    unsigned long long fingerprint = SparsePattern::getFingerprint(n,Ap,Ai);
+    if (Symbolic != 0 && n == patternSize && nnz == patternNNZ
+	&& fingerprint == patternFingerprint)
+	return 0;
+
+    // otherwise it is done on the next solve, with the values of A
     if (Symbolic != 0) {
 	umfpack_di_free_symbolic(&Symbolic);
+	Symbolic = 0;
     }
+    patternSize = n;
+    patternNNZ = nnz;
+    patternFingerprint = fingerprint;
+
+    return 0;
+}
+
+int
+UmfpackGenLinSolver::symbolic(void)
+{
+    int n = theSOE->X.Size();
+
+    int* Ap = &(theSOE->Ap[0]);
+    int* Ai = &(theSOE->Ai[0]);
+    double* Ax = &(theSOE->Ax[0]);
+
+    // symbolic analysis
     int status = umfpack_di_symbolic(n,n,Ap,Ai,Ax,&Symbolic,Control,Info);
 
     // check error
     if (status!=UMFPACK_OK) {
-	opserr<<"WARNING: symbolic analysis returns "<<status<<" -- Umfpackgenlinsolver::setsize\n";
+	opserr<<"WARNING: symbolic analysis returns "<<status<<" -- Umfpackgenlinsolver::symbolic\n";
 	Symbolic = 0;
 	return -1;
     }
@@ -28,7 +28,10 @@
 //
 // Description: This file contains the class definition for 
 // UmfpackGenLinSolver. It solves the UmfpackGenLinSOEobject by calling
-// UMFPACK5.7.1 routines.
+// UMFPACK5.7.1 routines. The symbolic analysis is done on the first
+// solve() after setSize() and kept for as long as setSize() is given the
+// same pattern, so a change of the domain that leaves the pattern of A
+// as it was costs only the numeric factorizations.
 //
 // What: "@(#) UmfpackGenLinSolver.h, revA"
 
@@ -58,7 +61,11 @@ class UmfpackGenLinSolver : public LinearSOESolver
   protected:
 
   private:
+    int symbolic(void);
+
     void *Symbolic;
+    int patternSize, patternNNZ;               // pattern of Symbolic
+    unsigned long long patternFingerprint;
     double Control[UMFPACK_CONTROL], Info[UMFPACK_INFO];
     UmfpackGenLinSOE *theSOE;
 };
@@ -0,0 +1,230 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// File: ~/tagged/storage/HashOfTaggedObjects.cpp
+//
+// Description: This file contains the implementation of the
+// HashOfTaggedObjects class.
+
+#include <TaggedObject.h>
+#include <HashOfTaggedObjects.h>
+
+#include <OPS_Globals.h>
+
+// the smallest table, the table is kept at least twice the number of
+// components so that the probe sequences stay short
+static const int minTableSize = 8;
+
+HashOfTaggedObjects::HashOfTaggedObjects(int size)
+  :mask(0), shift(32), myIter(*this)
+{
+  this->resizeTable(2*size);
+  if (size > 0)
+    theComponents.reserve(size);
+}
+
+HashOfTaggedObjects::~HashOfTaggedObjects()
+{
+  this->clearAll();
+}
+
+int
+HashOfTaggedObjects::setSize(int newSize)
+{
+  if (newSize < 0) {
+    opserr << "HashOfTaggedObjects::setSize - invalid size " << newSize << endln;
+    return -1;
+  }
+
+  theComponents.reserve(newSize);
+  if (2*newSize > (int)theTable.size())
+    return this->resizeTable(2*newSize);
+
+  return 0;
+}
+
+bool
+HashOfTaggedObjects::addComponent(TaggedObject *newComponent)
+{
+  // grow the table before it gets more than half full
+  if (2*((int)theComponents.size()+1) > (int)theTable.size())
+    if (this->resizeTable(2*theTable.size()) < 0)
+      return false;
+
+  int tag = newComponent->getTag();
+  int slot = this->findSlot(tag);
+  if (theTable[slot].position >= 0) {
+    opserr << "HashOfTaggedObjects::addComponent - not adding as one with similar tag exists, tag: " <<
+      tag << endln;
+    return false;
+  }
+
+  theTable[slot].tag = tag;
+  theTable[slot].position = theComponents.size();
+  theComponents.push_back(newComponent);
+
+  return true;  // o.k.
+}
+
+TaggedObject *
+HashOfTaggedObjects::removeComponent(int tag)
+{
+  // return 0 if component does not exist, otherwise remove it
+  int slot = this->findSlot(tag);
+  int position = theTable[slot].position;
+  if (position < 0)
+    return 0;
+
+  TaggedObject *removed = theComponents[position];
+
+  // move the last component into the hole left in the array
+  int last = theComponents.size() - 1;
+  if (position != last) {
+    TaggedObject *moved = theComponents[last];
+    theComponents[position] = moved;
+    theTable[this->findSlot(moved->getTag())].position = position;
+  }
+  theComponents.pop_back();
+
+  // empty the slot, shifting back the entries further along the probe
+  // sequence that can no longer be reached past the empty slot
+  int hole = slot;
+  int next = slot;
+  while (true) {
+    next = (next + 1) & mask;
+    if (theTable[next].position < 0)
+      break;
+    int home = ((unsigned int)theTable[next].tag * 2654435769u) >> shift;
+    bool reachable = (hole < next) ? (home > hole && home <= next)
+                                   : (home > hole || home <= next);
+    if (reachable == false) {
+      theTable[hole] = theTable[next];
+      hole = next;
+    }
+  }
+  theTable[hole].position = -1;
+
+  return removed;
+}
+
+int
+HashOfTaggedObjects::getNumComponents(void) const
+{
+  return theComponents.size();
+}
+
+TaggedObject *
+HashOfTaggedObjects::getComponentPtr(int tag)
+{
+  int position = theTable[this->findSlot(tag)].position;
+  if (position < 0)
+    return 0;
+
+  return theComponents[position];
+}
+
+TaggedObjectIter &
+HashOfTaggedObjects::getComponents()
+{
+  myIter.reset();
+  return myIter;
+}
+
+HashOfTaggedObjectsIter
+HashOfTaggedObjects::getIter()
+{
+  return HashOfTaggedObjectsIter(*this);
+}
+
+TaggedObjectStorage *
+HashOfTaggedObjects::getEmptyCopy(void)
+{
+  HashOfTaggedObjects *theCopy = new HashOfTaggedObjects(theComponents.capacity());
+
+  if (theCopy == 0) {
+    opserr << "HashOfTaggedObjects::getEmptyCopy - out of memory\n";
+  }
+
+  return theCopy;
+}
+
+void
+HashOfTaggedObjects::clearAll(bool invokeDestructor)
+{
+  // invoke the destructor on all the tagged objects stored
+  if (invokeDestructor == true) {
+    for (int i=0; i<(int)theComponents.size(); i++)
+      delete theComponents[i];
+  }
+
+  // now clear the array and the table of all entries
+  theComponents.clear();
+  for (int i=0; i<(int)theTable.size(); i++)
+    theTable[i].position = -1;
+}
+
+void
+HashOfTaggedObjects::Print(OPS_Stream &s, int flag)
+{
+  s << "\nnumComponents: " << this->getNumComponents() << endln;
+  for (int i=0; i<(int)theComponents.size(); i++)
+    theComponents[i]->Print(s, flag);
+}
+
+// returns the slot holding tag or, if there is none, the empty slot
+// ending its probe sequence; the hash is Fibonacci hashing, which
+// spreads tags that differ only in their high or low digits
+int
+HashOfTaggedObjects::findSlot(int tag) const
+{
+  unsigned int slot = ((unsigned int)tag * 2654435769u) >> shift;
+  while (theTable[slot].position >= 0 && theTable[slot].tag != tag)
+    slot = (slot + 1) & mask;
+
+  return slot;
+}
+
+int
+HashOfTaggedObjects::resizeTable(int numSlots)
+{
+  int size = minTableSize;
+  int bits = 3;
+  while (size < numSlots) {
+    size *= 2;
+    bits++;
+  }
+  if (size == (int)theTable.size())
+    return 0;
+
+  Slot empty = {0, -1};
+  theTable.assign(size, empty);
+  mask = size - 1;
+  shift = 32 - bits;
+
+  // put the components back into the new table
+  for (int i=0; i<(int)theComponents.size(); i++) {
+    int tag = theComponents[i]->getTag();
+    int slot = this->findSlot(tag);
+    theTable[slot].tag = tag;
+    theTable[slot].position = i;
+  }
+
+  return 0;
+}
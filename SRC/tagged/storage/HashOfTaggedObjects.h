@@ -0,0 +1,84 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// File: ~/tagged/storage/HashOfTaggedObjects.h
+//
+// Description: This file contains the class definition for
+// HashOfTaggedObjects. HashOfTaggedObjects is a storage class for objects
+// of type TaggedObject meant for models whose tags do not fit an array
+// index, e.g. the 10010203 style tags of meshes exported from CAD
+// programs, where ArrayOfTaggedObjects must search for a component. The
+// components are held in a dense array in the order they were added and an
+// open addressing hash table with linear probing maps a tag to the
+// position of its component in that array, so that adding, removing and
+// finding a component take constant time whatever the tags and iterating
+// over the components walks a contiguous array. When a component is
+// removed the last component takes its place in the array.
+
+#ifndef HashOfTaggedObjects_h
+#define HashOfTaggedObjects_h
+
+#include <TaggedObjectStorage.h>
+#include <HashOfTaggedObjectsIter.h>
+
+#include <vector>
+
+class HashOfTaggedObjects : public TaggedObjectStorage
+{
+  public:
+    HashOfTaggedObjects(int size = 0);
+    ~HashOfTaggedObjects();
+
+    // public methods to populate a domain
+    int  setSize(int newSize);
+    bool addComponent(TaggedObject *newComponent);
+    TaggedObject *removeComponent(int tag);
+    int  getNumComponents(void) const;
+
+    TaggedObject     *getComponentPtr(int tag);
+    TaggedObjectIter &getComponents();
+
+    HashOfTaggedObjectsIter  getIter();
+
+    virtual TaggedObjectStorage *getEmptyCopy(void);
+    virtual void clearAll(bool invokeDestructor = true);
+
+    void Print(OPS_Stream &s, int flag =0);
+    friend class HashOfTaggedObjectsIter;
+
+  protected:
+
+  private:
+    struct Slot {
+      int tag;
+      int position;             // position in theComponents, -1 if empty
+    };
+
+    int findSlot(int tag) const;
+    int resizeTable(int numSlots);
+
+    std::vector<TaggedObject *> theComponents;  // the components in order
+    std::vector<Slot> theTable;                 // tag -> position
+    unsigned int mask;                          // theTable.size() - 1
+    int shift;                                  // 32 - log2(theTable.size())
+    HashOfTaggedObjectsIter  myIter; // an iter for accessing the objects
+};
+
+#endif
@@ -0,0 +1,147 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// File: ~/tagged/storage/benchmark.cpp
+//
+// Description: benchmark of the TaggedObjectStorage classes. n objects are
+// added to an ArrayOfTaggedObjects, a MapOfTaggedObjects and a
+// HashOfTaggedObjects, once with the tags 1..n and once with sparse tags
+// of the form 10010203 as in meshes exported from CAD programs, and the
+// times to add them, to look each up in random order, to iterate over
+// them and to remove them are printed. Built with "make benchmark", run
+// as "storage_benchmark n".
+
+#include <TaggedObject.h>
+#include <ArrayOfTaggedObjects.h>
+#include <MapOfTaggedObjects.h>
+#include <HashOfTaggedObjects.h>
+#include <TaggedObjectIter.h>
+#include <OPS_Globals.h>
+#include <StandardStream.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <vector>
+#include <random>
+#include <algorithm>
+
+StandardStream sserr;
+OPS_Stream *opserrPtr = &sserr;
+
+class BenchmarkObject : public TaggedObject
+{
+  public:
+    BenchmarkObject(int tag) :TaggedObject(tag), value(tag) {}
+    void Print(OPS_Stream &s, int flag =0) {s << this->getTag() << endln;}
+    int value;
+};
+
+static double
+elapsed(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void
+run(const char *name, TaggedObjectStorage &theStorage,
+    const std::vector<BenchmarkObject *> &theObjects,
+    const std::vector<int> &lookupOrder)
+{
+  int n = theObjects.size();
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (int i=0; i<n; i++)
+    theStorage.addComponent(theObjects[i]);
+  double addTime = elapsed(start);
+
+  long long sum = 0;
+  start = std::chrono::steady_clock::now();
+  for (int i=0; i<n; i++) {
+    TaggedObject *theObject = theStorage.getComponentPtr(theObjects[lookupOrder[i]]->getTag());
+    sum += ((BenchmarkObject *)theObject)->value;
+  }
+  double findTime = elapsed(start);
+
+  int numPasses = 10;
+  start = std::chrono::steady_clock::now();
+  for (int pass=0; pass<numPasses; pass++) {
+    TaggedObjectIter &theIter = theStorage.getComponents();
+    TaggedObject *theObject;
+    while ((theObject = theIter()) != 0)
+      sum -= ((BenchmarkObject *)theObject)->value;
+  }
+  double iterTime = elapsed(start)/numPasses;
+
+  start = std::chrono::steady_clock::now();
+  for (int i=0; i<n; i++)
+    theStorage.removeComponent(theObjects[lookupOrder[i]]->getTag());
+  double removeTime = elapsed(start);
+
+  // each object was found once and visited numPasses times
+  long long expected = 0;
+  for (int i=0; i<n; i++)
+    expected += theObjects[i]->value;
+  bool ok = (sum == (1-numPasses)*expected && theStorage.getNumComponents() == 0);
+
+  printf("%-8s %12.6f %12.6f %12.6f %12.6f %s\n", name, addTime, findTime,
+	 iterTime, removeTime, ok ? "ok" : "FAILED");
+}
+
+int main(int argc, char **argv)
+{
+  int n = 20000;
+  if (argc > 1)
+    n = atoi(argv[1]);
+
+  std::vector<int> lookupOrder(n);
+  for (int i=0; i<n; i++)
+    lookupOrder[i] = i;
+  std::mt19937 generator(12345);
+  std::shuffle(lookupOrder.begin(), lookupOrder.end(), generator);
+
+  for (int sparse=0; sparse<2; sparse++) {
+
+    // the tags: 1..n or floor, grid line and point numbers 10010203
+    std::vector<BenchmarkObject *> theObjects(n);
+    for (int i=0; i<n; i++) {
+      int tag = i+1;
+      if (sparse == 1)
+	tag = 10000000 + (i/1000)*10000 + ((i/10)%100)*100 + i%10 + 1;
+      theObjects[i] = new BenchmarkObject(tag);
+    }
+
+    printf("\n%d objects, %s tags\n", n, (sparse == 1) ? "sparse" : "dense");
+    printf("%-8s %12s %12s %12s %12s\n", "storage", "add", "find", "iterate",
+	   "remove");
+
+    ArrayOfTaggedObjects theArray(1024);
+    run("array", theArray, theObjects, lookupOrder);
+    MapOfTaggedObjects theMap;
+    run("map", theMap, theObjects, lookupOrder);
+    HashOfTaggedObjects theHash(1024);
+    run("hash", theHash, theObjects, lookupOrder);
+
+    for (int i=0; i<n; i++)
+      delete theObjects[i];
+  }
+
+  return 0;
+}
@@ -1450,6 +1450,7 @@ wipeModel(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
     delete theDatabase;
 
   theDomain.clearAll();
+  Recorder::clearNodalReactions();
   OPS_clearAllUniaxialMaterial();
   OPS_clearAllNDMaterial();
   OPS_clearAllSectionForceDeformation();
@@ -1613,6 +1614,7 @@ int
 resetModel(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
 {
 	theDomain.revertToStart();
+	Recorder::clearNodalReactions();
 
 	if (theTransientIntegrator != 0) {
 		theTransientIntegrator->revertToStart();
@@ -7772,6 +7774,7 @@ calculateNodalReactions(ClientData clientData, Tcl_Interp *interp, int argc, TCL
   }
 
   theDomain.calculateNodalReactions(incInertia);
+  Recorder::clearNodalReactions();
 
   return TCL_OK;
 }
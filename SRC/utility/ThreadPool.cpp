@@ -0,0 +1,137 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// File: ~/utility/ThreadPool.cpp
+//
+// Description: This file contains the implementation of ThreadPool.
+
+#include <ThreadPool.h>
+
+ThreadPool::ThreadPool(int nThreads)
+  :numThreads(nThreads), currentTask(0), generation(0), numBusy(0),
+   shutdown(false)
+{
+  if (numThreads < 1)
+    numThreads = 1;
+
+  // thread 0 is the caller of run(), only the others are spawned
+  for (int i=1; i<numThreads; i++)
+    workers.emplace_back(&ThreadPool::work, this, i);
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(theMutex);
+    shutdown = true;
+  }
+  startCondition.notify_all();
+
+  for (std::thread &worker : workers)
+    worker.join();
+}
+
+int
+ThreadPool::getNumThreads(void) const
+{
+  return numThreads;
+}
+
+int
+ThreadPool::getNumProcessors(void)
+{
+  unsigned int n = std::thread::hardware_concurrency();
+  return n > 0 ? int(n) : 1;
+}
+
+void
+ThreadPool::run(const std::function<void(int)> &task)
+{
+  if (numThreads == 1) {
+    task(0);
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(theMutex);
+    currentTask = &task;
+    numBusy = numThreads - 1;
+    generation++;
+  }
+  startCondition.notify_all();
+
+  task(0);
+
+  std::unique_lock<std::mutex> lock(theMutex);
+  doneCondition.wait(lock, [this] { return numBusy == 0; });
+  currentTask = 0;
+}
+
+void
+ThreadPool::parallelFor(int n, const std::function<void(int, int, int)> &task)
+{
+  if (n <= 0)
+    return;
+
+  int numUsed = numThreads < n ? numThreads : n;
+  if (numUsed == 1) {
+    task(0, n, 0);
+    return;
+  }
+
+  int chunk = n / numUsed;
+  int extra = n % numUsed;
+
+  this->run([&](int threadID) {
+    if (threadID >= numUsed)
+      return;
+    int begin = threadID*chunk + (threadID < extra ? threadID : extra);
+    int end = begin + chunk + (threadID < extra ? 1 : 0);
+    task(begin, end, threadID);
+  });
+}
+
+void
+ThreadPool::work(int threadID)
+{
+  unsigned long lastGeneration = 0;
+
+  while (true) {
+    const std::function<void(int)> *task;
+    {
+      std::unique_lock<std::mutex> lock(theMutex);
+      startCondition.wait(lock, [&] {
+	return shutdown || generation != lastGeneration;
+      });
+      if (shutdown)
+	return;
+      lastGeneration = generation;
+      task = currentTask;
+    }
+
+    (*task)(threadID);
+
+    {
+      std::lock_guard<std::mutex> lock(theMutex);
+      numBusy--;
+    }
+    doneCondition.notify_one();
+  }
+}
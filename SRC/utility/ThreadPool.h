@@ -0,0 +1,74 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// File: ~/utility/ThreadPool.h
+//
+// Description: This file contains the class definition for ThreadPool.
+// ThreadPool keeps a fixed set of worker threads alive between calls so
+// that the analysis classes can split loops over elements, equations or
+// blocks without paying for thread creation on every iteration. The
+// calling thread always takes part in the work as thread 0, so a pool
+// with one thread runs everything inline.
+
+#ifndef ThreadPool_h
+#define ThreadPool_h
+
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+
+class ThreadPool
+{
+  public:
+    ThreadPool(int numThreads);
+    ~ThreadPool();
+
+    int getNumThreads(void) const;
+
+    // invoke task(threadID) once on every thread and wait for all to return
+    void run(const std::function<void(int)> &task);
+
+    // split [0, n) into contiguous ranges, invoking task(begin, end, threadID)
+    // on each; the ranges are fixed by n and the number of threads so the
+    // same index always lands on the same thread
+    void parallelFor(int n, const std::function<void(int, int, int)> &task);
+
+    // number of hardware threads, or 1 if it cannot be determined
+    static int getNumProcessors(void);
+
+  private:
+    void work(int threadID);
+
+    int numThreads;
+    std::vector<std::thread> workers;
+
+    std::mutex theMutex;
+    std::condition_variable startCondition;
+    std::condition_variable doneCondition;
+
+    const std::function<void(int)> *currentTask;
+    unsigned long generation;   // incremented each time run() posts a task
+    int numBusy;                // workers still running the current task
+    bool shutdown;
+};
+
+#endif